@@ -21,6 +21,7 @@
 
 #include <cstddef>
 
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/lint_rule.h"
 
@@ -33,6 +34,17 @@ class LineLintRule : public LintRule {
   // Scans a single line during analysis.
   virtual void HandleLine(absl::string_view line) = 0;
 
+  // Scans all of the lines of 'text' (separated by '\n') at once, with the
+  // same result as calling HandleLine() on each of them, in order.
+  // Rules that can scan a whole buffer faster than line-by-line should
+  // override this, and stop adding violations at ReachedViolationLimit().
+  virtual void HandleText(absl::string_view text) {
+    for (const absl::string_view line : absl::StrSplit(text, '\n')) {
+      if (ReachedViolationLimit()) return;
+      HandleLine(line);
+    }
+  }
+
   // Analyze the final state of the rule, after the last line has been read.
   virtual void Finalize() {}
 };
@@ -27,10 +27,28 @@ namespace verible {
 void LineLinter::Lint(const std::vector<absl::string_view>& lines) {
   VLOG(1) << "LineLinter analyzing lines with " << rules_.size() << " rules.";
   for (const auto& line : lines) {
-    for (const auto& rule : rules_) {
-      ABSL_DIE_IF_NULL(rule)->HandleLine(line);
-    }
+    HandleLine(line);
   }
+  Finalize();
+}
+
+void LineLinter::LintText(absl::string_view text) {
+  VLOG(1) << "LineLinter analyzing text with " << rules_.size() << " rules.";
+  for (const auto& rule : rules_) {
+    if (ABSL_DIE_IF_NULL(rule)->ReachedViolationLimit()) continue;
+    rule->HandleText(text);
+  }
+  Finalize();
+}
+
+void LineLinter::HandleLine(absl::string_view line) {
+  for (const auto& rule : rules_) {
+    if (ABSL_DIE_IF_NULL(rule)->ReachedViolationLimit()) continue;
+    rule->HandleLine(line);
+  }
+}
+
+void LineLinter::Finalize() {
   for (const auto& rule : rules_) {
     rule->Finalize();
   }
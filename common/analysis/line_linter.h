@@ -34,6 +34,16 @@ class LineLinter {
   // Analyzes a sequence of lines.
   void Lint(const std::vector<absl::string_view>& lines);
 
+  // Analyzes all of the lines of 'text' (separated by '\n'), letting each rule
+  // scan the whole buffer at once.  This has the same result as Lint() on the
+  // split lines.
+  void LintText(absl::string_view text);
+
+  // Incremental interface, for driving rules from a pass shared with other
+  // linters: call HandleLine() on each line in order, followed by Finalize().
+  void HandleLine(absl::string_view line);
+  void Finalize();
+
   // Transfers ownership of rule into this Linter
   void AddRule(std::unique_ptr<LineLintRule> rule) {
     rules_.emplace_back(std::move(rule));
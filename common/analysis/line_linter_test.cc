@@ -40,14 +40,11 @@ class BlankLineRule : public LineLintRule {
   void HandleLine(absl::string_view line) override {
     if (line.empty()) {
       const TokenInfo token(0, line);
-      violations_.insert(LintViolation(token, "some reason"));
+      violations_.push_back(LintViolation(token, "some reason"));
     }
   }
 
   LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
-
- private:
-  std::set<LintViolation> violations_;
 };
 
 std::unique_ptr<LineLintRule> MakeBlankLineRule() {
@@ -96,7 +93,7 @@ class EmptyFileRule : public LineLintRule {
 
   void Finalize() override {
     if (lines_ == 0) {
-      violations_.insert(
+      violations_.push_back(
           LintViolation(TokenInfo::EOFToken(), "insufficient bytes"));
     }
   }
@@ -104,9 +101,6 @@ class EmptyFileRule : public LineLintRule {
   LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
 
   size_t lines_ = 0;
-
- private:
-  std::set<LintViolation> violations_;
 };
 
 std::unique_ptr<LineLintRule> MakeEmptyFileRule() {
@@ -137,5 +131,82 @@ TEST(LineLinterTest, FinalizeRejects) {
   EXPECT_THAT(statuses[0].violations, SizeIs(1));
 }
 
+// This test verifies that the incremental interface matches Lint().
+TEST(LineLinterTest, HandleLineThenFinalize) {
+  LineLinter linter;
+  linter.AddRule(MakeBlankLineRule());
+  linter.AddRule(MakeEmptyFileRule());
+  linter.HandleLine("abc");
+  linter.HandleLine("");
+  linter.Finalize();
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  ASSERT_THAT(statuses, SizeIs(2));
+  EXPECT_THAT(statuses[0].violations, SizeIs(1));
+  EXPECT_THAT(statuses[1].violations, IsEmpty());
+}
+
+// This test verifies that rules stop receiving lines at their limit.
+TEST(LineLinterTest, ViolationLimit) {
+  // Blank lines must be at distinct locations to be distinct violations.
+  constexpr absl::string_view text("\nabc\n\n\n");
+  std::vector<absl::string_view> lines{
+      {text.substr(0, 0), text.substr(1, 3), text.substr(5, 0),
+       text.substr(6, 0)}};
+  LineLinter linter;
+  auto rule = MakeBlankLineRule();
+  rule->SetViolationLimit(2);
+  linter.AddRule(std::move(rule));
+  linter.Lint(lines);
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  ASSERT_THAT(statuses, SizeIs(1));
+  EXPECT_THAT(statuses[0].violations, SizeIs(2));
+}
+
+// This test verifies that waived violations do not count toward the limit.
+TEST(LineLinterTest, ViolationLimitSkipsWaived) {
+  constexpr absl::string_view text("\nabc\n\n\n");
+  std::vector<absl::string_view> lines{
+      {text.substr(0, 0), text.substr(1, 3), text.substr(5, 0),
+       text.substr(6, 0)}};
+  LineLinter linter;
+  auto rule = MakeBlankLineRule();
+  rule->SetViolationLimit(1);
+  // Waive the blank line before "abc".
+  rule->SetViolationWaivedPredicate([&](const LintViolation& violation) {
+    return violation.token.left(text) == 0;
+  });
+  linter.AddRule(std::move(rule));
+  linter.Lint(lines);
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  ASSERT_THAT(statuses, SizeIs(1));
+  ASSERT_THAT(statuses[0].violations, SizeIs(2));
+  EXPECT_EQ(statuses[0].violations.rbegin()->token.left(text), 5);
+}
+
+// This test verifies that LintText() matches Lint() on the split lines.
+TEST(LineLinterTest, LintText) {
+  LineLinter linter;
+  linter.AddRule(MakeBlankLineRule());
+  linter.AddRule(MakeEmptyFileRule());
+  linter.LintText("abc\n\ndef\n");
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  ASSERT_THAT(statuses, SizeIs(2));
+  // The blank line, and the empty line after the final newline.
+  EXPECT_THAT(statuses[0].violations, SizeIs(2));
+  EXPECT_THAT(statuses[1].violations, IsEmpty());
+}
+
+// This test verifies that LintText() honors violation limits.
+TEST(LineLinterTest, LintTextViolationLimit) {
+  LineLinter linter;
+  auto rule = MakeBlankLineRule();
+  rule->SetViolationLimit(2);
+  linter.AddRule(std::move(rule));
+  linter.LintText("\nabc\n\n\n");
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  ASSERT_THAT(statuses, SizeIs(1));
+  EXPECT_THAT(statuses[0].violations, SizeIs(2));
+}
+
 }  // namespace
 }  // namespace verible
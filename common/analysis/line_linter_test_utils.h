@@ -37,7 +37,7 @@ class LintRunner<LineLintRule> {
 
   LintRuleStatus Run(const TextStructureView& text_structure,
                      absl::string_view) {
-    linter_.Lint(text_structure.Lines());
+    linter_.LintText(text_structure.Contents());
     // Looking for one type of rule violation at a time.
     CHECK_EQ(linter_.ReportStatus().size(), 1);
     return linter_.ReportStatus()[0];
@@ -0,0 +1,189 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/lint_diagnostic_sink.h"
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_column_map.h"
+
+namespace verible {
+
+namespace {
+// Prints a string as a quoted JSON string literal.
+struct JsonString {
+  absl::string_view text;
+};
+
+std::ostream& operator<<(std::ostream& stream, const JsonString& s) {
+  stream << '"';
+  for (const char c : s.text) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\r':
+        stream << "\\r";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          static constexpr char kHexDigits[] = "0123456789abcdef";
+          stream << "\\u00" << kHexDigits[c >> 4] << kHexDigits[c & 0xf];
+        } else {
+          stream << c;
+        }
+    }
+  }
+  return stream << '"';
+}
+}  // namespace
+
+void TextLintDiagnosticSink::Report(const LintDiagnostic& diagnostic) {
+  *stream_ << diagnostic.path << ':' << diagnostic.position << ": "
+           << diagnostic.reason << ' ' << diagnostic.url << " ["
+           << diagnostic.rule_name << ']' << std::endl;
+}
+
+void JsonLinesLintDiagnosticSink::Report(const LintDiagnostic& diagnostic) {
+  *stream_ << "{\"path\":" << JsonString{diagnostic.path}
+           << ",\"line\":" << diagnostic.position.line + 1
+           << ",\"column\":" << diagnostic.position.column + 1
+           << ",\"rule\":" << JsonString{diagnostic.rule_name}
+           << ",\"reason\":" << JsonString{diagnostic.reason}
+           << ",\"url\":" << JsonString{diagnostic.url} << '}' << std::endl;
+}
+
+void SarifLintDiagnosticSink::BeginResults() {
+  if (results_begun_) return;
+  results_begun_ = true;
+  *stream_ << "{\"$schema\":\"https://raw.githubusercontent.com/oasis-tcs/"
+              "sarif-spec/master/Schemata/sarif-schema-2.1.0.json\","
+              "\"version\":\"2.1.0\",\"runs\":[{\"results\":[";
+}
+
+void SarifLintDiagnosticSink::Report(const LintDiagnostic& diagnostic) {
+  BeginResults();
+  if (num_results_ > 0) *stream_ << ',';
+  ++num_results_;
+  *stream_ << "\n{\"ruleId\":" << JsonString{diagnostic.rule_name}
+           << ",\"level\":\"warning\",\"message\":{\"text\":"
+           << JsonString{diagnostic.reason}
+           << "},\"locations\":[{\"physicalLocation\":{\"artifactLocation\":"
+              "{\"uri\":"
+           << JsonString{diagnostic.path}
+           << "},\"region\":{\"startLine\":" << diagnostic.position.line + 1
+           << ",\"startColumn\":" << diagnostic.position.column + 1
+           << "}}}]}";
+  // Results are flushed one at a time, but not the (unfinished) document.
+  stream_->flush();
+  rule_urls_.emplace(std::string(diagnostic.rule_name),
+                     std::string(diagnostic.url));
+}
+
+void SarifLintDiagnosticSink::Finish() {
+  BeginResults();
+  // Object members are unordered, so the tool description can follow the
+  // results that were already streamed out.
+  *stream_ << "],\"tool\":{\"driver\":{\"name\":" << JsonString{tool_name_}
+           << ",\"rules\":[";
+  bool first = true;
+  for (const auto& rule : rule_urls_) {
+    if (!first) *stream_ << ',';
+    first = false;
+    *stream_ << "{\"id\":" << JsonString{rule.first}
+             << ",\"helpUri\":" << JsonString{rule.second} << '}';
+  }
+  *stream_ << "]}}}]}" << std::endl;
+}
+
+void BufferedLintDiagnosticSink::Report(const LintDiagnostic& diagnostic) {
+  diagnostics_.push_back(
+      {std::string(diagnostic.path), diagnostic.position,
+       std::string(diagnostic.rule_name), std::string(diagnostic.url),
+       std::string(diagnostic.reason)});
+}
+
+void BufferedLintDiagnosticSink::ReplayTo(LintDiagnosticSink* sink) const {
+  for (const auto& owned : diagnostics_) {
+    LintDiagnostic diagnostic;
+    diagnostic.path = owned.path;
+    diagnostic.position = owned.position;
+    diagnostic.rule_name = owned.rule_name;
+    diagnostic.url = owned.url;
+    diagnostic.reason = owned.reason;
+    sink->Report(diagnostic);
+  }
+}
+
+std::unique_ptr<LintDiagnosticSink> MakeLintDiagnosticSink(
+    absl::string_view format, std::ostream* stream,
+    absl::string_view tool_name) {
+  if (format == "text") {
+    return absl::make_unique<TextLintDiagnosticSink>(stream);
+  }
+  if (format == "jsonl") {
+    return absl::make_unique<JsonLinesLintDiagnosticSink>(stream);
+  }
+  if (format == "sarif") {
+    return absl::make_unique<SarifLintDiagnosticSink>(stream, tool_name);
+  }
+  return nullptr;
+}
+
+size_t ReportLintRuleStatuses(const std::vector<LintRuleStatus>& statuses,
+                              const LineColumnMap& line_map,
+                              absl::string_view base, absl::string_view path,
+                              size_t max_violations, LintDiagnosticSink* sink) {
+  auto violations = MergeLintViolations(statuses);
+  if (max_violations != 0 && violations.size() > max_violations) {
+    violations.erase(violations.begin() + max_violations, violations.end());
+  }
+  // Translate all (sorted) offsets in one sweep over the line map.
+  std::vector<int> offsets;
+  offsets.reserve(violations.size());
+  for (const auto& violation : violations) {
+    offsets.push_back(violation.violation->token.left(base));
+  }
+  const std::vector<LineColumn> positions = line_map.GetLineColumns(offsets);
+  size_t count = 0;
+  for (const auto& violation : violations) {
+    LintDiagnostic diagnostic;
+    diagnostic.path = path;
+    diagnostic.position = positions[count];
+    diagnostic.rule_name = violation.status->lint_rule_name;
+    diagnostic.url = violation.status->url;
+    diagnostic.reason = violation.violation->reason;
+    sink->Report(diagnostic);
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace verible
@@ -0,0 +1,152 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// LintDiagnosticSink receives lint findings one at a time, and writes them
+// out immediately in some output format, so that diagnostics never need to
+// be buffered beyond the findings of a single file.
+
+#ifndef VERIBLE_COMMON_ANALYSIS_LINT_DIAGNOSTIC_SINK_H_
+#define VERIBLE_COMMON_ANALYSIS_LINT_DIAGNOSTIC_SINK_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_column_map.h"
+
+namespace verible {
+
+// A single lint finding, fully resolved to a file position.
+// All string_views only need to remain valid for the duration of
+// LintDiagnosticSink::Report().
+struct LintDiagnostic {
+  absl::string_view path;
+  LineColumn position;  // 0-based
+  absl::string_view rule_name;
+  absl::string_view url;
+  absl::string_view reason;
+};
+
+class LintDiagnosticSink {
+ public:
+  virtual ~LintDiagnosticSink() = default;
+
+  // Writes out a single finding.
+  // Findings within the same file are reported in order of position.
+  virtual void Report(const LintDiagnostic& diagnostic) = 0;
+
+  // Completes the output after all files have been reported.
+  virtual void Finish() {}
+};
+
+// Writes one "path:line:column: reason url [rule]" line per finding,
+// the same format as LintStatusFormatter.
+class TextLintDiagnosticSink : public LintDiagnosticSink {
+ public:
+  explicit TextLintDiagnosticSink(std::ostream* stream) : stream_(stream) {}
+
+  void Report(const LintDiagnostic& diagnostic) override;
+
+ private:
+  std::ostream* const stream_;
+};
+
+// Writes one JSON object per line per finding.
+// Line and column numbers are 1-based.
+class JsonLinesLintDiagnosticSink : public LintDiagnosticSink {
+ public:
+  explicit JsonLinesLintDiagnosticSink(std::ostream* stream)
+      : stream_(stream) {}
+
+  void Report(const LintDiagnostic& diagnostic) override;
+
+ private:
+  std::ostream* const stream_;
+};
+
+// Writes a single SARIF 2.1.0 log with one run, whose results are streamed
+// as they are reported.  The output is only a complete JSON document after
+// Finish().
+class SarifLintDiagnosticSink : public LintDiagnosticSink {
+ public:
+  SarifLintDiagnosticSink(std::ostream* stream, absl::string_view tool_name)
+      : stream_(stream), tool_name_(tool_name) {}
+
+  void Report(const LintDiagnostic& diagnostic) override;
+
+  void Finish() override;
+
+ private:
+  void BeginResults();
+
+  std::ostream* const stream_;
+
+  const std::string tool_name_;
+
+  bool results_begun_ = false;
+
+  size_t num_results_ = 0;
+
+  // Help URL of every rule seen so far, for the tool description that is
+  // written by Finish().
+  std::map<std::string, std::string> rule_urls_;
+};
+
+// Records findings with copies of their strings, so that they can be reported
+// to another sink later, e.g. to report the findings of files that were
+// linted concurrently in a deterministic order.
+class BufferedLintDiagnosticSink : public LintDiagnosticSink {
+ public:
+  void Report(const LintDiagnostic& diagnostic) override;
+
+  // Reports all recorded findings to 'sink', in the order they were received.
+  void ReplayTo(LintDiagnosticSink* sink) const;
+
+  size_t size() const { return diagnostics_.size(); }
+
+ private:
+  struct OwnedDiagnostic {
+    std::string path;
+    LineColumn position;
+    std::string rule_name;
+    std::string url;
+    std::string reason;
+  };
+
+  std::vector<OwnedDiagnostic> diagnostics_;
+};
+
+// Returns a sink that writes to 'stream' in the named 'format', which is
+// one of "text", "jsonl", or "sarif", or nullptr for any other format.
+std::unique_ptr<LintDiagnosticSink> MakeLintDiagnosticSink(
+    absl::string_view format, std::ostream* stream,
+    absl::string_view tool_name);
+
+// Reports the violations of all 'statuses' for one file to 'sink', in order of
+// position.  'line_map' and 'base' are the line map and full text of the file.
+// At most 'max_violations' are reported (0 means no limit).
+// Returns the number of violations reported.
+size_t ReportLintRuleStatuses(const std::vector<LintRuleStatus>& statuses,
+                              const LineColumnMap& line_map,
+                              absl::string_view base, absl::string_view path,
+                              size_t max_violations, LintDiagnosticSink* sink);
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_ANALYSIS_LINT_DIAGNOSTIC_SINK_H_
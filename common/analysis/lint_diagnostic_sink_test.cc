@@ -0,0 +1,146 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/lint_diagnostic_sink.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/strings/line_column_map.h"
+#include "common/text/token_info.h"
+
+namespace verible {
+namespace {
+
+constexpr absl::string_view kText("abc\ndef\n");
+
+LintDiagnostic MakeDiagnostic(absl::string_view reason) {
+  LintDiagnostic diagnostic;
+  diagnostic.path = "x.sv";
+  diagnostic.position = {1, 2};
+  diagnostic.rule_name = "some-rule";
+  diagnostic.url = "http://style";
+  diagnostic.reason = reason;
+  return diagnostic;
+}
+
+TEST(TextLintDiagnosticSinkTest, Report) {
+  std::ostringstream stream;
+  TextLintDiagnosticSink sink(&stream);
+  sink.Report(MakeDiagnostic("bad"));
+  sink.Finish();
+  EXPECT_EQ(stream.str(), "x.sv:2:3: bad http://style [some-rule]\n");
+}
+
+TEST(JsonLinesLintDiagnosticSinkTest, ReportEscapes) {
+  std::ostringstream stream;
+  JsonLinesLintDiagnosticSink sink(&stream);
+  sink.Report(MakeDiagnostic("\"quoted\"\\\n"));
+  sink.Finish();
+  EXPECT_EQ(stream.str(),
+            "{\"path\":\"x.sv\",\"line\":2,\"column\":3,"
+            "\"rule\":\"some-rule\",\"reason\":\"\\\"quoted\\\"\\\\\\n\","
+            "\"url\":\"http://style\"}\n");
+}
+
+TEST(SarifLintDiagnosticSinkTest, Empty) {
+  std::ostringstream stream;
+  SarifLintDiagnosticSink sink(&stream, "tool");
+  sink.Finish();
+  EXPECT_NE(stream.str().find("\"results\":[]"), std::string::npos);
+  EXPECT_NE(stream.str().find("\"rules\":[]"), std::string::npos);
+}
+
+TEST(SarifLintDiagnosticSinkTest, MultipleResults) {
+  std::ostringstream stream;
+  SarifLintDiagnosticSink sink(&stream, "tool");
+  sink.Report(MakeDiagnostic("one"));
+  sink.Report(MakeDiagnostic("two"));
+  sink.Finish();
+  const std::string output(stream.str());
+  EXPECT_NE(output.find("\"text\":\"one\"},"), std::string::npos) << output;
+  EXPECT_NE(output.find("\"text\":\"two\"}"), std::string::npos) << output;
+  EXPECT_NE(output.find("\"startLine\":2,\"startColumn\":3"),
+            std::string::npos)
+      << output;
+  // Each rule is only described once.
+  EXPECT_NE(output.find("\"rules\":[{\"id\":\"some-rule\","
+                        "\"helpUri\":\"http://style\"}]"),
+            std::string::npos)
+      << output;
+}
+
+TEST(BufferedLintDiagnosticSinkTest, ReplayOutlivesReportedStrings) {
+  BufferedLintDiagnosticSink buffer;
+  {
+    const std::string reason("temporary");
+    buffer.Report(MakeDiagnostic(reason));
+  }
+  buffer.Report(MakeDiagnostic("second"));
+  EXPECT_EQ(buffer.size(), 2);
+
+  std::ostringstream stream;
+  TextLintDiagnosticSink sink(&stream);
+  buffer.ReplayTo(&sink);
+  EXPECT_EQ(stream.str(),
+            "x.sv:2:3: temporary http://style [some-rule]\n"
+            "x.sv:2:3: second http://style [some-rule]\n");
+}
+
+TEST(MakeLintDiagnosticSinkTest, Formats) {
+  std::ostringstream stream;
+  EXPECT_NE(MakeLintDiagnosticSink("text", &stream, "tool"), nullptr);
+  EXPECT_NE(MakeLintDiagnosticSink("jsonl", &stream, "tool"), nullptr);
+  EXPECT_NE(MakeLintDiagnosticSink("sarif", &stream, "tool"), nullptr);
+  EXPECT_EQ(MakeLintDiagnosticSink("xml", &stream, "tool"), nullptr);
+}
+
+TEST(ReportLintRuleStatusesTest, MergesInOrderWithLimit) {
+  const LineColumnMap line_map(kText);
+  std::vector<LintRuleStatus> statuses(2);
+  statuses[0].lint_rule_name = "rule-a";
+  statuses[0].violations.emplace_back(TokenInfo(1, kText.substr(4, 3)), "d");
+  statuses[1].lint_rule_name = "rule-b";
+  statuses[1].violations.emplace_back(TokenInfo(1, kText.substr(0, 1)), "a");
+  statuses[1].violations.emplace_back(TokenInfo(1, kText.substr(5, 1)), "e");
+
+  {
+    std::ostringstream stream;
+    TextLintDiagnosticSink sink(&stream);
+    EXPECT_EQ(ReportLintRuleStatuses(statuses, line_map, kText, "f.sv", 0,
+                                     &sink),
+              3);
+    EXPECT_EQ(stream.str(),
+              "f.sv:1:1: a  [rule-b]\n"
+              "f.sv:2:1: d  [rule-a]\n"
+              "f.sv:2:2: e  [rule-b]\n");
+  }
+  {
+    std::ostringstream stream;
+    TextLintDiagnosticSink sink(&stream);
+    EXPECT_EQ(ReportLintRuleStatuses(statuses, line_map, kText, "f.sv", 2,
+                                     &sink),
+              2);
+    EXPECT_EQ(stream.str(),
+              "f.sv:1:1: a  [rule-b]\n"
+              "f.sv:2:1: d  [rule-a]\n");
+  }
+}
+
+}  // namespace
+}  // namespace verible
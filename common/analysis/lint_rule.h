@@ -18,7 +18,11 @@
 #ifndef VERIBLE_COMMON_ANALYSIS_LINT_RULE_H_
 #define VERIBLE_COMMON_ANALYSIS_LINT_RULE_H_
 
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
@@ -47,6 +51,51 @@ class LintRule {
   // Report() returns a LintRuleStatus, which summarizes the results so
   // far of running the LintRule.
   virtual LintRuleStatus Report() const = 0;
+
+  // Limits the number of unwaived violations that this rule needs to collect.
+  // Once the limit is reached, linters stop passing input to this rule,
+  // although a single input may still add several violations.
+  // 0 means no limit, which is the default.
+  void SetViolationLimit(size_t limit) { violation_limit_ = limit; }
+
+  size_t ViolationLimit() const { return violation_limit_; }
+
+  // Tells which violations are waived, so that they do not count toward the
+  // violation limit.  By default, no violation is waived.
+  void SetViolationWaivedPredicate(
+      std::function<bool(const LintViolation&)> is_waived) {
+    is_waived_ = std::move(is_waived);
+  }
+
+  // Returns true if this rule has collected as many unwaived violations as it
+  // needs.
+  bool ReachedViolationLimit() {
+    if (violation_limit_ == 0) return false;
+    // Violations are only ever appended, so each one is checked once.
+    for (; num_checked_violations_ < violations_.size();
+         ++num_checked_violations_) {
+      if (!is_waived_ || !is_waived_(violations_[num_checked_violations_])) {
+        ++num_unwaived_violations_;
+      }
+    }
+    return num_unwaived_violations_ >= violation_limit_;
+  }
+
+ protected:
+  // Violations found so far, in the order they were found.
+  // Report() passes these to LintRuleStatus, which sorts them.
+  std::vector<LintViolation> violations_;
+
+ private:
+  size_t violation_limit_ = 0;
+
+  std::function<bool(const LintViolation&)> is_waived_;
+
+  // Prefix of violations_ that has been counted by ReachedViolationLimit().
+  size_t num_checked_violations_ = 0;
+
+  // Number of unwaived violations in that prefix.
+  size_t num_unwaived_violations_ = 0;
 };
 
 }  // namespace verible
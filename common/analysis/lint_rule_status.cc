@@ -58,33 +58,59 @@ void LintStatusFormatter::FormatLintRuleStatus(std::ostream* stream,
   }
 }
 
-struct LintViolationWithStatus {
-  const LintViolation* violation;
-  const LintRuleStatus* status;
-
-  LintViolationWithStatus(const LintViolation* v, const LintRuleStatus* s)
-      : violation(v), status(s) {}
-
-  bool operator<(const LintViolationWithStatus& r) const {
-    // compares addresses which correspond to locations within the same string
-    return violation->token.text.data() < r.violation->token.text.data();
+std::vector<LintViolationWithStatus> MergeLintViolations(
+    const std::vector<LintRuleStatus>& statuses) {
+  // Concatenate the already-sorted violations of each status, and merge
+  // adjacent runs pairwise until the whole sequence is sorted.
+  std::vector<LintViolationWithStatus> violations;
+  std::vector<size_t> run_bounds{0};
+  for (const auto& status : statuses) {
+    for (const auto& violation : status.violations) {
+      violations.emplace_back(&violation, &status);
+    }
+    if (violations.size() != run_bounds.back()) {
+      run_bounds.push_back(violations.size());
+    }
   }
-};
+  while (run_bounds.size() > 2) {
+    std::vector<size_t> merged_bounds{0};
+    for (size_t i = 2; i < run_bounds.size(); i += 2) {
+      // std::inplace_merge is stable, so earlier statuses come first.
+      std::inplace_merge(violations.begin() + run_bounds[i - 2],
+                         violations.begin() + run_bounds[i - 1],
+                         violations.begin() + run_bounds[i]);
+      merged_bounds.push_back(run_bounds[i]);
+    }
+    if (merged_bounds.back() != run_bounds.back()) {
+      merged_bounds.push_back(run_bounds.back());
+    }
+    run_bounds.swap(merged_bounds);
+  }
+
+  // Like any other ordered set, only keep one violation per location.
+  violations.erase(
+      std::unique(violations.begin(), violations.end(),
+                  [](const LintViolationWithStatus& l,
+                     const LintViolationWithStatus& r) { return !(l < r); }),
+      violations.end());
+  return violations;
+}
 
 void LintStatusFormatter::FormatLintRuleStatuses(
     std::ostream* stream, const std::vector<LintRuleStatus>& statuses,
     absl::string_view base, absl::string_view path) const {
-  std::set<LintViolationWithStatus> violations;
-
-  // TODO(fangism): rewrite as a linear time merge of pre-ordered sub-sequences
-  for (auto& status : statuses) {
-    for (auto& violation : status.violations) {
-      violations.insert(LintViolationWithStatus(&violation, &status));
-    }
+  const auto violations = MergeLintViolations(statuses);
+  // Translate all (sorted) offsets in one sweep over the line map.
+  std::vector<int> offsets;
+  offsets.reserve(violations.size());
+  for (const auto& violation : violations) {
+    offsets.push_back(violation.violation->token.left(base));
   }
-
-  for (auto violation : violations) {
-    FormatViolation(stream, *violation.violation, base, path,
+  const std::vector<LineColumn> positions =
+      line_column_map_.GetLineColumns(offsets);
+  auto position_iter = positions.begin();
+  for (const auto& violation : violations) {
+    FormatViolation(stream, *violation.violation, *position_iter++, path,
                     violation.status->url, violation.status->lint_rule_name);
     *stream << std::endl;
   }
@@ -98,21 +124,40 @@ void LintStatusFormatter::FormatViolation(std::ostream* stream,
                                           absl::string_view path,
                                           absl::string_view url,
                                           absl::string_view rule_name) const {
+  FormatViolation(stream, violation,
+                  line_column_map_(violation.token.left(base)), path, url,
+                  rule_name);
+}
+
+void LintStatusFormatter::FormatViolation(std::ostream* stream,
+                                          const LintViolation& violation,
+                                          const LineColumn& position,
+                                          absl::string_view path,
+                                          absl::string_view url,
+                                          absl::string_view rule_name) const {
   // TODO(fangism): Use the context member to print which named construct or
   // design element the violation appears in (or full stack thereof).
-  (*stream) << path << ':' << line_column_map_(violation.token.left(base))
-            << ": " << violation.reason << ' ' << url << " [" << rule_name
-            << ']';
+  (*stream) << path << ':' << position << ": " << violation.reason << ' '
+            << url << " [" << rule_name << ']';
+}
+
+void LintRuleStatus::SortViolations() {
+  // Stable, so that the first-found of equivalent violations is retained.
+  std::stable_sort(violations.begin(), violations.end());
+  violations.erase(std::unique(violations.begin(), violations.end(),
+                               [](const LintViolation& l,
+                                  const LintViolation& r) {
+                                 return !(l < r) && !(r < l);
+                               }),
+                   violations.end());
 }
 
 void LintRuleStatus::WaiveViolations(
     std::function<bool(const LintViolation&)>&& is_waived) {
-  std::set<LintViolation> filtered_violations;
-  std::remove_copy_if(
-      violations.begin(), violations.end(),
-      std::inserter(filtered_violations, filtered_violations.begin()),
-      is_waived);
-  violations.swap(filtered_violations);
+  // Preserves the order of the remaining violations.
+  violations.erase(
+      std::remove_if(violations.begin(), violations.end(), is_waived),
+      violations.end());
 }
 
 }  // namespace verible
@@ -19,7 +19,7 @@
 
 #include <functional>
 #include <iosfwd>
-#include <set>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -56,14 +56,14 @@ struct LintViolation {
   const Symbol* root = nullptr;
 
   // The token at which the error occurs, which includes location information.
-  const TokenInfo token;
+  TokenInfo token;
 
   // The reason why the violation occurs.
   std::string reason;
 
   // The context (list of ancestors) of the offending token.
   // For non-syntax-tree analyses, leave this blank.
-  const SyntaxTreeContext context;
+  SyntaxTreeContext context;
 
   bool operator<(const LintViolation& r) const {
     // compares addresses of violations, which correspond to substring
@@ -76,14 +76,25 @@ struct LintViolation {
 struct LintRuleStatus {
   LintRuleStatus() : violations() {}
 
-  LintRuleStatus(const std::set<LintViolation>& vs, absl::string_view rule_name,
-                 const std::string& url)
-      : lint_rule_name(rule_name), url(url), violations(vs) {}
+  // Violations may be given in any order, and may contain duplicates.
+  LintRuleStatus(const std::vector<LintViolation>& vs,
+                 absl::string_view rule_name, const std::string& url)
+      : lint_rule_name(rule_name), url(url), violations(vs) {
+    SortViolations();
+  }
 
-  explicit LintRuleStatus(const std::set<LintViolation>& vs) : violations(vs) {}
+  explicit LintRuleStatus(const std::vector<LintViolation>& vs)
+      : violations(vs) {
+    SortViolations();
+  }
 
   bool isOk() const { return violations.empty(); }
 
+  // Sorts violations by location, and removes all but the first of those
+  // that share a location.  Rules collect violations in the order that they
+  // are found, and this is done once when their status is reported.
+  void SortViolations();
+
   // Remove subset of violations that is waived from report.
   // If `is_waived`() is true, remove the finding from the set of violations.
   void WaiveViolations(std::function<bool(const LintViolation&)>&& is_waived);
@@ -94,10 +105,31 @@ struct LintRuleStatus {
   // Hold link to engdoc summary of violated rule
   std::string url;
 
-  // Contains all violations of the LintRule
-  std::set<LintViolation> violations;
+  // Contains all violations of the LintRule, ordered by location.
+  std::vector<LintViolation> violations;
+};
+
+// A violation, paired with the status of the rule that produced it.
+struct LintViolationWithStatus {
+  const LintViolation* violation;
+  const LintRuleStatus* status;
+
+  LintViolationWithStatus(const LintViolation* v, const LintRuleStatus* s)
+      : violation(v), status(s) {}
+
+  bool operator<(const LintViolationWithStatus& r) const {
+    // compares addresses which correspond to locations within the same string
+    return violation->token.text.data() < r.violation->token.text.data();
+  }
 };
 
+// Returns the violations of all 'statuses' ordered by location, with only one
+// violation per location (the one from the earliest status).
+// The violations of each status must already be sorted.
+// The returned pointers are into 'statuses'.
+std::vector<LintViolationWithStatus> MergeLintViolations(
+    const std::vector<LintRuleStatus>& statuses);
+
 // LintStatusFormatter is a class for printing LintRuleStatus's and
 // LintViolations to an output stream
 // Usage:
@@ -111,7 +143,13 @@ class LintStatusFormatter {
   // Constructor takes a reference to the original text in order to setup
   // line_column_map
   explicit LintStatusFormatter(absl::string_view text)
-      : line_column_map_(text) {}
+      : owned_line_column_map_(new LineColumnMap(text)),
+        line_column_map_(*owned_line_column_map_) {}
+
+  // Uses an existing map of the original text, such as the one held by
+  // TextStructureView, which must outlive this object.
+  explicit LintStatusFormatter(const LineColumnMap& line_column_map)
+      : line_column_map_(line_column_map) {}
 
   // Formats and outputs status to stream.
   // Path is the file path of original file. This is needed because it is not
@@ -125,6 +163,8 @@ class LintStatusFormatter {
   // Formats, sorts and outputs status to stream.
   // The violations contained in the statuses are sorted by their occurrence
   // in the code and are not grouped by the status object.
+  // Each status' violations must already be sorted, so that they only need
+  // to be merged.
   // Path is the file path of original file. This is needed because it is not
   // contained in status.
   // Base is the string_view of the entire contents, used only for byte offset
@@ -145,9 +185,19 @@ class LintStatusFormatter {
                        absl::string_view rule_name) const;
 
  private:
+  // Same as the public FormatViolation(), but with an already-translated
+  // position.
+  void FormatViolation(std::ostream* stream, const LintViolation& violation,
+                       const LineColumn& position, absl::string_view path,
+                       absl::string_view url,
+                       absl::string_view rule_name) const;
+
+  // Only set when this formatter built its own line_column_map_.
+  std::unique_ptr<const LineColumnMap> owned_line_column_map_;
+
   // Translates byte offsets, which are supplied by LintViolations via
   // locations field, to line:column
-  LineColumnMap line_column_map_;
+  const LineColumnMap& line_column_map_;
 };
 
 }  // namespace verible
@@ -30,7 +30,7 @@ namespace {
 
 // Tests initialization of LintRuleStatus.
 TEST(LintRuleStatusTest, Construction) {
-  std::set<LintViolation> violations;
+  std::vector<LintViolation> violations;
   LintRuleStatus status(violations, "RULE_NAME", "http://example.com/svstyle");
   EXPECT_TRUE(status.violations.empty());
   EXPECT_EQ(status.lint_rule_name, "RULE_NAME");
@@ -41,16 +41,32 @@ TEST(LintRuleStatusTest, Construction) {
 // Tests adding violations to LintRuleStatus.
 TEST(LintRuleStatusTest, ConstructWithViolation) {
   const TokenInfo token(1, "1bad-id");
-  std::set<LintViolation> violations({LintViolation(token, "invalid id")});
+  std::vector<LintViolation> violations({LintViolation(token, "invalid id")});
   LintRuleStatus status(violations, "RULE_NAME", "http://example.com/svstyle");
   EXPECT_FALSE(status.violations.empty());
   EXPECT_FALSE(status.isOk());
 }
 
+// Tests that violations are sorted by location and deduplicated.
+TEST(LintRuleStatusTest, ConstructSortsViolations) {
+  constexpr absl::string_view text("abcdef");
+  const TokenInfo token1(1, text.substr(0, 2));
+  const TokenInfo token2(1, text.substr(2, 2));
+  const TokenInfo token3(1, text.substr(4, 2));
+  const std::vector<LintViolation> violations{
+      LintViolation(token3, "third"), LintViolation(token1, "first"),
+      LintViolation(token2, "second"), LintViolation(token1, "duplicate")};
+  LintRuleStatus status(violations, "RULE_NAME", "http://example.com/svstyle");
+  ASSERT_EQ(status.violations.size(), 3);
+  EXPECT_EQ(status.violations[0].reason, "first");
+  EXPECT_EQ(status.violations[1].reason, "second");
+  EXPECT_EQ(status.violations[2].reason, "third");
+}
+
 // Tests waiving violations and removing them from LintRuleStatus.
 TEST(LintRuleStatusTest, WaiveViolations) {
   const TokenInfo token(1, "1bad-id");
-  std::set<LintViolation> violations({LintViolation(token, "invalid id")});
+  std::vector<LintViolation> violations({LintViolation(token, "invalid id")});
   LintRuleStatus status(violations, "RULE_NAME", "http://example.com/svstyle");
   EXPECT_FALSE(status.violations.empty());
   EXPECT_FALSE(status.isOk());
@@ -92,7 +108,7 @@ void RunLintStatusTest(const LintStatusTest& test) {
   status.url = test.url;
   status.lint_rule_name = test.rule_name;
   for (const auto& violation_test : test.violations) {
-    status.violations.insert(
+    status.violations.push_back(
         LintViolation(violation_test.token, violation_test.reason));
   }
 
@@ -160,10 +176,10 @@ void RunLintStatusesTest(const LintStatusTest& test) {
   ASSERT_EQ(test.violations.size(), 2);
 
   // Insert the violations in the wrong order
-  status0.violations.insert(
+  status0.violations.push_back(
       LintViolation(test.violations[1].token, test.violations[1].reason));
 
-  status1.violations.insert(
+  status1.violations.push_back(
       LintViolation(test.violations[0].token, test.violations[0].reason));
 
   statuses.push_back(status0);
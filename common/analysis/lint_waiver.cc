@@ -20,13 +20,21 @@
 #include <functional>
 #include <iterator>
 #include <map>
-#include <regex>  // NOLINT
+#include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "common/analysis/config_file_lexer.h"
 #include "common/strings/comment_utils.h"
 #include "common/strings/line_column_map.h"
@@ -37,9 +45,93 @@
 #include "common/util/file_util.h"
 #include "common/util/iterator_range.h"
 #include "common/util/logging.h"
+#include "re2/re2.h"
+#include "re2/set.h"
 
 namespace verible {
 
+namespace {
+
+// Process-wide cache of compiled waiver regular expressions.
+// The same external waiver configuration is applied to every linted file,
+// so each regular expression, and each set of regular expressions, is only
+// compiled once per process.  Entries are never evicted.
+class WaiverRegexCache {
+ public:
+  static WaiverRegexCache& Global() {
+    // Intentionally leaked, to avoid destruction order issues at exit.
+    static auto* cache = new WaiverRegexCache();
+    return *cache;
+  }
+
+  // Returns the compiled 'pattern', which may have failed to compile.
+  const re2::RE2& GetRegex(const std::string& pattern)
+      ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    auto& regex = regexes_[pattern];
+    if (regex == nullptr) {
+      // Errors are reported to the user by the caller.
+      re2::RE2::Options options;
+      options.set_log_errors(false);
+      regex = absl::make_unique<re2::RE2>(pattern, options);
+    }
+    return *regex;
+  }
+
+  // Returns an automaton that matches all of 'patterns' at once, where match
+  // indices correspond to positions in 'patterns', or nullptr if the
+  // patterns could not be combined, e.g. because the automaton would be too
+  // large.  Callers should then match the patterns individually.
+  // All 'patterns' must be valid.
+  const re2::RE2::Set* GetRegexSet(const std::vector<std::string>& patterns)
+      ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    const std::string key = absl::StrJoin(patterns, absl::string_view("\0", 1));
+    const auto found = regex_sets_.find(key);
+    if (found != regex_sets_.end()) return found->second.get();
+    re2::RE2::Options options;
+    // Hundreds of patterns make for a large automaton.
+    options.set_max_mem(kRegexSetMaxMemory);
+    options.set_log_errors(false);
+    auto regex_set =
+        absl::make_unique<re2::RE2::Set>(options, re2::RE2::UNANCHORED);
+    bool ok = true;
+    for (const auto& pattern : patterns) {
+      std::string error;
+      if (regex_set->Add(pattern, &error) < 0) {
+        LOG(WARNING) << "Unable to add waiver regex to set: " << error;
+        ok = false;
+        break;
+      }
+    }
+    if (ok && !regex_set->Compile()) {
+      LOG(WARNING) << "Waiver regexes are too large to be matched together.";
+      ok = false;
+    }
+    // Failures are remembered too, so they are not retried for every file.
+    auto& entry = regex_sets_[key];
+    if (ok) entry = std::move(regex_set);
+    return entry.get();
+  }
+
+ private:
+  static constexpr int64_t kRegexSetMaxMemory = 64 << 20;
+
+  absl::Mutex mutex_;
+
+  // Keyed by pattern.
+  absl::node_hash_map<std::string, std::unique_ptr<re2::RE2>> regexes_
+      ABSL_GUARDED_BY(mutex_);
+
+  // Keyed by '\0'-separated patterns.
+  absl::node_hash_map<std::string, std::unique_ptr<re2::RE2::Set>> regex_sets_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+constexpr int64_t WaiverRegexCache::kRegexSetMaxMemory;
+
+}  // namespace
+
 void LintWaiver::WaiveOneLine(absl::string_view rule_name, size_t line_number) {
   WaiveLineRange(rule_name, line_number, line_number + 1);
 }
@@ -50,26 +142,65 @@ void LintWaiver::WaiveLineRange(absl::string_view rule_name, size_t line_begin,
   line_set.Add({line_begin, line_end});
 }
 
-void LintWaiver::WaiveWithRegex(absl::string_view rule_name,
-                                const std::string& regex_str) {
-  RegexVector& regex_vector = waiver_re_map_[rule_name];
-  auto regex_iter = regex_cache_.find(regex_str);
-
-  if (regex_iter == regex_cache_.end()) {
-    regex_cache_[regex_str] = std::regex(regex_str);
+absl::Status LintWaiver::WaiveWithRegex(absl::string_view rule_name,
+                                        const std::string& regex_str) {
+  const re2::RE2& regex = WaiverRegexCache::Global().GetRegex(regex_str);
+  if (!regex.ok()) {
+    return absl::InvalidArgumentError(regex.error());
   }
-
-  regex_vector.push_back(&regex_cache_[regex_str]);
+  waiver_re_map_[regex_str].push_back(rule_name);
+  return absl::OkStatus();
 }
 
 void LintWaiver::RegexToLines(absl::string_view contents,
                               const LineColumnMap& line_map) {
-  for (const auto& rule : waiver_re_map_) {
-    for (const auto* re : rule.second) {
-      for (std::cregex_iterator i(contents.begin(), contents.end(), *re);
-           i != std::cregex_iterator(); i++) {
-        std::cmatch match = *i;
-        WaiveOneLine(rule.first, line_map(match.position()).line);
+  if (waiver_re_map_.empty()) return;
+  WaiverRegexCache& cache = WaiverRegexCache::Global();
+  std::vector<std::string> patterns;
+  std::vector<const std::vector<absl::string_view>*> pattern_rules;
+  patterns.reserve(waiver_re_map_.size());
+  pattern_rules.reserve(waiver_re_map_.size());
+  for (const auto& regex_rules : waiver_re_map_) {
+    patterns.push_back(regex_rules.first);
+    pattern_rules.push_back(&regex_rules.second);
+  }
+
+  const re2::RE2::Set* regex_set = cache.GetRegexSet(patterns);
+  // Only needed when the patterns cannot be matched as a set.
+  std::vector<const re2::RE2*> regexes;
+
+  // Match all patterns against each line, in a single pass over the contents.
+  const std::vector<int>& line_offsets = line_map.GetBeginningOfLineOffsets();
+  std::vector<int> matched_patterns;
+  for (size_t line = 0; line < line_offsets.size(); ++line) {
+    const size_t line_begin = line_offsets[line];
+    if (line_begin > contents.size()) break;
+    const size_t line_end = line + 1 < line_offsets.size()
+                                ? line_offsets[line + 1] - 1  // before '\n'
+                                : contents.size();
+    const re2::StringPiece text(contents.data() + line_begin,
+                                line_end - line_begin);
+    matched_patterns.clear();
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regex_set == nullptr ||
+        (!regex_set->Match(text, &matched_patterns, &error_info) &&
+         error_info.kind != re2::RE2::Set::kNoError)) {
+      // Fall back to matching every pattern individually.
+      if (regexes.empty()) {
+        for (const auto& pattern : patterns) {
+          regexes.push_back(&cache.GetRegex(pattern));
+        }
+      }
+      matched_patterns.clear();
+      for (size_t index = 0; index < regexes.size(); ++index) {
+        if (re2::RE2::PartialMatch(text, *regexes[index])) {
+          matched_patterns.push_back(index);
+        }
+      }
+    }
+    for (const int index : matched_patterns) {
+      for (const auto& rule : *pattern_rules[index]) {
+        waiver_map_[rule].Add({line, line + 1});
       }
     }
   }
@@ -199,6 +330,11 @@ void LintWaiverBuilder::ProcessTokenRangesByLine(
     CHECK_LE(end_dist, tokens.size());
     ProcessLine(token_range, i);
   }
+  Finalize(text_structure);
+}
+
+void LintWaiverBuilder::Finalize(const TextStructureView& text_structure) {
+  const size_t total_lines = text_structure.Lines().size();
 
   // Apply regex waivers
   lint_waiver_.RegexToLines(text_structure.Contents(),
@@ -346,11 +482,9 @@ absl::Status WaiveCommandHandler(
         }
 
         if (can_use_regex) {
-          try {
-            waiver->WaiveWithRegex(rule, regex);
-          } catch (const std::regex_error& e) {
-            auto* reason = e.what();
-
+          const auto regex_status = waiver->WaiveWithRegex(rule, regex);
+          if (!regex_status.ok()) {
+            const absl::string_view reason = regex_status.message();
             return WaiveCommandError(regex_token_pos, filename,
                                      "Invalid regex: ", reason);
           }
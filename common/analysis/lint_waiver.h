@@ -17,10 +17,11 @@
 
 #include <cstddef>
 #include <map>
-#include <regex>  // NOLINT
 #include <set>
+#include <string>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/text/text_structure.h"
 #include "common/text/token_stream_view.h"
@@ -35,7 +36,6 @@ class LintWaiver {
   // Compact set of line numbers.
   // TODO(b/156991337): combine with other definition of LineNumberSet
   using LineSet = IntervalSet<size_t>;
-  using RegexVector = std::vector<const std::regex*>;
 
  public:
   LintWaiver() {}
@@ -57,11 +57,18 @@ class LintWaiver {
   void WaiveLineRange(absl::string_view rule_name, size_t line_begin,
                       size_t line_end);
 
-  // Adds a regular expression which will be used to apply a waiver.
-  void WaiveWithRegex(absl::string_view rule_name, const std::string& regex);
+  // Adds a regular expression (RE2 syntax) which will be used to apply a
+  // waiver.  Returns an error if the regular expression is invalid.
+  absl::Status WaiveWithRegex(absl::string_view rule_name,
+                              const std::string& regex);
 
   // Converts the prepared regular expressions to line numbers and applies the
-  // waivers.
+  // waivers.  Each line that a regular expression matches (within the line)
+  // is waived.
+  // All regular expressions are compiled (once per process) into a single
+  // automaton, which finds the matching ones on every line in a single
+  // linear-time pass over the content.  If they are too large to be combined,
+  // they are matched individually instead.
   void RegexToLines(absl::string_view content, const LineColumnMap& line_map);
 
   // Returns true if `line_number` should be waived for a particular rule.
@@ -83,14 +90,16 @@ class LintWaiver {
   }
 
  private:
-  // Keys in the maps below are the names of the waived rules. They can be
+  // Keys in the map below are the names of the waived rules. They can be
   // string_view because the static strings for each lint rule class exist,
-  // and will outlive all LintWaiver objects. This applies to both waiver_map_
-  // and waiver_re_map_.
+  // and will outlive all LintWaiver objects. This also applies to the rule
+  // names in waiver_re_map_.
   std::map<absl::string_view, LineSet> waiver_map_;
-  std::map<absl::string_view, RegexVector> waiver_re_map_;
 
-  std::map<std::string, std::regex> regex_cache_;
+  // Keys are regular expressions, and values are the names of the rules that
+  // each regular expression waives.
+  // The ordered keys identify the compiled multi-pattern automaton.
+  std::map<std::string, std::vector<absl::string_view>> waiver_re_map_;
 };
 
 // LintWaiverBuilder is a language-agnostic helper class for constructing
@@ -139,6 +148,12 @@ class LintWaiverBuilder {
   // TextStructureTokenized from text_structure_test_utils.h.
   void ProcessTokenRangesByLine(const TextStructureView&);
 
+  // Completes the set of waived lines after every line has been passed to
+  // ProcessLine(): applies regex waivers, and extends any unterminated
+  // waiver ranges to the end of the file.
+  // ProcessTokenRangesByLine() already does this.
+  void Finalize(const TextStructureView&);
+
   // Takes a set of active linter rules and the filename and the content of
   // a waiver configuration file
   absl::Status ApplyExternalWaivers(
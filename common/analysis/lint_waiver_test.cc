@@ -15,9 +15,11 @@
 #include "common/analysis/lint_waiver.h"
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
 #include "common/strings/line_column_map.h"
 #include "common/text/text_structure_test_utils.h"
 #include "common/text/token_info.h"
@@ -785,5 +787,66 @@ TEST_F(LintWaiverBuilderTest, RegexToLinesMultipleMatches) {
   EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 2));
 }
 
+TEST_F(LintWaiverBuilderTest, RegexToLinesMultipleRegexesAndRules) {
+  const std::set<absl::string_view> active_rules{"rule-1", "rule-2"};
+  const absl::string_view filename = "filename";
+
+  const absl::string_view cfg_regex =
+      "waive --rule=rule-1 --regex=abc\n"
+      "waive --rule=rule-2 --regex=abc\n"
+      "waive --rule=rule-2 --regex=\"g+h\"\n"
+      "waive --rule=rule-1 --regex=nomatch\n";
+  EXPECT_TRUE(ApplyExternalWaivers(active_rules, filename, cfg_regex).ok());
+
+  const absl::string_view file = "abc\ndef\nggghi\nabc\n";
+  const LineColumnMap line_map(file);
+
+  lint_waiver_.RegexToLines(file, line_map);
+
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 1));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 2));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 3));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 0));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 1));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 2));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 3));
+}
+
+// Regexes are matched within lines, so anchors match at every line.
+TEST_F(LintWaiverBuilderTest, RegexToLinesAnchorsMatchLines) {
+  EXPECT_TRUE(lint_waiver_.WaiveWithRegex("rule-1", "^def$").ok());
+
+  const absl::string_view file = "abc\ndef\nxdef\n";
+  const LineColumnMap line_map(file);
+
+  lint_waiver_.RegexToLines(file, line_map);
+
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 1));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 2));
+}
+
+// Many large regexes may be too large to be matched as one set, which must
+// not prevent them from being applied.
+TEST_F(LintWaiverBuilderTest, RegexToLinesManyLargeRegexes) {
+  for (int i = 0; i < 200; ++i) {
+    const std::string regex =
+        absl::StrCat("(?:[a-z]{1000}){1}[\\x{100}-\\x{10ffff}]{900}", i);
+    EXPECT_TRUE(lint_waiver_.WaiveWithRegex("rule-1", regex).ok());
+  }
+  EXPECT_TRUE(lint_waiver_.WaiveWithRegex("rule-2", "def").ok());
+
+  const absl::string_view file = "abc\ndef\n";
+  const LineColumnMap line_map(file);
+
+  lint_waiver_.RegexToLines(file, line_map);
+
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 0));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-1", 1));
+  EXPECT_FALSE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 0));
+  EXPECT_TRUE(lint_waiver_.RuleIsWaivedOnLine("rule-2", 1));
+}
+
 }  // namespace
 }  // namespace verible
@@ -19,8 +19,8 @@
 #include <initializer_list>
 #include <iosfwd>
 #include <memory>
-#include <set>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
@@ -44,13 +44,15 @@ struct LintTestCase : public TokenInfoTestData {
       : TokenInfoTestData(fragments) {}
 
   // Compare the set of expected findings against actual findings.
+  // 'found_violations' must be ordered by location, like
+  // LintRuleStatus::violations.
   // Detailed differences are written to diffstream.
   // 'base' is the full text buffer that was analyzed, and is used to
   // calculate byte offsets in diagnostics.
   // Returns true if every element is an exact match to the expected set.
   // TODO(b/141875806): Take a symbol translator function to produce a
   // human-readable, language-specific enum name.
-  bool ExactMatchFindings(const std::set<LintViolation>& found_violations,
+  bool ExactMatchFindings(const std::vector<LintViolation>& found_violations,
                           absl::string_view base,
                           std::ostream* diffstream) const;
 };
@@ -0,0 +1,362 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Static matchers are compile-time counterparts of the matchers made by
+// matcher_builders.h and core_matchers.h, with the same matching and binding
+// behavior.
+//
+// A Matcher is assembled at run time from std::function predicates and a
+// std::vector of inner matchers, and allocates a vector of targets whenever
+// its predicate passes.  The type of a static matcher instead encodes its
+// whole pattern, so that matching compiles to inlined code that allocates
+// nothing, except to bind symbols, or to undo bindings of a partial match.
+//
+// Usage:
+//   constexpr StaticTagMatchBuilder<SymbolKind::kNode, int, 1> Node1;
+//   const auto HasLeaf2 = MakeStaticPathMatcher({LeafTag(2)});
+//   const auto matcher = Node1(HasLeaf2().Bind("leaf"));
+//   BoundSymbolManager manager;
+//   if (matcher.Matches(symbol, &manager)) ...
+//
+// Unlike with Matcher, 'manager' may be nullptr when bound symbols are not
+// needed.
+
+#ifndef VERIBLE_COMMON_ANALYSIS_MATCHER_STATIC_MATCHERS_H_
+#define VERIBLE_COMMON_ANALYSIS_MATCHER_STATIC_MATCHERS_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/util/casts.h"
+
+namespace verible {
+namespace matcher {
+namespace internal {
+
+// True if any of the matcher types may bind symbols.
+template <typename... Matchers>
+struct AnyMayBind : std::false_type {};
+
+template <typename M, typename... Rest>
+struct AnyMayBind<M, Rest...>
+    : std::integral_constant<bool, M::kMayBind || AnyMayBind<Rest...>::value> {
+};
+
+// Returns true if all of 'matchers', starting from the I-th, match 'symbol'.
+template <size_t I = 0, typename... Matchers>
+typename std::enable_if<I == sizeof...(Matchers), bool>::type MatchAll(
+    const std::tuple<Matchers...>&, const Symbol&, BoundSymbolManager*) {
+  return true;
+}
+
+template <size_t I = 0, typename... Matchers>
+typename std::enable_if<(I < sizeof...(Matchers)), bool>::type MatchAll(
+    const std::tuple<Matchers...>& matchers, const Symbol& symbol,
+    BoundSymbolManager* manager) {
+  return std::get<I>(matchers).Matches(symbol, manager) &&
+         MatchAll<I + 1>(matchers, symbol, manager);
+}
+
+// Returns match(), and if that is false, restores 'manager' to its state
+// before the call, like InnerMatchAll().
+// Only matchers that may bind symbols need a checkpoint, and a manager that
+// was empty is restored without one.
+template <bool kMayBind, typename MatchFunction>
+bool MatchOrRestore(BoundSymbolManager* manager, MatchFunction match) {
+  if (!kMayBind || manager == nullptr) return match();
+  if (manager->Size() == 0) {
+    if (match()) return true;
+    manager->Clear();
+    return false;
+  }
+  const BoundSymbolManager checkpoint(*manager);
+  if (match()) return true;
+  *manager = checkpoint;
+  return false;
+}
+
+// Same as MatchAll(), except that on failure, no symbols are bound.
+template <typename... Matchers>
+bool MatchAllOrRestore(const std::tuple<Matchers...>& matchers,
+                       const Symbol& symbol, BoundSymbolManager* manager) {
+  return MatchOrRestore<AnyMayBind<Matchers...>::value>(
+      manager, [&]() { return MatchAll(matchers, symbol, manager); });
+}
+
+// Returns true if any one of 'matchers', starting from the I-th, matches
+// 'symbol', and keeps only the symbols bound by the first one that does,
+// like InnerMatchAny().
+template <size_t I = 0, typename... Matchers>
+typename std::enable_if<I == sizeof...(Matchers), bool>::type MatchAny(
+    const std::tuple<Matchers...>&, const Symbol&, BoundSymbolManager*) {
+  return false;
+}
+
+template <size_t I = 0, typename... Matchers>
+typename std::enable_if<(I < sizeof...(Matchers)), bool>::type MatchAny(
+    const std::tuple<Matchers...>& matchers, const Symbol& symbol,
+    BoundSymbolManager* manager) {
+  using M = typename std::tuple_element<I, std::tuple<Matchers...>>::type;
+  const auto match = [&]() {
+    return std::get<I>(matchers).Matches(symbol, manager);
+  };
+  return MatchOrRestore<M::kMayBind>(manager, match) ||
+         MatchAny<I + 1>(matchers, symbol, manager);
+}
+
+}  // namespace internal
+
+// StaticBindMatcher matches whatever its inner matcher matches, and binds
+// the matched symbol to an id.  It is made by the Bind() method of other
+// static matchers.
+template <typename Inner>
+class StaticBindMatcher {
+ public:
+  static constexpr bool kMayBind = true;
+
+  // 'id' must outlive this matcher, as a string literal does.
+  constexpr StaticBindMatcher(const char* id, const Inner& inner)
+      : id_(id), inner_(inner) {}
+
+  bool Matches(const Symbol& symbol, BoundSymbolManager* manager) const {
+    if (!inner_.Matches(symbol, manager)) return false;
+    if (manager != nullptr) manager->BindSymbol(id_, &symbol);
+    return true;
+  }
+
+ private:
+  const char* id_;
+  Inner inner_;
+};
+
+// StaticAllOfMatcher is the counterpart of AllOf().
+template <typename... Inner>
+class StaticAllOfMatcher {
+ public:
+  static constexpr bool kMayBind = internal::AnyMayBind<Inner...>::value;
+
+  constexpr explicit StaticAllOfMatcher(const Inner&... inner)
+      : inner_(inner...) {}
+
+  bool Matches(const Symbol& symbol, BoundSymbolManager* manager) const {
+    return internal::MatchAllOrRestore(inner_, symbol, manager);
+  }
+
+ private:
+  std::tuple<Inner...> inner_;
+};
+
+// StaticAnyOfMatcher is the counterpart of AnyOf().
+template <typename... Inner>
+class StaticAnyOfMatcher {
+ public:
+  static constexpr bool kMayBind = internal::AnyMayBind<Inner...>::value;
+
+  constexpr explicit StaticAnyOfMatcher(const Inner&... inner)
+      : inner_(inner...) {}
+
+  bool Matches(const Symbol& symbol, BoundSymbolManager* manager) const {
+    return internal::MatchAny(inner_, symbol, manager);
+  }
+
+ private:
+  std::tuple<Inner...> inner_;
+};
+
+// StaticUnlessMatcher is the counterpart of Unless().
+template <typename Inner>
+class StaticUnlessMatcher {
+ public:
+  // Symbols bound by the inner matcher are always discarded.
+  static constexpr bool kMayBind = false;
+
+  constexpr explicit StaticUnlessMatcher(const Inner& inner) : inner_(inner) {}
+
+  bool Matches(const Symbol& symbol, BoundSymbolManager*) const {
+    return !inner_.Matches(symbol, nullptr);
+  }
+
+ private:
+  Inner inner_;
+};
+
+template <typename... Inner>
+constexpr StaticAllOfMatcher<Inner...> StaticAllOf(const Inner&... inner) {
+  static_assert(sizeof...(Inner) > 0,
+                "StaticAllOf requires at least one inner matcher");
+  return StaticAllOfMatcher<Inner...>(inner...);
+}
+
+template <typename... Inner>
+constexpr StaticAnyOfMatcher<Inner...> StaticAnyOf(const Inner&... inner) {
+  static_assert(sizeof...(Inner) > 0,
+                "StaticAnyOf requires at least one inner matcher");
+  return StaticAnyOfMatcher<Inner...>(inner...);
+}
+
+template <typename Inner>
+constexpr StaticUnlessMatcher<Inner> StaticUnless(const Inner& inner) {
+  return StaticUnlessMatcher<Inner>(inner);
+}
+
+// StaticTagMatcher is the counterpart of the matchers made by
+// TagMatchBuilder: it matches a symbol with the given Kind and Tag, if all
+// inner matchers match that symbol too.
+template <SymbolKind Kind, typename EnumType, EnumType Tag, typename... Inner>
+class StaticTagMatcher {
+ public:
+  static constexpr bool kMayBind = internal::AnyMayBind<Inner...>::value;
+
+  constexpr explicit StaticTagMatcher(const Inner&... inner)
+      : inner_(inner...) {}
+
+  bool Matches(const Symbol& symbol, BoundSymbolManager* manager) const {
+    const SymbolTag tag{Kind, static_cast<int>(Tag)};
+    return symbol.Tag() == tag &&
+           internal::MatchAllOrRestore(inner_, symbol, manager);
+  }
+
+  // Binds the matched symbol to 'id'.
+  constexpr StaticBindMatcher<StaticTagMatcher> Bind(const char* id) const {
+    return StaticBindMatcher<StaticTagMatcher>(id, *this);
+  }
+
+ private:
+  std::tuple<Inner...> inner_;
+};
+
+// StaticTagMatchBuilder is the counterpart of TagMatchBuilder.
+//
+// Usage:
+//   constexpr StaticTagMatchBuilder<SymbolKind::kNode, int, 1> Node1;
+//   const auto matcher = Node1(...inner matchers...);
+template <SymbolKind Kind, typename EnumType, EnumType Tag>
+class StaticTagMatchBuilder {
+ public:
+  constexpr StaticTagMatchBuilder() {}
+
+  template <typename... Inner>
+  constexpr StaticTagMatcher<Kind, EnumType, Tag, Inner...> operator()(
+      const Inner&... inner) const {
+    return StaticTagMatcher<Kind, EnumType, Tag, Inner...>(inner...);
+  }
+};
+
+// StaticPathMatcher is the counterpart of the matchers made by
+// PathMatchBuilder: it matches a node if any of its descendants along the
+// path is matched by all inner matchers.
+// Descendants are visited in the same order as GetAllDescendantsFromPath()
+// returns them, without collecting them.
+template <int N, typename... Inner>
+class StaticPathMatcher {
+  static_assert(N > 0, "Path must have at least one element");
+
+ public:
+  static constexpr bool kMayBind = internal::AnyMayBind<Inner...>::value;
+
+  StaticPathMatcher(const std::array<SymbolTag, N>& path,
+                    const Inner&... inner)
+      : path_(path), inner_(inner...) {}
+
+  bool Matches(const Symbol& symbol, BoundSymbolManager* manager) const {
+    if (symbol.Kind() != SymbolKind::kNode) return false;
+    const auto& node = *down_cast<const SyntaxTreeNode*>(&symbol);
+    return MatchChildren(node, 0, manager);
+  }
+
+  // Binds every descendant along the path that the inner matchers match
+  // to 'id'.
+  StaticPathMatcher<N, StaticBindMatcher<StaticAllOfMatcher<Inner...>>> Bind(
+      const char* id) const {
+    return StaticPathMatcher<N,
+                             StaticBindMatcher<StaticAllOfMatcher<Inner...>>>(
+        path_, StaticBindMatcher<StaticAllOfMatcher<Inner...>>(
+                   id, MakeAllOf(std::index_sequence_for<Inner...>())));
+  }
+
+ private:
+  // Every child is tried, like in Matcher::Matches(), so that all matching
+  // descendants are bound.
+  bool MatchChildren(const SyntaxTreeNode& node, size_t depth,
+                     BoundSymbolManager* manager) const {
+    bool any_child_matches = false;
+    for (const auto& child : node.children()) {
+      if (child) any_child_matches |= MatchAlongPath(*child, depth, manager);
+    }
+    return any_child_matches;
+  }
+
+  bool MatchAlongPath(const Symbol& symbol, size_t depth,
+                      BoundSymbolManager* manager) const {
+    if (symbol.Tag() != path_[depth]) return false;
+    if (depth + 1 == N) {
+      return internal::MatchAllOrRestore(inner_, symbol, manager);
+    }
+    if (symbol.Kind() != SymbolKind::kNode) return false;
+    const auto& node = *down_cast<const SyntaxTreeNode*>(&symbol);
+    return MatchChildren(node, depth + 1, manager);
+  }
+
+  template <size_t... I>
+  StaticAllOfMatcher<Inner...> MakeAllOf(std::index_sequence<I...>) const {
+    return StaticAllOfMatcher<Inner...>(std::get<I>(inner_)...);
+  }
+
+  std::array<SymbolTag, N> path_;
+
+  std::tuple<Inner...> inner_;
+};
+
+// StaticPathMatchBuilder is the counterpart of PathMatchBuilder.
+// Instances are generally created with MakeStaticPathMatcher.
+//
+// Note: StaticPathMatchBuilder has trivial destructor, so it is fit for const
+//       declarations at a global scope.
+template <int N>
+class StaticPathMatchBuilder {
+  static_assert(N > 0, "Path must have at least one element");
+
+ public:
+  explicit StaticPathMatchBuilder(const SymbolTag (&path)[N]) {
+    std::copy(std::begin(path), std::end(path), std::begin(path_));
+  }
+
+  template <typename... Inner>
+  StaticPathMatcher<N, Inner...> operator()(const Inner&... inner) const {
+    return StaticPathMatcher<N, Inner...>(path_, inner...);
+  }
+
+ private:
+  std::array<SymbolTag, N> path_;
+};
+
+// Helper function for creating StaticPathMatchBuilders.
+// Deduces size of path.
+template <int N>
+StaticPathMatchBuilder<N> MakeStaticPathMatcher(const SymbolTag (&path)[N]) {
+  return StaticPathMatchBuilder<N>(path);
+}
+
+}  // namespace matcher
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_ANALYSIS_MATCHER_STATIC_MATCHERS_H_
@@ -0,0 +1,141 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/matcher/static_matchers.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/analysis/matcher/bound_symbol_manager.h"
+#include "common/analysis/matcher/core_matchers.h"
+#include "common/analysis/matcher/matcher.h"
+#include "common/analysis/matcher/matcher_builders.h"
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/tree_builder_test_util.h"
+
+namespace verible {
+namespace matcher {
+namespace {
+
+// Runtime matchers, as in matcher_builders_test.cc.
+const TagMatchBuilder<SymbolKind::kNode, int, 5> Node5;
+const TagMatchBuilder<SymbolKind::kNode, int, 1> Node1;
+const TagMatchBuilder<SymbolKind::kLeaf, int, 1> Leaf1;
+const auto Path543 = MakePathMatcher({NodeTag(3), NodeTag(4), LeafTag(10)});
+const auto PathNode1 = MakePathMatcher({NodeTag(1)});
+const auto PathLeaf1 = MakePathMatcher({LeafTag(1)});
+
+// Their static counterparts.
+constexpr StaticTagMatchBuilder<SymbolKind::kNode, int, 5> SNode5;
+constexpr StaticTagMatchBuilder<SymbolKind::kNode, int, 1> SNode1;
+constexpr StaticTagMatchBuilder<SymbolKind::kLeaf, int, 1> SLeaf1;
+const auto SPath543 =
+    MakeStaticPathMatcher({NodeTag(3), NodeTag(4), LeafTag(10)});
+const auto SPathNode1 = MakeStaticPathMatcher({NodeTag(1)});
+const auto SPathLeaf1 = MakeStaticPathMatcher({LeafTag(1)});
+
+// Trees to match against, including ones with null children.
+std::vector<SymbolPtr> MakeTrees() {
+  std::vector<SymbolPtr> trees;
+  trees.push_back(TNode(5, nullptr));
+  trees.push_back(TNode(6, nullptr));
+  trees.push_back(TNode(5, nullptr, TNode(1, nullptr)));
+  trees.push_back(TNode(5, nullptr, TNode(4, nullptr)));
+  trees.push_back(
+      TNode(5, nullptr, TNode(3, nullptr, TNode(4, nullptr, XLeaf(10)))));
+  trees.push_back(TNode(5));
+  trees.push_back(TNode(5, TNode(3, TNode(4, XLeaf(10)))));
+  trees.push_back(TNode(6, TNode(3, TNode(4, XLeaf(10)))));
+  trees.push_back(TNode(5, TNode(1)));
+  trees.push_back(TNode(5, TNode(1, TNode(1))));
+  trees.push_back(TNode(5, TNode(1, XLeaf(1))));
+  trees.push_back(TNode(5, TNode(1, XLeaf(2)), TNode(1, XLeaf(1))));
+  trees.push_back(TNode(5, TNode(1, XLeaf(1)), TNode(1, XLeaf(1), XLeaf(1))));
+  trees.push_back(XLeaf(1));
+  return trees;
+}
+
+// Expects 'static_matcher' to match the same trees as 'matcher', and to bind
+// the same symbols, both with an empty and a non-empty BoundSymbolManager.
+template <typename M>
+void ExpectSameAsMatcher(const M& static_matcher, const Matcher& matcher) {
+  const auto trees = MakeTrees();
+  for (size_t i = 0; i < trees.size(); ++i) {
+    const Symbol& tree = *trees[i];
+    for (bool prebound : {false, true}) {
+      BoundSymbolManager expected_manager;
+      BoundSymbolManager manager;
+      if (prebound) {
+        expected_manager.BindSymbol("outer", &tree);
+        manager.BindSymbol("outer", &tree);
+      }
+      const bool expected = matcher.Matches(tree, &expected_manager);
+      EXPECT_EQ(static_matcher.Matches(tree, &manager), expected)
+          << "tree " << i;
+      EXPECT_EQ(manager.GetBoundMap(), expected_manager.GetBoundMap())
+          << "tree " << i;
+      EXPECT_EQ(static_matcher.Matches(tree, nullptr), expected)
+          << "tree " << i;
+    }
+  }
+}
+
+TEST(StaticMatchersTest, Tag) {
+  ExpectSameAsMatcher(SNode5(), Node5());
+  ExpectSameAsMatcher(SNode5().Bind("foo"), Node5().Bind("foo"));
+  ExpectSameAsMatcher(SLeaf1().Bind("leaf"), Leaf1().Bind("leaf"));
+}
+
+TEST(StaticMatchersTest, Path) {
+  ExpectSameAsMatcher(SNode5(SPathNode1()), Node5(PathNode1()));
+  ExpectSameAsMatcher(SNode5(SPath543().Bind("inner")).Bind("outer"),
+                      Node5(Path543().Bind("inner")).Bind("outer"));
+  ExpectSameAsMatcher(SNode5(SPathNode1(SNode1(SPathNode1(SNode1())))),
+                      Node5(PathNode1(Node1(PathNode1(Node1())))));
+}
+
+TEST(StaticMatchersTest, ManyBinds) {
+  ExpectSameAsMatcher(
+      SNode5(SPathNode1(SNode1(SPathLeaf1(SLeaf1().Bind("leaf1")).Bind(
+                                   "pleaf1"))
+                            .Bind("node1"))
+                 .Bind("pnode1"))
+          .Bind("node5"),
+      Node5(PathNode1(Node1(PathLeaf1(Leaf1().Bind("leaf1")).Bind("pleaf1"))
+                          .Bind("node1"))
+                .Bind("pnode1"))
+          .Bind("node5"));
+}
+
+TEST(StaticMatchersTest, CoreMatchers) {
+  ExpectSameAsMatcher(
+      SNode5(StaticAllOf(SPathNode1().Bind("a"), SPathLeaf1().Bind("b"))),
+      Node5(AllOf(PathNode1().Bind("a"), PathLeaf1().Bind("b"))));
+  ExpectSameAsMatcher(
+      SNode5(SPathNode1(StaticAnyOf(SPathLeaf1().Bind("a"),
+                                    SPathNode1().Bind("b")))),
+      Node5(PathNode1(AnyOf(PathLeaf1().Bind("a"), PathNode1().Bind("b")))));
+  ExpectSameAsMatcher(SNode5(StaticUnless(SPathNode1().Bind("a"))),
+                      Node5(Unless(PathNode1().Bind("a"))));
+  // A partial match binds nothing.
+  ExpectSameAsMatcher(
+      SNode5(SPathNode1().Bind("a"), SPath543()).Bind("outer"),
+      Node5(PathNode1().Bind("a"), Path543()).Bind("outer"));
+}
+
+}  // namespace
+}  // namespace matcher
+}  // namespace verible
@@ -0,0 +1,164 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/partitioned_syntax_tree_linter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/analysis/lint_rule_status.h"
+#include "common/analysis/syntax_tree_lint_rule.h"
+#include "common/analysis/syntax_tree_linter.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/tree_utils.h"
+#include "common/util/logging.h"
+#include "common/util/parallel_for.h"
+
+namespace verible {
+
+// Subtrees vary a lot in size, so make more ranges than threads, and let
+// threads that finish early take the next one.
+static constexpr size_t kRangesPerThread = 4;
+
+// Splits 'subtrees' into at most 'max_ranges' contiguous, non-empty ranges
+// that span about the same amount of text.
+// Returns the index at which each range begins, followed by subtrees.size().
+static std::vector<size_t> PartitionBySize(
+    const std::vector<const Symbol*>& subtrees, size_t max_ranges) {
+  std::vector<size_t> sizes;
+  sizes.reserve(subtrees.size());
+  size_t total_size = 0;
+  for (const auto* subtree : subtrees) {
+    // Count every subtree, even one without any text.
+    sizes.push_back(StringSpanOfSymbol(*subtree).size() + 1);
+    total_size += sizes.back();
+  }
+  std::vector<size_t> boundaries{0};
+  size_t size_so_far = 0;
+  for (size_t i = 0; i + 1 < subtrees.size(); ++i) {
+    size_so_far += sizes[i];
+    // Start the next range once this one holds its share of the text.
+    if (size_so_far * max_ranges >= total_size * boundaries.size()) {
+      boundaries.push_back(i + 1);
+    }
+  }
+  boundaries.push_back(subtrees.size());
+  return boundaries;
+}
+
+PartitionedSyntaxTreeLinter::PartitionedSyntaxTreeLinter(RuleFactory make_rules,
+                                                         int num_threads)
+    : make_rules_(std::move(make_rules)),
+      num_threads_(ResolveNumThreads(num_threads)) {}
+
+void PartitionedSyntaxTreeLinter::Lint(const Symbol& root) {
+  std::vector<const Symbol*> subtrees;
+  const SyntaxTreeNode* root_node = nullptr;
+  if (root.Kind() == SymbolKind::kNode) {
+    root_node = &SymbolCastToNode(root);
+    for (const auto& child : root_node->children()) {
+      if (child) subtrees.push_back(child.get());
+    }
+  }
+  const bool partition = num_threads_ > 1 && subtrees.size() > 1;
+
+  subtree_linters_.resize(1);
+  for (auto& rule : make_rules_()) {
+    const bool partitioned =
+        partition && ABSL_DIE_IF_NULL(rule)->CanLintSubtreesSeparately();
+    partitioned_.push_back(partitioned);
+    (partitioned ? subtree_linters_.front() : whole_tree_linter_)
+        .AddRule(std::move(rule));
+  }
+  if (!partition) {
+    whole_tree_linter_.Lint(root);
+    return;
+  }
+
+  const std::vector<size_t> boundaries =
+      PartitionBySize(subtrees, num_threads_ * kRangesPerThread);
+  const size_t num_ranges = boundaries.size() - 1;
+  // One linter per thread, each reused for every range that thread takes.
+  subtree_linters_.resize(
+      std::min(static_cast<size_t>(num_threads_), num_ranges));
+  for (size_t i = 1; i < subtree_linters_.size(); ++i) {
+    for (auto& rule : make_rules_()) {
+      if (rule->CanLintSubtreesSeparately()) {
+        subtree_linters_[i].AddRule(std::move(rule));
+      }
+    }
+  }
+  VLOG(1) << "PartitionedSyntaxTreeLinter linting " << subtrees.size()
+          << " subtrees in " << num_ranges << " ranges on "
+          << subtree_linters_.size() << " threads.";
+
+  const std::vector<const SyntaxTreeNode*> ancestors{root_node};
+  std::atomic<size_t> next_range(0);
+  // There are no more tasks than threads, so they all run at once, and take
+  // ranges until there are none left.  Task 0 first covers the root and the
+  // unpartitioned rules.
+  ParallelFor(subtree_linters_.size(), num_threads_, [&](size_t task) {
+    SyntaxTreeLinter& linter = subtree_linters_[task];
+    if (task == 0) {
+      whole_tree_linter_.Lint(root);
+      linter.LintRootOnly(*root_node);
+    }
+    for (size_t range = next_range++; range < num_ranges;
+         range = next_range++) {
+      for (size_t i = boundaries[range]; i < boundaries[range + 1]; ++i) {
+        linter.LintSubtree(*subtrees[i], ancestors);
+      }
+    }
+  });
+}
+
+std::vector<LintRuleStatus> PartitionedSyntaxTreeLinter::ReportStatus() const {
+  const std::vector<LintRuleStatus> whole_tree_statuses =
+      whole_tree_linter_.ReportStatus();
+  std::vector<std::vector<LintRuleStatus>> subtree_statuses;
+  subtree_statuses.reserve(subtree_linters_.size());
+  for (const auto& linter : subtree_linters_) {
+    subtree_statuses.push_back(linter.ReportStatus());
+  }
+
+  std::vector<LintRuleStatus> statuses;
+  statuses.reserve(partitioned_.size());
+  size_t next_whole_tree_status = 0;
+  size_t next_partitioned_status = 0;
+  for (const bool partitioned : partitioned_) {
+    if (!partitioned) {
+      statuses.push_back(whole_tree_statuses[next_whole_tree_status++]);
+      continue;
+    }
+    // Merge the violations that each instance of the rule found.
+    statuses.push_back(subtree_statuses.front()[next_partitioned_status]);
+    auto& violations = statuses.back().violations;
+    for (size_t i = 1; i < subtree_statuses.size(); ++i) {
+      const auto& instance_violations =
+          subtree_statuses[i][next_partitioned_status].violations;
+      violations.insert(violations.end(), instance_violations.begin(),
+                        instance_violations.end());
+    }
+    statuses.back().SortViolations();
+    ++next_partitioned_status;
+  }
+  return statuses;
+}
+
+}  // namespace verible
@@ -0,0 +1,80 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_ANALYSIS_PARTITIONED_SYNTAX_TREE_LINTER_H_
+#define VERIBLE_COMMON_ANALYSIS_PARTITIONED_SYNTAX_TREE_LINTER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/analysis/lint_rule_status.h"
+#include "common/analysis/syntax_tree_lint_rule.h"
+#include "common/analysis/syntax_tree_linter.h"
+#include "common/text/symbol.h"
+
+namespace verible {
+
+// PartitionedSyntaxTreeLinter finds the same violations as a
+// SyntaxTreeLinter with the same rules, but splits the syntax tree at the
+// children of its root (in Verilog, the top-level modules, packages, classes,
+// etc.), and lints contiguous ranges of them on different threads.
+// This shortens the time to lint a single very large file.
+//
+// Every thread lints the ranges it takes with its own instances of the rules,
+// and the violations of all instances of each rule are merged when reported.
+// Rules that cannot lint subtrees separately
+// (SyntaxTreeLintRule::CanLintSubtreesSeparately()) traverse the whole tree
+// in a single instance, concurrently with the ranges.
+//
+// Usage:
+//   PartitionedSyntaxTreeLinter linter(make_rules, num_threads);
+//   linter.Lint(*tree);
+//   std::vector<LintRuleStatus> status = linter.ReportStatus();
+class PartitionedSyntaxTreeLinter {
+ public:
+  // Returns a new instance of every rule, configured the same way, in the
+  // same order, every time it is called.  It is called once per thread.
+  using RuleFactory =
+      std::function<std::vector<std::unique_ptr<SyntaxTreeLintRule>>()>;
+
+  // 'num_threads' is resolved by ResolveNumThreads().
+  PartitionedSyntaxTreeLinter(RuleFactory make_rules, int num_threads);
+
+  // Performs lint analysis on root.  Call this only once.
+  void Lint(const Symbol& root);
+
+  // Aggregates results of each rule, in the order made by the RuleFactory.
+  std::vector<LintRuleStatus> ReportStatus() const;
+
+ private:
+  RuleFactory make_rules_;
+
+  int num_threads_;
+
+  // For every rule, in order: true if it is run separately on each range of
+  // subtrees, false if it is run on the whole tree by whole_tree_linter_.
+  std::vector<bool> partitioned_;
+
+  // Runs the rules that cannot be partitioned, over the whole tree.
+  SyntaxTreeLinter whole_tree_linter_;
+
+  // Each runs the partitioned rules on the ranges of the root's children
+  // that one thread takes.  The first one also lints the root node itself.
+  std::vector<SyntaxTreeLinter> subtree_linters_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_ANALYSIS_PARTITIONED_SYNTAX_TREE_LINTER_H_
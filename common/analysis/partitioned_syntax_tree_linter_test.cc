@@ -0,0 +1,185 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/analysis/partitioned_syntax_tree_linter.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/analysis/syntax_tree_lint_rule.h"
+#include "common/analysis/syntax_tree_linter.h"
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
+#include "common/text/syntax_tree_context.h"
+#include "common/text/tree_builder_test_util.h"
+#include "common/text/tree_utils.h"
+
+namespace verible {
+namespace {
+
+// Reports every leaf that has a given number of ancestors.
+class LeafDepthRule : public SyntaxTreeLintRule {
+ public:
+  explicit LeafDepthRule(size_t depth) : depth_(depth) {}
+
+  void HandleLeaf(const SyntaxTreeLeaf& leaf,
+                  const SyntaxTreeContext& context) override {
+    if (context.size() == depth_) {
+      violations_.push_back(LintViolation(leaf.get(), "depth", context));
+    }
+  }
+
+  bool CanLintSubtreesSeparately() const override { return true; }
+
+  LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
+
+ private:
+  size_t depth_;
+};
+
+// Reports the root node, which is the only node with tag 1.
+class RootRule : public SyntaxTreeLintRule {
+ public:
+  void HandleNode(const SyntaxTreeNode& node,
+                  const SyntaxTreeContext& context) override {
+    if (node.MatchesTag(1)) {
+      violations_.push_back(LintViolation(node, "root", context));
+    }
+  }
+
+  bool CanLintSubtreesSeparately() const override { return true; }
+
+  LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
+};
+
+// Reports every other leaf, which depends on all leaves before it.
+class EveryOtherLeafRule : public SyntaxTreeLintRule {
+ public:
+  void HandleLeaf(const SyntaxTreeLeaf& leaf,
+                  const SyntaxTreeContext& context) override {
+    if (++count_ % 2 == 0) {
+      violations_.push_back(LintViolation(leaf.get(), "other", context));
+    }
+  }
+
+  LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
+
+ private:
+  int count_ = 0;
+};
+
+std::vector<std::unique_ptr<SyntaxTreeLintRule>> MakeRules() {
+  std::vector<std::unique_ptr<SyntaxTreeLintRule>> rules;
+  rules.emplace_back(new LeafDepthRule(1));
+  rules.emplace_back(new EveryOtherLeafRule);
+  rules.emplace_back(new LeafDepthRule(2));
+  rules.emplace_back(new RootRule);
+  rules.emplace_back(new LeafDepthRule(3));
+  return rules;
+}
+
+void ExpectSameStatuses(const std::vector<LintRuleStatus>& actual,
+                        const std::vector<LintRuleStatus>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    ASSERT_EQ(actual[i].violations.size(), expected[i].violations.size())
+        << "rule " << i;
+    for (size_t j = 0; j < actual[i].violations.size(); ++j) {
+      EXPECT_EQ(actual[i].violations[j].token, expected[i].violations[j].token)
+          << "rule " << i << ", violation " << j;
+      EXPECT_EQ(actual[i].violations[j].context.size(),
+                expected[i].violations[j].context.size())
+          << "rule " << i << ", violation " << j;
+    }
+  }
+}
+
+TEST(PartitionedSyntaxTreeLinterTest, SameAsSyntaxTreeLinter) {
+  constexpr absl::string_view text("abcdefghijkl");
+  const SymbolPtr root = TNode(
+      1, Node(Leaf(2, text.substr(0, 1)), Leaf(2, text.substr(1, 1))),
+      Leaf(2, text.substr(2, 1)), nullptr,
+      Node(Leaf(2, text.substr(3, 1)),
+           Node(Leaf(2, text.substr(4, 1)), Leaf(2, text.substr(5, 1)))),
+      Node(Leaf(2, text.substr(6, 1))), Leaf(2, text.substr(7, 1)),
+      Node(Node(Leaf(2, text.substr(8, 1))), Leaf(2, text.substr(9, 1))),
+      Leaf(2, text.substr(10, 1)), Node(Leaf(2, text.substr(11, 1))));
+
+  SyntaxTreeLinter sequential;
+  for (auto& rule : MakeRules()) sequential.AddRule(std::move(rule));
+  sequential.Lint(*root);
+  const std::vector<LintRuleStatus> expected = sequential.ReportStatus();
+  // Every rule found something.
+  for (const auto& status : expected) EXPECT_FALSE(status.isOk());
+
+  for (int num_threads : {1, 2, 3, 4, 0}) {
+    PartitionedSyntaxTreeLinter linter(MakeRules, num_threads);
+    linter.Lint(*root);
+    ExpectSameStatuses(linter.ReportStatus(), expected);
+  }
+}
+
+TEST(PartitionedSyntaxTreeLinterTest, RulesMadeOncePerThread) {
+  const std::string buffer(100, 'a');
+  const absl::string_view text(buffer);
+  SymbolPtr root = TNode(1);
+  for (size_t i = 0; i < text.size(); ++i) {
+    SymbolCastToNode(*root).AppendChild(Node(Leaf(2, text.substr(i, 1))));
+  }
+  SyntaxTreeLinter sequential;
+  for (auto& rule : MakeRules()) sequential.AddRule(std::move(rule));
+  sequential.Lint(*root);
+  const std::vector<LintRuleStatus> expected = sequential.ReportStatus();
+
+  for (int num_threads : {2, 3}) {
+    int num_calls = 0;
+    PartitionedSyntaxTreeLinter linter(
+        [&num_calls]() {
+          ++num_calls;
+          return MakeRules();
+        },
+        num_threads);
+    linter.Lint(*root);
+    EXPECT_EQ(num_calls, num_threads);
+    ExpectSameStatuses(linter.ReportStatus(), expected);
+  }
+}
+
+TEST(PartitionedSyntaxTreeLinterTest, RootLeaf) {
+  constexpr absl::string_view text("a");
+  const SymbolPtr root = Leaf(2, text);
+  PartitionedSyntaxTreeLinter linter(MakeRules, 4);
+  linter.Lint(*root);
+  const std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  ASSERT_EQ(statuses.size(), 5);
+  for (const auto& status : statuses) EXPECT_TRUE(status.isOk());
+}
+
+TEST(PartitionedSyntaxTreeLinterTest, NoRules) {
+  constexpr absl::string_view text("ab");
+  const SymbolPtr root =
+      TNode(1, Leaf(2, text.substr(0, 1)), Leaf(2, text.substr(1, 1)));
+  PartitionedSyntaxTreeLinter linter(
+      []() { return std::vector<std::unique_ptr<SyntaxTreeLintRule>>(); }, 2);
+  linter.Lint(*root);
+  EXPECT_TRUE(linter.ReportStatus().empty());
+}
+
+}  // namespace
+}  // namespace verible
@@ -43,6 +43,13 @@ class SyntaxTreeLintRule : public LintRule {
                           const SyntaxTreeContext& context) {}
   virtual void HandleSymbol(const Symbol& node,
                             const SyntaxTreeContext& context) {}
+
+  // Returns true if this rule finds the same violations when each child
+  // subtree of the root is linted by a separate instance of it, with the
+  // path from the root as context (see PartitionedSyntaxTreeLinter).
+  // Only rules that carry no state from one leaf or node to the next, other
+  // than their violations, should return true.
+  virtual bool CanLintSubtreesSeparately() const { return false; }
 };
 
 }  // namespace verible
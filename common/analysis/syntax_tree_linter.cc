@@ -33,6 +33,28 @@ void SyntaxTreeLinter::Lint(const Symbol& root) {
   root.Accept(this);
 }
 
+void SyntaxTreeLinter::LintSubtree(
+    const Symbol& subtree,
+    const std::vector<const SyntaxTreeNode*>& ancestors) {
+  LintSubtreeInContext(subtree, ancestors.begin(), ancestors.end());
+}
+
+void SyntaxTreeLinter::LintSubtreeInContext(
+    const Symbol& subtree,
+    std::vector<const SyntaxTreeNode*>::const_iterator begin,
+    std::vector<const SyntaxTreeNode*>::const_iterator end) {
+  if (begin == end) {
+    subtree.Accept(this);
+    return;
+  }
+  const SyntaxTreeContext::AutoPop ancestor(&current_context_, &**begin);
+  LintSubtreeInContext(subtree, begin + 1, end);
+}
+
+void SyntaxTreeLinter::LintRootOnly(const SyntaxTreeNode& root) {
+  HandleNode(root);
+}
+
 std::vector<LintRuleStatus> SyntaxTreeLinter::ReportStatus() const {
   std::vector<LintRuleStatus> status;
   for (const auto& rule : rules_) {
@@ -44,8 +66,9 @@ std::vector<LintRuleStatus> SyntaxTreeLinter::ReportStatus() const {
 // Visits a leaf. Every held rule handles that leaf.
 void SyntaxTreeLinter::Visit(const SyntaxTreeLeaf& leaf) {
   for (const auto& rule : rules_) {
+    if (ABSL_DIE_IF_NULL(rule)->ReachedViolationLimit()) continue;
     // Have rule handle the leaf as both a leaf and a symbol.
-    ABSL_DIE_IF_NULL(rule)->HandleLeaf(leaf, Context());
+    rule->HandleLeaf(leaf, Context());
     rule->HandleSymbol(leaf, Context());
   }
 }
@@ -54,14 +77,19 @@ void SyntaxTreeLinter::Visit(const SyntaxTreeLeaf& leaf) {
 // Second, linter recurses on every non-null child of that node in order
 // to visit the entire tree
 void SyntaxTreeLinter::Visit(const SyntaxTreeNode& node) {
+  HandleNode(node);
+
+  // Visit subtree children.
+  TreeContextVisitor::Visit(node);
+}
+
+void SyntaxTreeLinter::HandleNode(const SyntaxTreeNode& node) {
   for (const auto& rule : rules_) {
+    if (ABSL_DIE_IF_NULL(rule)->ReachedViolationLimit()) continue;
     // Have rule handle the node as both a node and a symbol.
-    ABSL_DIE_IF_NULL(rule)->HandleNode(node, Context());
+    rule->HandleNode(node, Context());
     rule->HandleSymbol(node, Context());
   }
-
-  // Visit subtree children.
-  TreeContextVisitor::Visit(node);
 }
 
 }  // namespace verible
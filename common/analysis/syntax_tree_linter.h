@@ -65,7 +65,25 @@ class SyntaxTreeLinter : public TreeContextVisitor {
   // Performs lint analysis on root
   void Lint(const Symbol& root);
 
+  // Performs lint analysis on 'subtree' as if it had been reached by a
+  // traversal from the root, where 'ancestors' is the path to it, from the
+  // root down to its parent.
+  void LintSubtree(const Symbol& subtree,
+                   const std::vector<const SyntaxTreeNode*>& ancestors);
+
+  // Lets every rule handle 'root', without visiting any of its children.
+  void LintRootOnly(const SyntaxTreeNode& root);
+
  private:
+  // Lets every rule handle 'node' in the current context.
+  void HandleNode(const SyntaxTreeNode& node);
+
+  // Pushes ancestors [begin, end) onto the context, and visits 'subtree'.
+  void LintSubtreeInContext(
+      const Symbol& subtree,
+      std::vector<const SyntaxTreeNode*>::const_iterator begin,
+      std::vector<const SyntaxTreeNode*>::const_iterator end);
+
   // List of rules that the linter is using. Rules are responsible for tracking
   // their own internal state.
   std::vector<std::unique_ptr<SyntaxTreeLintRule>> rules_;
@@ -42,7 +42,7 @@ class AllLeavesMustBeN : public SyntaxTreeLintRule {
   void HandleLeaf(const SyntaxTreeLeaf& leaf,
                   const SyntaxTreeContext& context) override {
     if (leaf.get().token_enum != target_) {
-      violations_.insert(LintViolation(leaf.get(), "", context));
+      violations_.push_back(LintViolation(leaf.get(), "", context));
     }
   }
 
@@ -52,7 +52,6 @@ class AllLeavesMustBeN : public SyntaxTreeLintRule {
   LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
 
  private:
-  std::set<LintViolation> violations_;
   int target_;
 };
 
@@ -129,7 +128,7 @@ class ChildrenLeavesAscending : public SyntaxTreeLintRule {
         if (current_tag >= last_tag) {
           last_tag = current_tag;
         } else {
-          violations_.insert(LintViolation(leaf_child->get(), "", context));
+          violations_.push_back(LintViolation(leaf_child->get(), "", context));
           return;
         }
       }
@@ -137,9 +136,6 @@ class ChildrenLeavesAscending : public SyntaxTreeLintRule {
   }
 
   LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
-
- private:
-  std::set<LintViolation> violations_;
 };
 
 std::unique_ptr<SyntaxTreeLintRule> MakeAscending() {
@@ -224,7 +220,7 @@ class TagMatchesContextDepth : public SyntaxTreeLintRule {
   void HandleLeaf(const SyntaxTreeLeaf& leaf,
                   const SyntaxTreeContext& context) override {
     if (static_cast<size_t>(leaf.get().token_enum) != context.size()) {
-      violations_.insert(LintViolation(leaf.get(), "", context));
+      violations_.push_back(LintViolation(leaf.get(), "", context));
     }
   }
   // Do not process nodes
@@ -232,9 +228,6 @@ class TagMatchesContextDepth : public SyntaxTreeLintRule {
                   const SyntaxTreeContext& context) override {}
 
   LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
-
- private:
-  std::set<LintViolation> violations_;
 };
 
 std::unique_ptr<SyntaxTreeLintRule> MakeDepth() {
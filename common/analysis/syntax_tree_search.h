@@ -16,11 +16,16 @@
 #define VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_SEARCH_H_
 
 #include <functional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "common/analysis/matcher/matcher.h"
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
+#include "common/text/tree_context_visitor.h"
 
 namespace verible {
 
@@ -51,6 +56,94 @@ std::vector<TreeSearchMatch> SearchSyntaxTree(
 std::vector<TreeSearchMatch> SearchSyntaxTree(
     const Symbol& root, const verible::matcher::Matcher& matcher);
 
+namespace internal {
+// SyntaxTreeSearcher collects nodes that match specified criteria
+// from a syntax tree.  Prefer to use the SearchSyntaxTree() function
+// over this class.
+// SymbolPredicate is any callable with the signature bool(const Symbol&).
+// It is a template parameter, so that it can be inlined into the traversal.
+template <typename SymbolPredicate>
+class SyntaxTreeSearcher : public TreeContextVisitor {
+ public:
+  SyntaxTreeSearcher(
+      const SymbolPredicate& symbol_predicate,
+      const std::function<bool(const SyntaxTreeContext&)>& context_predicate)
+      : symbol_predicate_(symbol_predicate),
+        context_predicate_(context_predicate) {}
+
+  void Search(const Symbol& root) { root.Accept(this); }
+
+  std::vector<TreeSearchMatch> TakeMatches() { return std::move(matches_); }
+
+ private:
+  // Checks if symbol matches criteria.
+  void CheckSymbol(const Symbol& symbol) {
+    if (symbol_predicate_(symbol) && context_predicate_(Context())) {
+      matches_.push_back(TreeSearchMatch{&symbol, Context()});
+    }
+  }
+
+  void Visit(const SyntaxTreeLeaf& leaf) override { CheckSymbol(leaf); }
+
+  // Checks if node matches criteria.
+  // Then recursively search subtree.
+  void Visit(const SyntaxTreeNode& node) override {
+    CheckSymbol(node);
+    TreeContextVisitor::Visit(node);
+  }
+
+  // Main criteria that finds a particular type of tree node.
+  const SymbolPredicate& symbol_predicate_;
+
+  // Predicate that further qualifies the matches of interest.
+  // It is only called on symbols that satisfy symbol_predicate_.
+  const std::function<bool(const SyntaxTreeContext&)>& context_predicate_;
+
+  // Accumulated set of matches.
+  std::vector<TreeSearchMatch> matches_;
+};
+
+// Same as SearchSyntaxTree(), except that symbols are selected by
+// 'symbol_predicate' instead of a matcher.
+template <typename SymbolPredicate>
+std::vector<TreeSearchMatch> SearchSyntaxTree(
+    const Symbol& root, const SymbolPredicate& symbol_predicate,
+    const std::function<bool(const SyntaxTreeContext&)>& context_predicate) {
+  SyntaxTreeSearcher<SymbolPredicate> searcher(symbol_predicate,
+                                               context_predicate);
+  searcher.Search(root);
+  return searcher.TakeMatches();
+}
+}  // namespace internal
+
+// Same as above, but with a static matcher (see matcher/static_matchers.h),
+// which does not allocate to reject a symbol, and binds nothing here.
+// The matcher is inlined into the traversal.
+template <typename StaticMatcher,
+          typename std::enable_if<
+              !std::is_base_of<verible::matcher::Matcher, StaticMatcher>::value,
+              int>::type = 0>
+std::vector<TreeSearchMatch> SearchSyntaxTree(
+    const Symbol& root, const StaticMatcher& matcher,
+    std::function<bool(const SyntaxTreeContext&)> context_predicate) {
+  return internal::SearchSyntaxTree(
+      root,
+      [&matcher](const Symbol& symbol) {
+        return matcher.Matches(symbol, nullptr);
+      },
+      context_predicate);
+}
+
+template <typename StaticMatcher,
+          typename std::enable_if<
+              !std::is_base_of<verible::matcher::Matcher, StaticMatcher>::value,
+              int>::type = 0>
+std::vector<TreeSearchMatch> SearchSyntaxTree(const Symbol& root,
+                                              const StaticMatcher& matcher) {
+  return SearchSyntaxTree(root, matcher,
+                          [](const SyntaxTreeContext&) { return true; });
+}
+
 }  // namespace verible
 
 #endif  // VERIBLE_COMMON_ANALYSIS_SYNTAX_TREE_SEARCH_H_
@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 #include "common/analysis/matcher/matcher.h"
 #include "common/analysis/matcher/matcher_builders.h"
+#include "common/analysis/matcher/static_matchers.h"
 #include "common/text/symbol.h"
 #include "common/text/syntax_tree_context.h"
 #include "common/text/tree_builder_test_util.h"
@@ -134,5 +135,26 @@ TEST(SearchSyntaxTreeTest, RootOnlyNodeMatchTruePredicate) {
   EXPECT_EQ(&SymbolCastToNode(*matches.front().match), tree.get());
 }
 
+// Tests that a static matcher finds the same nodes as a Matcher.
+TEST(SearchSyntaxTreeTest, NestedNodeStaticMatch) {
+  auto tree = Node(TNode(1, TNode(3), TNode(1)), Node(XLeaf(4), TNode(3)));
+  const auto matches = SearchSyntaxTree(*tree, NodeMatcher<1>()());
+  constexpr matcher::StaticTagMatchBuilder<SymbolKind::kNode, int, 1> Node1;
+  const auto static_matches = SearchSyntaxTree(*tree, Node1());
+  ASSERT_EQ(static_matches.size(), 2);
+  EXPECT_EQ(static_matches.front().match, matches.front().match);
+  EXPECT_EQ(static_matches.back().match, matches.back().match);
+  EXPECT_EQ(static_matches.back().context.size(), 2);
+}
+
+// Tests that false predicate filters out matches of a static matcher.
+TEST(SearchSyntaxTreeTest, StaticMatchFalsePredicate) {
+  auto tree = TNode(0);
+  constexpr matcher::StaticTagMatchBuilder<SymbolKind::kNode, int, 0> Node0;
+  auto matches = SearchSyntaxTree(
+      *tree, Node0(), [](const SyntaxTreeContext&) { return false; });
+  EXPECT_TRUE(matches.empty());
+}
+
 }  // namespace
 }  // namespace verible
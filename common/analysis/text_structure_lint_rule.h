@@ -36,6 +36,15 @@
 
 namespace verible {
 
+// Forms of a TextStructureView that an analysis can depend on, ordered from
+// cheapest to most expensive to compute.  Each level implies all of the
+// levels before it.
+enum class TextAnalysisLevel {
+  kLines,       // text partitioned into lines
+  kTokens,      // lexed (unfiltered) token stream
+  kSyntaxTree,  // preprocessed and parsed concrete syntax tree
+};
+
 class TextStructureLintRule : public LintRule {
  public:
   ~TextStructureLintRule() override {}
@@ -43,6 +52,13 @@ class TextStructureLintRule : public LintRule {
   // Analyze text structure for violations.
   virtual void Lint(const TextStructureView& text_structure,
                     absl::string_view filename) = 0;
+
+  // Returns the parts of the TextStructureView that Lint() examines.
+  // Only the parts up to this level are guaranteed to be populated.
+  // Conservatively defaults to requiring the syntax tree.
+  virtual TextAnalysisLevel RequiredAnalysisLevel() const {
+    return TextAnalysisLevel::kSyntaxTree;
+  }
 };
 
 }  // namespace verible
@@ -14,6 +14,7 @@
 
 #include "common/analysis/text_structure_linter.h"
 
+#include <cstddef>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -28,11 +29,17 @@ void TextStructureLinter::Lint(const TextStructureView& text_structure,
                                absl::string_view filename) {
   VLOG(1) << "TextStructureLinter analyzing text with " << rules_.size()
           << " rules.";
-  for (const auto& rule : rules_) {
-    ABSL_DIE_IF_NULL(rule)->Lint(text_structure, filename);
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    LintOneRule(i, text_structure, filename);
   }
 }
 
+void TextStructureLinter::LintOneRule(size_t rule_index,
+                                      const TextStructureView& text_structure,
+                                      absl::string_view filename) {
+  ABSL_DIE_IF_NULL(rules_[rule_index])->Lint(text_structure, filename);
+}
+
 std::vector<LintRuleStatus> TextStructureLinter::ReportStatus() const {
   std::vector<LintRuleStatus> status;
   for (const auto& rule : rules_) {
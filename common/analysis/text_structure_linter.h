@@ -19,6 +19,7 @@
 #ifndef VERIBLE_COMMON_ANALYSIS_TEXT_STRUCTURE_LINTER_H_
 #define VERIBLE_COMMON_ANALYSIS_TEXT_STRUCTURE_LINTER_H_
 
+#include <cstddef>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -35,6 +36,15 @@ class TextStructureLinter {
   // Analyzes a sequence of tokens.
   void Lint(const TextStructureView&, absl::string_view);
 
+  // Number of rules, for use with LintOneRule().
+  size_t NumRules() const { return rules_.size(); }
+
+  // Same as Lint(), but only runs the rule at 'rule_index' (in order of
+  // AddRule()).  Different rules may be run concurrently on the same
+  // TextStructureView.
+  void LintOneRule(size_t rule_index, const TextStructureView&,
+                   absl::string_view);
+
   // Transfers ownership of rule into this Linter
   void AddRule(std::unique_ptr<TextStructureLintRule> rule) {
     rules_.emplace_back(std::move(rule));
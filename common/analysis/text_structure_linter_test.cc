@@ -43,14 +43,11 @@ class RequireHelloRule : public TextStructureLintRule {
     const absl::string_view contents = text_structure.Contents();
     if (!lines.empty() && !absl::StartsWith(contents, "Hello")) {
       const TokenInfo token(1, lines[0]);
-      violations_.emplace(token, "Text must begin with Hello");
+      violations_.emplace_back(token, "Text must begin with Hello");
     }
   }
 
   LintRuleStatus Report() const override { return LintRuleStatus(violations_); }
-
- private:
-  std::set<LintViolation> violations_;
 };
 
 std::unique_ptr<TextStructureLintRule> MakeHelloRule() {
@@ -90,5 +87,19 @@ TEST(TextStructureLinterTest, OneRuleRejectsTextStructure) {
   EXPECT_THAT(statuses[0].violations, SizeIs(1));
 }
 
+// This test verifies that rules can be run one at a time.
+TEST(TextStructureLinterTest, LintOneRule) {
+  const TextStructureView text_structure("Goodbye cruel world.\n");
+  TextStructureLinter linter;
+  linter.AddRule(MakeHelloRule());
+  linter.AddRule(MakeHelloRule());
+  ASSERT_EQ(linter.NumRules(), 2);
+  linter.LintOneRule(1, text_structure, "");
+  std::vector<LintRuleStatus> statuses = linter.ReportStatus();
+  EXPECT_THAT(statuses, SizeIs(2));
+  EXPECT_TRUE(statuses[0].isOk());
+  EXPECT_FALSE(statuses[1].isOk());
+}
+
 }  // namespace
 }  // namespace verible
@@ -27,9 +27,14 @@ void TokenStreamLinter::Lint(const TokenSequence& tokens) {
   VLOG(1) << "TokenStreamLinter analyzing tokens with " << rules_.size()
           << " rules.";
   for (const auto& token : tokens) {
-    for (const auto& rule : rules_) {
-      ABSL_DIE_IF_NULL(rule)->HandleToken(token);
-    }
+    HandleToken(token);
+  }
+}
+
+void TokenStreamLinter::HandleToken(const TokenInfo& token) {
+  for (const auto& rule : rules_) {
+    if (ABSL_DIE_IF_NULL(rule)->ReachedViolationLimit()) continue;
+    rule->HandleToken(token);
   }
 }
 
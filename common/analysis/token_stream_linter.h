@@ -25,6 +25,7 @@
 
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/token_stream_lint_rule.h"
+#include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
 
 namespace verible {
@@ -34,6 +35,10 @@ class TokenStreamLinter {
   // Analyzes a sequence of tokens.
   void Lint(const TokenSequence& tokens);
 
+  // Analyzes one token, for driving rules from a pass shared with other
+  // linters.  Tokens must be passed in stream order.
+  void HandleToken(const TokenInfo& token);
+
   // Transfers ownership of rule into this Linter
   void AddRule(std::unique_ptr<TokenStreamLintRule> rule) {
     rules_.emplace_back(std::move(rule));
@@ -0,0 +1,212 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/formatting/formatted_excerpt_cache.h"
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "common/formatting/basic_format_style.h"
+#include "common/formatting/format_token.h"
+#include "common/formatting/unwrapped_line.h"
+
+namespace verible {
+
+namespace {
+// 64-bit FNV-1a hash.  Unlike absl::Hash, its values do not change between
+// processes, which is needed for persisted keys.
+class Fnv1aHasher {
+ public:
+  void Add(absl::string_view bytes) {
+    for (const char c : bytes) {
+      value_ ^= static_cast<unsigned char>(c);
+      value_ *= 0x100000001b3ULL;
+    }
+  }
+
+  void Add(int64_t n) {
+    // Fixed-width little-endian, independent of host byte order.
+    char bytes[sizeof(n)];
+    for (size_t i = 0; i < sizeof(n); ++i) {
+      bytes[i] = static_cast<char>((static_cast<uint64_t>(n) >> (8 * i)));
+    }
+    Add(absl::string_view(bytes, sizeof(bytes)));
+  }
+
+  uint64_t Value() const { return value_; }
+
+ private:
+  uint64_t value_ = 0xcbf29ce484222325ULL;
+};
+
+// Bump this whenever the fingerprinted information or the meaning of
+// stored decisions changes, to invalidate persisted caches.
+constexpr int64_t kFingerprintVersion = 1;
+
+char DecisionChar(SpacingDecision action) {
+  switch (action) {
+    case SpacingDecision::Preserve:
+      return 'p';
+    case SpacingDecision::Append:
+      return 'a';
+    case SpacingDecision::Wrap:
+      return 'w';
+  }
+  return '?';
+}
+
+bool ParseDecisionChar(char c, SpacingDecision* action) {
+  switch (c) {
+    case 'p':
+      *action = SpacingDecision::Preserve;
+      return true;
+    case 'a':
+      *action = SpacingDecision::Append;
+      return true;
+    case 'w':
+      *action = SpacingDecision::Wrap;
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+uint64_t FormattedExcerptCache::Fingerprint(const UnwrappedLine& uwline,
+                                            const BasicFormatStyle& style) {
+  Fnv1aHasher hasher;
+  hasher.Add(kFingerprintVersion);
+  hasher.Add(style.indentation_spaces);
+  hasher.Add(style.wrap_spaces);
+  hasher.Add(style.column_limit);
+  hasher.Add(style.over_column_limit_penalty);
+  hasher.Add(uwline.IndentationSpaces());
+  hasher.Add(static_cast<int64_t>(uwline.Size()));
+  for (const auto& ftoken : uwline.TokensRange()) {
+    // Length-prefix text, so that token boundaries are unambiguous.
+    hasher.Add(static_cast<int64_t>(ftoken.Length()));
+    hasher.Add(ftoken.Text());
+    hasher.Add(ftoken.before.spaces_required);
+    hasher.Add(ftoken.before.break_penalty);
+    hasher.Add(static_cast<int64_t>(ftoken.before.break_decision));
+    hasher.Add(static_cast<int64_t>(ftoken.balancing));
+    if (ftoken.before.break_decision == SpacingOptions::Preserve) {
+      // Preserved spacing is part of the formatted result.
+      const absl::string_view spaces(ftoken.OriginalLeadingSpaces());
+      hasher.Add(static_cast<int64_t>(spaces.length()));
+      hasher.Add(spaces);
+    }
+  }
+  return hasher.Value();
+}
+
+bool FormattedExcerptCache::Lookup(uint64_t key, const UnwrappedLine& uwline,
+                                   FormattedExcerpt* excerpt) {
+  const auto found = entries_.find(key);
+  if (found == entries_.end()) return false;
+  Entry& entry = found->second;
+  // Guard against the (unlikely) fingerprint collision.
+  if (entry.indentation_spaces != uwline.IndentationSpaces() ||
+      entry.decisions.size() != uwline.Size()) {
+    return false;
+  }
+  // Start from the current tokens, which also carry the pointers to any
+  // preserved spacing in the current text.
+  FormattedExcerpt result(uwline);
+  auto decision_iter = entry.decisions.begin();
+  for (auto& ftoken : result.MutableTokens()) {
+    ftoken.before.action = decision_iter->action;
+    ftoken.before.spaces = decision_iter->spaces;
+    ++decision_iter;
+  }
+  entry.used = true;
+  *excerpt = std::move(result);
+  return true;
+}
+
+void FormattedExcerptCache::Insert(uint64_t key,
+                                   const FormattedExcerpt& excerpt) {
+  Entry& entry = entries_[key];
+  entry.indentation_spaces = excerpt.IndentationSpaces();
+  entry.decisions.clear();
+  entry.decisions.reserve(excerpt.Tokens().size());
+  for (const auto& ftoken : excerpt.Tokens()) {
+    entry.decisions.push_back({ftoken.before.action, ftoken.before.spaces});
+  }
+  entry.used = true;
+}
+
+void FormattedExcerptCache::PruneUnused() {
+  for (auto iter = entries_.begin(); iter != entries_.end();) {
+    if (iter->second.used) {
+      iter->second.used = false;
+      ++iter;
+    } else {
+      iter = entries_.erase(iter);
+    }
+  }
+}
+
+void FormattedExcerptCache::Serialize(std::ostream& stream) const {
+  for (const auto& item : entries_) {
+    stream << item.first << ' ' << item.second.indentation_spaces;
+    for (const auto& decision : item.second.decisions) {
+      stream << ' ' << DecisionChar(decision.action) << decision.spaces;
+    }
+    stream << '\n';
+  }
+}
+
+absl::Status FormattedExcerptCache::Deserialize(absl::string_view text) {
+  std::map<uint64_t, Entry> parsed;
+  int line_number = 0;
+  for (const absl::string_view line :
+       absl::StrSplit(text, '\n', absl::SkipEmpty())) {
+    ++line_number;
+    const std::vector<absl::string_view> fields =
+        absl::StrSplit(line, ' ', absl::SkipEmpty());
+    uint64_t key;
+    Entry entry;
+    if (fields.size() < 2 || !absl::SimpleAtoi(fields[0], &key) ||
+        !absl::SimpleAtoi(fields[1], &entry.indentation_spaces)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Malformed cache entry on line ", line_number));
+    }
+    for (auto iter = fields.begin() + 2; iter != fields.end(); ++iter) {
+      Decision decision;
+      if (!ParseDecisionChar(iter->front(), &decision.action) ||
+          !absl::SimpleAtoi(iter->substr(1), &decision.spaces) ||
+          decision.spaces < 0) {
+        return absl::InvalidArgumentError(absl::StrCat(
+            "Malformed decision \"", *iter, "\" on line ", line_number));
+      }
+      entry.decisions.push_back(decision);
+    }
+    parsed[key] = std::move(entry);
+  }
+  for (auto& item : parsed) {
+    entries_[item.first] = std::move(item.second);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace verible
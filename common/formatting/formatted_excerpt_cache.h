@@ -0,0 +1,96 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_FORMATTING_FORMATTED_EXCERPT_CACHE_H_
+#define VERIBLE_COMMON_FORMATTING_FORMATTED_EXCERPT_CACHE_H_
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "common/formatting/basic_format_style.h"
+#include "common/formatting/format_token.h"
+#include "common/formatting/unwrapped_line.h"
+
+namespace verible {
+
+// FormattedExcerptCache remembers the line-wrapping decisions of previously
+// formatted UnwrappedLines, so that re-formatting text in which only some
+// partitions changed can skip searching the unchanged ones.
+//
+// Entries are keyed by Fingerprint(), which covers everything that line wrap
+// searching depends on: token text, inter-token annotations, indentation,
+// and style.  It does not depend on a partition's position in the text, so
+// the identity of a partition is stable across edits elsewhere in a file.
+//
+// Only decisions are stored, not tokens, so a cached result is re-bound to
+// the tokens of the UnwrappedLine at hand.
+class FormattedExcerptCache {
+ public:
+  // Returns a content-based key for formatting 'uwline' with 'style'.
+  // This is stable across processes, so it can be persisted.
+  static uint64_t Fingerprint(const UnwrappedLine& uwline,
+                              const BasicFormatStyle& style);
+
+  // Returns the number of entries.
+  size_t Size() const { return entries_.size(); }
+
+  // If there is an entry for 'key' that fits 'uwline', rebuilds its
+  // formatting of 'uwline' into 'excerpt', and returns true.
+  // Otherwise, leaves 'excerpt' untouched and returns false.
+  bool Lookup(uint64_t key, const UnwrappedLine& uwline,
+              FormattedExcerpt* excerpt);
+
+  // Stores the formatting decisions of 'excerpt' under 'key'.
+  // Only completely formatted excerpts should be inserted.
+  void Insert(uint64_t key, const FormattedExcerpt& excerpt);
+
+  // Removes entries that were neither looked up successfully nor inserted
+  // since the last call to this (or since construction or Deserialize()).
+  // This keeps a persisted cache from growing with stale partitions.
+  void PruneUnused();
+
+  // Writes all entries in a line-oriented text format, one entry per line:
+  //   <key> <indentation> <decision>...
+  // where each token's <decision> is one of 'p' (preserve), 'a' (append),
+  // 'w' (wrap) followed by the number of spaces, e.g. "a1".
+  void Serialize(std::ostream&) const;
+
+  // Adds the entries from text written by Serialize().
+  // Returns an error (and adds nothing) if 'text' is malformed.
+  absl::Status Deserialize(absl::string_view text);
+
+ private:
+  struct Decision {
+    SpacingDecision action;
+    int spaces;
+  };
+
+  struct Entry {
+    int indentation_spaces = 0;
+    std::vector<Decision> decisions;
+    // True if this entry was used since the last PruneUnused().
+    bool used = false;
+  };
+
+  // Ordered, so that serialization is deterministic.
+  std::map<uint64_t, Entry> entries_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_FORMATTING_FORMATTED_EXCERPT_CACHE_H_
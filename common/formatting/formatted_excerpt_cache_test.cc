@@ -0,0 +1,207 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/formatting/formatted_excerpt_cache.h"
+
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/formatting/basic_format_style.h"
+#include "common/formatting/format_token.h"
+#include "common/formatting/line_wrap_searcher.h"
+#include "common/formatting/unwrapped_line.h"
+#include "common/formatting/unwrapped_line_test_utils.h"
+
+namespace verible {
+namespace {
+
+// Each instance owns the tokens of one UnwrappedLine.
+class CachedLine : public UnwrappedLineMemoryHandler {
+ public:
+  CachedLine(const std::vector<TokenInfo>& tokens, int indentation) {
+    CreateTokenInfos(tokens);
+    uwline_ = UnwrappedLine(indentation, pre_format_tokens_.begin());
+    AddFormatTokens(&uwline_);
+    for (auto& ftoken : pre_format_tokens_) {
+      ftoken.before.spaces_required = 1;
+      ftoken.before.break_penalty = 2;
+    }
+  }
+
+  const UnwrappedLine& Line() const { return uwline_; }
+
+  PreFormatToken& Token(size_t index) { return pre_format_tokens_[index]; }
+
+ private:
+  UnwrappedLine uwline_;
+};
+
+class FormattedExcerptCacheTest : public ::testing::Test {
+ public:
+  FormattedExcerptCacheTest() { style_.column_limit = 12; }
+
+  FormattedExcerpt Search(const UnwrappedLine& uwline) const {
+    return SearchLineWraps(uwline, style_, 1000).front();
+  }
+
+ protected:
+  BasicFormatStyle style_;
+  const std::vector<TokenInfo> tokens_{
+      {0, "aaaa"}, {0, "bbbb"}, {0, "cccc"}, {0, "dddd"}};
+};
+
+TEST_F(FormattedExcerptCacheTest, FingerprintIsContentBased) {
+  const CachedLine line1(tokens_, 2);
+  const CachedLine line2(tokens_, 2);
+  // Same content in different buffers.
+  EXPECT_EQ(FormattedExcerptCache::Fingerprint(line1.Line(), style_),
+            FormattedExcerptCache::Fingerprint(line2.Line(), style_));
+}
+
+TEST_F(FormattedExcerptCacheTest, FingerprintDependsOnIndentation) {
+  const CachedLine line1(tokens_, 2);
+  const CachedLine line2(tokens_, 4);
+  EXPECT_NE(FormattedExcerptCache::Fingerprint(line1.Line(), style_),
+            FormattedExcerptCache::Fingerprint(line2.Line(), style_));
+}
+
+TEST_F(FormattedExcerptCacheTest, FingerprintDependsOnText) {
+  const CachedLine line1(tokens_, 2);
+  const CachedLine line2({{0, "aaaa"}, {0, "bbbb"}, {0, "cccc"}, {0, "ddd"}},
+                         2);
+  EXPECT_NE(FormattedExcerptCache::Fingerprint(line1.Line(), style_),
+            FormattedExcerptCache::Fingerprint(line2.Line(), style_));
+}
+
+TEST_F(FormattedExcerptCacheTest, FingerprintDependsOnAnnotations) {
+  const CachedLine line1(tokens_, 2);
+  CachedLine line2(tokens_, 2);
+  line2.Token(2).before.break_decision = SpacingOptions::MustWrap;
+  EXPECT_NE(FormattedExcerptCache::Fingerprint(line1.Line(), style_),
+            FormattedExcerptCache::Fingerprint(line2.Line(), style_));
+}
+
+TEST_F(FormattedExcerptCacheTest, FingerprintDependsOnStyle) {
+  const CachedLine line(tokens_, 2);
+  BasicFormatStyle other_style(style_);
+  other_style.column_limit = 40;
+  EXPECT_NE(FormattedExcerptCache::Fingerprint(line.Line(), style_),
+            FormattedExcerptCache::Fingerprint(line.Line(), other_style));
+}
+
+TEST_F(FormattedExcerptCacheTest, LookupMiss) {
+  const CachedLine line(tokens_, 2);
+  FormattedExcerptCache cache;
+  FormattedExcerpt excerpt;
+  EXPECT_FALSE(cache.Lookup(FormattedExcerptCache::Fingerprint(line.Line(),
+                                                               style_),
+                            line.Line(), &excerpt));
+  EXPECT_TRUE(excerpt.Tokens().empty());
+}
+
+TEST_F(FormattedExcerptCacheTest, LookupRebindsToOtherTokens) {
+  const CachedLine line1(tokens_, 2);
+  const CachedLine line2(tokens_, 2);
+  const auto key = FormattedExcerptCache::Fingerprint(line1.Line(), style_);
+  const FormattedExcerpt expected(Search(line1.Line()));
+  FormattedExcerptCache cache;
+  cache.Insert(key, expected);
+  EXPECT_EQ(cache.Size(), 1);
+
+  FormattedExcerpt excerpt;
+  ASSERT_TRUE(cache.Lookup(key, line2.Line(), &excerpt));
+  EXPECT_EQ(excerpt.Render(), expected.Render());
+  // The result refers to line2's tokens.
+  ASSERT_EQ(excerpt.Tokens().size(), line2.Line().Size());
+  EXPECT_EQ(excerpt.Tokens().front().token,
+            line2.Line().TokensRange().front().token);
+  EXPECT_TRUE(excerpt.CompletedFormatting());
+}
+
+TEST_F(FormattedExcerptCacheTest, LookupRejectsMismatchedSize) {
+  const CachedLine line1(tokens_, 2);
+  const CachedLine line2({{0, "aaaa"}}, 2);
+  const auto key = FormattedExcerptCache::Fingerprint(line1.Line(), style_);
+  FormattedExcerptCache cache;
+  cache.Insert(key, Search(line1.Line()));
+  FormattedExcerpt excerpt;
+  EXPECT_FALSE(cache.Lookup(key, line2.Line(), &excerpt));
+}
+
+TEST_F(FormattedExcerptCacheTest, PruneUnused) {
+  const CachedLine line1(tokens_, 2);
+  const CachedLine line2(tokens_, 4);
+  const auto key1 = FormattedExcerptCache::Fingerprint(line1.Line(), style_);
+  const auto key2 = FormattedExcerptCache::Fingerprint(line2.Line(), style_);
+  FormattedExcerptCache cache;
+  cache.Insert(key1, Search(line1.Line()));
+  cache.Insert(key2, Search(line2.Line()));
+  cache.PruneUnused();  // Both were just inserted.
+  EXPECT_EQ(cache.Size(), 2);
+
+  FormattedExcerpt excerpt;
+  EXPECT_TRUE(cache.Lookup(key2, line2.Line(), &excerpt));
+  cache.PruneUnused();
+  EXPECT_EQ(cache.Size(), 1);
+  EXPECT_FALSE(cache.Lookup(key1, line1.Line(), &excerpt));
+  EXPECT_TRUE(cache.Lookup(key2, line2.Line(), &excerpt));
+}
+
+TEST_F(FormattedExcerptCacheTest, SerializeRoundTrip) {
+  const CachedLine line(tokens_, 2);
+  const auto key = FormattedExcerptCache::Fingerprint(line.Line(), style_);
+  const FormattedExcerpt expected(Search(line.Line()));
+  FormattedExcerptCache cache;
+  cache.Insert(key, expected);
+
+  std::ostringstream stream;
+  cache.Serialize(stream);
+  FormattedExcerptCache restored;
+  ASSERT_TRUE(restored.Deserialize(stream.str()).ok());
+  EXPECT_EQ(restored.Size(), 1);
+
+  FormattedExcerpt excerpt;
+  ASSERT_TRUE(restored.Lookup(key, line.Line(), &excerpt));
+  EXPECT_EQ(excerpt.Render(), expected.Render());
+
+  std::ostringstream restream;
+  restored.Serialize(restream);
+  EXPECT_EQ(restream.str(), stream.str());
+}
+
+TEST_F(FormattedExcerptCacheTest, DeserializeEmpty) {
+  FormattedExcerptCache cache;
+  EXPECT_TRUE(cache.Deserialize("").ok());
+  EXPECT_EQ(cache.Size(), 0);
+}
+
+TEST_F(FormattedExcerptCacheTest, DeserializeMalformed) {
+  const char* kBadInputs[] = {
+      "123\n",            // missing indentation
+      "x 2 a1\n",         // bad key
+      "123 2 a1 q4\n",    // bad decision
+      "123 2 a1 w\n",     // missing spaces
+      "123 2 a-1\n",      // negative spaces
+      "1 0\n123 2 b1\n",  // error on later line
+  };
+  for (const auto* input : kBadInputs) {
+    FormattedExcerptCache cache;
+    EXPECT_FALSE(cache.Deserialize(input).ok()) << input;
+    EXPECT_EQ(cache.Size(), 0) << input;
+  }
+}
+
+}  // namespace
+}  // namespace verible
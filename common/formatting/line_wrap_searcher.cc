@@ -14,11 +14,15 @@
 
 #include "common/formatting/line_wrap_searcher.h"
 
+#include <algorithm>
+#include <iostream>
 #include <memory>
 #include <queue>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "common/formatting/basic_format_style.h"
 #include "common/formatting/format_token.h"
 #include "common/formatting/state_node.h"
@@ -42,20 +46,115 @@ struct SearchState {
   // Inverted to min-heap: *lowest* penalty has the highest search priority.
   bool operator<(const SearchState& r) const { return *r.state < *state; }
 };
+
+// Considers the new penalties incurred for the next decision after 'state':
+// break, or no break.  Appends one or both resulting states to 'successors'.
+void ExpandState(const std::shared_ptr<const StateNode>& state,
+                 const BasicFormatStyle& style,
+                 std::vector<std::shared_ptr<const StateNode>>* successors) {
+  const auto& token = state->GetNextToken();
+  if (token.before.break_decision == SpacingOptions::Preserve) {
+    VLOG(4) << "preserving spaces before \'" << token.token->text << '\'';
+    successors->push_back(
+        std::make_shared<StateNode>(state, style, SpacingDecision::Preserve));
+  } else {
+    // Remaining options are: Undecided, MustWrap, MustAppend
+    // Explore one or both: SpacingDecision::Wrap/Append
+    if (token.before.break_decision != SpacingOptions::MustWrap) {
+      VLOG(4) << "considering appending \'" << token.token->text << '\'';
+      // Consider cost of appending token to current line.
+      successors->push_back(
+          std::make_shared<StateNode>(state, style, SpacingDecision::Append));
+      VLOG(4) << "  cost: " << successors->back()->cumulative_cost;
+      VLOG(4) << "  column: " << successors->back()->current_column;
+    }
+    if (token.before.break_decision != SpacingOptions::MustAppend) {
+      VLOG(4) << "considering wrapping \'" << token.token->text << '\'';
+      // Consider cost of line wrapping here.
+      successors->push_back(
+          std::make_shared<StateNode>(state, style, SpacingDecision::Wrap));
+      VLOG(4) << "  cost: " << successors->back()->cumulative_cost;
+      VLOG(4) << "  column: " << successors->back()->current_column;
+    }
+  }
+}
+
+bool StatePtrLess(const std::shared_ptr<const StateNode>& left,
+                  const std::shared_ptr<const StateNode>& right) {
+  return *left < *right;
+}
+
+// Searches decisions one token at a time, keeping only the beam_width
+// lowest-cost states after each token.  Every state in the beam has decided
+// the same number of tokens, so they all finish together.
+// Returns the lowest-cost finished state.  If the deadline passes first,
+// greedily finishes the best state in the beam, and sets *timed_out.
+std::shared_ptr<const StateNode> BeamSearchLineWraps(
+    const UnwrappedLine& uwline, const BasicFormatStyle& style,
+    size_t beam_width, absl::Time deadline, LineWrapSearchStats* stats,
+    bool* timed_out) {
+  std::vector<std::shared_ptr<const StateNode>> beam{
+      std::make_shared<StateNode>(uwline, style)};
+  std::vector<std::shared_ptr<const StateNode>> successors;
+  while (!beam.front()->Done()) {
+    if (absl::Now() > deadline) {
+      *timed_out = true;
+      return StateNode::QuickFinish(beam.front(), style);
+    }
+    successors.clear();
+    for (const auto& state : beam) {
+      ++stats->states_expanded;
+      ExpandState(state, style, &successors);
+    }
+    stats->peak_frontier_size =
+        std::max(stats->peak_frontier_size, successors.size());
+    const size_t kept = std::min(beam_width, successors.size());
+    std::partial_sort(successors.begin(), successors.begin() + kept,
+                      successors.end(), StatePtrLess);
+    successors.resize(kept);
+    beam.swap(successors);
+  }
+  return beam.front();
+}
 }  // namespace
 
+std::ostream& operator<<(std::ostream& stream,
+                         const LineWrapSearchStats& stats) {
+  stream << "states expanded: " << stats.states_expanded
+         << ", peak frontier size: " << stats.peak_frontier_size;
+  if (stats.used_beam_search) stream << ", used beam search";
+  if (stats.finished_greedily) stream << ", finished greedily";
+  return stream;
+}
+
 std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
                                               const BasicFormatStyle& style,
                                               int max_search_states) {
+  LineWrapSearchOptions options;
+  options.max_search_states = max_search_states;
+  return SearchLineWraps(uwline, style, options);
+}
+
+std::vector<FormattedExcerpt> SearchLineWraps(
+    const UnwrappedLine& uwline, const BasicFormatStyle& style,
+    const LineWrapSearchOptions& options, LineWrapSearchStats* stats) {
   // Dijkstra's algorithm for now: prioritize searching minimum penalty path
   // until destination is reached.
 
   VLOG(2) << "SearchLineWraps on: " << uwline;
+  LineWrapSearchStats local_stats;
+  if (stats == nullptr) stats = &local_stats;
+  *stats = LineWrapSearchStats();
   if (uwline.TokensRange().empty()) {
     std::vector<FormattedExcerpt> result(1);
     return result;
   }
 
+  const bool time_limited = options.max_search_time != absl::InfiniteDuration();
+  const absl::Time deadline =
+      time_limited ? absl::Now() + options.max_search_time
+                   : absl::InfiniteFuture();
+
   // Worklist for decision searching, ordered by cumulative penalty.
   // Note: a heap-based priority-queue will not guarantee stable ordering
   // among equal-valued keys.  If first-come-first-serve tie-breaking is
@@ -68,6 +167,7 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
 
   bool aborted_search = false;
   std::vector<std::shared_ptr<const StateNode>> winning_paths;
+  std::vector<std::shared_ptr<const StateNode>> successors;
   int state_count = 0;
   while (!worklist.empty()) {
     ++state_count;
@@ -101,45 +201,35 @@ std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
       continue;
     }
 
-    if (state_count >= max_search_states) {
+    const bool timed_out = time_limited && absl::Now() > deadline;
+    if (state_count >= options.max_search_states || timed_out) {
       // Search limit exceeded, abandon search.
-      // Greedily finish formatting this partition, and return it.
-      winning_paths.push_back(StateNode::QuickFinish(next.state, style));
       aborted_search = true;
+      if (options.beam_width > 0 && !timed_out) {
+        // Settle for a near-optimal result.
+        stats->used_beam_search = true;
+        bool beam_timed_out = false;
+        winning_paths.push_back(
+            BeamSearchLineWraps(uwline, style, options.beam_width, deadline,
+                                stats, &beam_timed_out));
+        stats->finished_greedily = beam_timed_out;
+      } else {
+        // Greedily finish formatting this partition, and return it.
+        winning_paths.push_back(StateNode::QuickFinish(next.state, style));
+        stats->finished_greedily = true;
+      }
       break;
     }
 
-    // Consider the new penalties incurred for the next decision:
-    // break, or no break.  Calculate new penalties.
     // Push one or both branches into the worklist.
-    const auto& token = next.state->GetNextToken();
-    if (token.before.break_decision == SpacingOptions::Preserve) {
-      VLOG(4) << "preserving spaces before \'" << token.token->text << '\'';
-      SearchState preserved(std::make_shared<StateNode>(
-          next.state, style, SpacingDecision::Preserve));
-      worklist.push(preserved);
-    } else {
-      // Remaining options are: Undecided, MustWrap, MustAppend
-      // Explore one or both: SpacingDecision::Wrap/Append
-      if (token.before.break_decision != SpacingOptions::MustWrap) {
-        VLOG(4) << "considering appending \'" << token.token->text << '\'';
-        // Consider cost of appending token to current line.
-        SearchState appended(std::make_shared<StateNode>(
-            next.state, style, SpacingDecision::Append));
-        worklist.push(appended);
-        VLOG(4) << "  cost: " << appended.state->cumulative_cost;
-        VLOG(4) << "  column: " << appended.state->current_column;
-      }
-      if (token.before.break_decision != SpacingOptions::MustAppend) {
-        VLOG(4) << "considering wrapping \'" << token.token->text << '\'';
-        // Consider cost of line wrapping here.
-        SearchState wrapped(std::make_shared<StateNode>(next.state, style,
-                                                        SpacingDecision::Wrap));
-        worklist.push(wrapped);
-        VLOG(4) << "  cost: " << wrapped.state->cumulative_cost;
-        VLOG(4) << "  column: " << wrapped.state->current_column;
-      }
+    ++stats->states_expanded;
+    successors.clear();
+    ExpandState(next.state, style, &successors);
+    for (const auto& successor : successors) {
+      worklist.push(SearchState(successor));
     }
+    stats->peak_frontier_size =
+        std::max(stats->peak_frontier_size, worklist.size());
 
     // TODO(fangism): Use an admissibility heuristic to prune search space from
     // paths whose best-case outcome is worse than a conservatively achievable
@@ -15,24 +15,67 @@
 #ifndef VERIBLE_COMMON_FORMATTING_LINE_WRAP_SEARCHER_H_
 #define VERIBLE_COMMON_FORMATTING_LINE_WRAP_SEARCHER_H_
 
+#include <cstddef>
 #include <iosfwd>
 #include <vector>
 
+#include "absl/time/time.h"
 #include "common/formatting/basic_format_style.h"
 #include "common/formatting/unwrapped_line.h"
 
 namespace verible {
 
+// Limits on the effort that SearchLineWraps spends on one UnwrappedLine.
+struct LineWrapSearchOptions {
+  // Limits the number of states explored by the optimal search.
+  int max_search_states = 10000;
+
+  // If positive, once max_search_states is exceeded, search again keeping
+  // only this many lowest-cost partial solutions per token (beam search).
+  // This costs time proportional to beam_width times the number of tokens,
+  // and usually finds near-optimal results.
+  // Otherwise, the best partial solution is finished greedily.
+  int beam_width = 0;
+
+  // Limits the time spent on one UnwrappedLine, including any beam search.
+  // Once exceeded, the best partial solution is finished greedily.
+  absl::Duration max_search_time = absl::InfiniteDuration();
+};
+
+// Effort spent by SearchLineWraps on one UnwrappedLine, for diagnostics.
+struct LineWrapSearchStats {
+  // Number of search states that were expanded by their next decision.
+  int states_expanded = 0;
+
+  // Largest number of states waiting to be expanded at any one time.
+  size_t peak_frontier_size = 0;
+
+  // True if the optimal search was abandoned for a beam search.
+  bool used_beam_search = false;
+
+  // True if the search ran out of budget and the result was finished
+  // greedily.
+  bool finished_greedily = false;
+};
+
+std::ostream& operator<<(std::ostream&, const LineWrapSearchStats&);
+
 // SearchLineWraps takes an UnwrappedLine with formatting annotations,
 // and a style structure, and returns equally-good FormattedExcerpts with
 // formatting decisions (wraps, spaces) committed.
 // This minimizes the numeric penalty during search to yield optimal results,
 // which can result in multiple optimal formattings.
-// max_search_states limits the size of the optimization search.
-// When the number of states evaluated exceeds this, this will abort by
-// returning a greedily formatted result (which can still be rendered)
+// 'options' limits the size of the optimization search.
+// When the search exceeds its limits, this will abort by returning a
+// beam-searched or greedily formatted result (which can still be rendered)
 // that will be marked as !CompletedFormatting().
+// If 'stats' is not null, it receives the search effort.
 // This is guaranteed to return at least one result.
+std::vector<FormattedExcerpt> SearchLineWraps(
+    const UnwrappedLine& uwline, const BasicFormatStyle& style,
+    const LineWrapSearchOptions& options, LineWrapSearchStats* stats = nullptr);
+
+// Same as above, limiting only the number of search states.
 std::vector<FormattedExcerpt> SearchLineWraps(const UnwrappedLine& uwline,
                                               const BasicFormatStyle& style,
                                               int max_search_states);
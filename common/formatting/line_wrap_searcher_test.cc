@@ -14,11 +14,13 @@
 
 #include "common/formatting/line_wrap_searcher.h"
 
+#include <sstream>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/match.h"
+#include "absl/time/time.h"
 #include "common/formatting/basic_format_style.h"
 #include "common/formatting/format_token.h"
 #include "common/formatting/unwrapped_line.h"
@@ -425,5 +427,116 @@ TEST_F(SearchLineWrapsTestFixture, AbortedSearch) {
   // So we don't check any other properties of the formatted_line.
 }
 
+// This fixture provides a line of tokens with many wrapping choices.
+class SearchLineWrapsBudgetTest : public SearchLineWrapsTestFixture {
+ public:
+  SearchLineWrapsBudgetTest() {
+    CreateTokenInfos(tokens_);
+    uwline_ = UnwrappedLine(LevelsToSpaces(1), pre_format_tokens_.begin());
+    AddFormatTokens(&uwline_);
+    int penalty = 1;
+    for (auto& ftoken : pre_format_tokens_) {
+      ftoken.before.spaces_required = 1;
+      // Vary penalties to avoid ties.
+      ftoken.before.break_penalty = penalty;
+      penalty = (penalty * 7) % 11 + 1;
+    }
+  }
+
+ protected:
+  const std::vector<TokenInfo> tokens_ = {
+      {0, "aaa"}, {0, "bb"},  {0, "ccccc"}, {0, "d"}, {0, "eeee"},
+      {0, "ff"},  {0, "ggg"}, {0, "hhhhh"}, {0, "i"}, {0, "jjjjjj"},
+  };
+  UnwrappedLine uwline_;
+};
+
+TEST_F(SearchLineWrapsBudgetTest, StatsOfCompleteSearch) {
+  LineWrapSearchOptions options;
+  options.max_search_states = 100000;
+  LineWrapSearchStats stats;
+  const auto results =
+      verible::SearchLineWraps(uwline_, style_, options, &stats);
+  ASSERT_FALSE(results.empty());
+  EXPECT_TRUE(results.front().CompletedFormatting());
+  EXPECT_GT(stats.states_expanded, 0);
+  EXPECT_GT(stats.peak_frontier_size, 0);
+  EXPECT_FALSE(stats.used_beam_search);
+  EXPECT_FALSE(stats.finished_greedily);
+}
+
+TEST_F(SearchLineWrapsBudgetTest, StatsOfAbortedSearch) {
+  LineWrapSearchOptions options;
+  options.max_search_states = 2;
+  LineWrapSearchStats stats;
+  const auto results =
+      verible::SearchLineWraps(uwline_, style_, options, &stats);
+  ASSERT_FALSE(results.empty());
+  EXPECT_FALSE(results.front().CompletedFormatting());
+  EXPECT_EQ(results.front().Tokens().size(), tokens_.size());
+  EXPECT_EQ(stats.states_expanded, 1);
+  EXPECT_FALSE(stats.used_beam_search);
+  EXPECT_TRUE(stats.finished_greedily);
+}
+
+TEST_F(SearchLineWrapsBudgetTest, WideBeamSearchIsOptimal) {
+  const FormattedExcerpt expected = SearchLineWraps(uwline_, style_);
+  LineWrapSearchOptions options;
+  options.max_search_states = 2;
+  // At least 2^(number of tokens - 1) keeps every state.
+  options.beam_width = 1 << tokens_.size();
+  LineWrapSearchStats stats;
+  const auto results =
+      verible::SearchLineWraps(uwline_, style_, options, &stats);
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results.front().Render(), expected.Render());
+  // The result is not proven optimal.
+  EXPECT_FALSE(results.front().CompletedFormatting());
+  EXPECT_TRUE(stats.used_beam_search);
+  EXPECT_FALSE(stats.finished_greedily);
+}
+
+TEST_F(SearchLineWrapsBudgetTest, NarrowBeamSearchFinishes) {
+  LineWrapSearchOptions options;
+  options.max_search_states = 2;
+  options.beam_width = 1;
+  LineWrapSearchStats stats;
+  const auto results =
+      verible::SearchLineWraps(uwline_, style_, options, &stats);
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results.front().Tokens().size(), tokens_.size());
+  EXPECT_TRUE(stats.used_beam_search);
+  EXPECT_FALSE(stats.finished_greedily);
+  // One expansion before giving up on the optimal search, then one per
+  // remaining token.
+  EXPECT_EQ(stats.states_expanded, tokens_.size());
+  EXPECT_EQ(stats.peak_frontier_size, 2);
+}
+
+TEST_F(SearchLineWrapsBudgetTest, TimeLimitFinishesGreedily) {
+  LineWrapSearchOptions options;
+  options.beam_width = 4;
+  options.max_search_time = absl::Seconds(-1);  // already expired
+  LineWrapSearchStats stats;
+  const auto results =
+      verible::SearchLineWraps(uwline_, style_, options, &stats);
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_FALSE(results.front().CompletedFormatting());
+  EXPECT_EQ(results.front().Tokens().size(), tokens_.size());
+  EXPECT_FALSE(stats.used_beam_search);
+  EXPECT_TRUE(stats.finished_greedily);
+}
+
+TEST(LineWrapSearchStatsTest, Print) {
+  LineWrapSearchStats stats;
+  stats.states_expanded = 12;
+  stats.peak_frontier_size = 5;
+  stats.used_beam_search = true;
+  std::ostringstream stream;
+  stream << stats;
+  EXPECT_EQ(stream.str(),
+            "states expanded: 12, peak frontier size: 5, used beam search");
+}
+
 }  // namespace
 }  // namespace verible
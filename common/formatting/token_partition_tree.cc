@@ -226,10 +226,13 @@ TokenPartitionTree* MergeLeafIntoPreviousLeaf(TokenPartitionTree* leaf) {
     VLOG(4) << "common ancestor (after merging leaf):\n" << common_ancestor;
   }
 
-  // Sanity check invariants.
+#ifndef NDEBUG
+  // Sanity check invariants.  This is linear in the size of common_ancestor,
+  // which could be the whole tree, so only do this in debug builds.
   VerifyFullTreeFormatTokenRanges(
       common_ancestor,
       common_ancestor.LeftmostDescendant()->Value().TokensRange().begin());
+#endif
 
   return leaf_parent;
 }
@@ -271,10 +274,13 @@ TokenPartitionTree* MergeLeafIntoNextLeaf(TokenPartitionTree* leaf) {
     VLOG(4) << "common ancestor (after destroying leaf):\n" << common_ancestor;
   }
 
-  // Sanity check invariants.
+#ifndef NDEBUG
+  // Sanity check invariants.  This is linear in the size of common_ancestor,
+  // which could be the whole tree, so only do this in debug builds.
   VerifyFullTreeFormatTokenRanges(
       common_ancestor,
       common_ancestor.LeftmostDescendant()->Value().TokensRange().begin());
+#endif
 
   return leaf_parent;
 }
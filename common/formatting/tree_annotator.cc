@@ -14,16 +14,59 @@
 
 #include "common/formatting/tree_annotator.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
 #include <vector>
 
 #include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/symbol.h"
 #include "common/text/token_stream_view.h"
 #include "common/text/tree_context_visitor.h"
+#include "common/text/tree_utils.h"
+#include "common/util/parallel_for.h"
 
 namespace verible {
 
 namespace {  // implementation detail
 
+// SavedContext is a SyntaxTreeContext that can be updated to match another
+// context by replacing only the part of the stack that differs.
+class SavedContext : public SyntaxTreeContext {
+ public:
+  // Makes this a copy of 'context', given that the first 'common_depth'
+  // elements of both are already the same.
+  // This costs time proportional to the number of elements that differ.
+  void UpdateFrom(const SyntaxTreeContext& context, size_t common_depth) {
+    while (size() > common_depth) Pop();
+    for (auto iter = context.begin() + size(); iter != context.end(); ++iter) {
+      Push(*iter);
+    }
+  }
+};
+
+// RootSlice restricts a TreeAnnotator to a range of top-level items
+// (children of the syntax tree root), so that slices can be annotated
+// independently.
+struct RootSlice {
+  // Range of children of the root to traverse.
+  size_t first_child = 0;
+  size_t end_child = 0;
+
+  // If not null, the slice ends at the leftmost leaf of this item, which
+  // the next slice starts from.  Otherwise, the slice continues up to EOF.
+  const Symbol* next_item = nullptr;
+
+  // If true, leave the first pair of tokens unannotated.
+  bool skip_first_pair = false;
+
+  // If true, stop as soon as annotating a token (other than the first one)
+  // leaves its annotation unchanged.
+  bool stop_when_unchanged = false;
+};
+
 // TreeAnnotator traverses a syntax tree and filtered token stream view,
 // using the syntax tree to maintain context.
 // TODO(fangism): The class bears some semblance to TreeUnwrapper in its
@@ -34,21 +77,40 @@ class TreeAnnotator : public TreeContextVisitor {
   TreeAnnotator(const Symbol* syntax_tree_root, const TokenInfo& eof_token,
                 std::vector<PreFormatToken>::iterator tokens_begin,
                 std::vector<PreFormatToken>::iterator tokens_end,
-                const ContextTokenAnnotatorFunction& annotator)
+                const ContextTokenAnnotatorWithCommonDepthFunction& annotator,
+                const RootSlice* slice = nullptr)
       : eof_token_(eof_token),
         syntax_tree_root_(syntax_tree_root),
         token_annotator_(annotator),
         next_filtered_token_(tokens_begin),
-        end_filtered_token_(tokens_end) {}
+        end_filtered_token_(tokens_end),
+        slice_(slice) {}
 
   void Annotate();
 
- private:                           // methods
-  using TreeContextVisitor::Visit;  // for SyntaxTreeNode
+ private:  // methods
+  void Visit(const SyntaxTreeNode& node) override {
+    if (done_) return;
+    // Popping ancestors since the last leaf is always followed by either
+    // visiting a later node (here) or the next leaf, so checking the depth
+    // in both places finds the shallowest one reached in between.
+    common_depth_ = std::min(common_depth_, Context().size());
+    if (slice_ != nullptr && &node == syntax_tree_root_) {
+      VisitRootSlice(node);
+      return;
+    }
+    TreeContextVisitor::Visit(node);
+  }
   void Visit(const SyntaxTreeLeaf& leaf) override {
+    if (done_) return;
     CatchUpToCurrentLeaf(leaf.get());
+    // Reaching the first leaf of the next slice ends this one.
+    if (visiting_next_item_) done_ = true;
   }
 
+  // Visits only the root's children in slice_.
+  void VisitRootSlice(const SyntaxTreeNode& root);
+
   void CatchUpToCurrentLeaf(const TokenInfo& leaf_token);
 
   // TODO(fangism): This exists solely to facilitate CatchUpToCurrentLeaf().
@@ -66,7 +128,7 @@ class TreeAnnotator : public TreeContextVisitor {
   const Symbol* syntax_tree_root_ = nullptr;
 
   // Function used to annotate the PreFormatTokens.
-  ContextTokenAnnotatorFunction token_annotator_;
+  ContextTokenAnnotatorWithCommonDepthFunction token_annotator_;
 
   // Pointer to last token that was visited.
   // This gets passed to the first parameter (left token) of the
@@ -77,9 +139,39 @@ class TreeAnnotator : public TreeContextVisitor {
 
   // Copy of current_context_ that is saved for use as a left-token's context
   // passed into the token_annotator_ function.
-  SyntaxTreeContext saved_left_context_;
+  // It is updated incrementally, only where it differs from current_context_.
+  SavedContext saved_left_context_;
+
+  // Number of ancestors that saved_left_context_ shares with current_context_.
+  // This is the minimum depth that current_context_ reached since the last
+  // leaf was visited.
+  size_t common_depth_ = 0;
+
+  // If not null, only annotate this slice of the tree.
+  const RootSlice* slice_;
+
+  // True while visiting slice_->next_item.
+  bool visiting_next_item_ = false;
+
+  // True until the first pair of tokens is annotated.
+  bool at_first_pair_ = true;
+
+  // Set when the traversal should stop.
+  bool done_ = false;
 };
 
+void TreeAnnotator::VisitRootSlice(const SyntaxTreeNode& root) {
+  const SyntaxTreeContext::AutoPop p(&current_context_, &root);
+  const auto& children = root.children();
+  for (size_t i = slice_->first_child; i < slice_->end_child; ++i) {
+    if (children[i]) children[i]->Accept(this);
+  }
+  if (slice_->next_item != nullptr) {
+    visiting_next_item_ = true;
+    slice_->next_item->Accept(this);
+  }
+}
+
 void TreeAnnotator::Annotate() {
   if (next_filtered_token_ == end_filtered_token_) return;
 
@@ -94,7 +186,9 @@ void TreeAnnotator::Annotate() {
 
   // Visit the tokens between the last syntax tree node and EOF.
   // For example, there could be comments.
-  CatchUpToCurrentLeaf(EOFToken());
+  if (!done_ && (slice_ == nullptr || slice_->next_item == nullptr)) {
+    CatchUpToCurrentLeaf(EOFToken());
+  }
 }
 
 void TreeAnnotator::CatchUpToCurrentLeaf(const TokenInfo& leaf_token) {
@@ -103,21 +197,33 @@ void TreeAnnotator::CatchUpToCurrentLeaf(const TokenInfo& leaf_token) {
   // so we need to compare a unique property instead of address.
   // The very last token (before end_filtered_token) is an EOF token,
   // which doesn't need to be annotated.
-  // TODO(fangism): efficiently compute greatest-common-ancestor between
-  // left- and right- context.  Ideally this should be memo-ized as the
-  // traversal occurs, to avoid any unnecessary (linear) searches.
+  common_depth_ = std::min(common_depth_, Context().size());
   while (std::distance(next_filtered_token_, end_filtered_token_) > 1 &&
          // compare const char* addresses:
          next_filtered_token_->token->text.begin() != leaf_token.text.begin()) {
     const auto& left_token = *next_filtered_token_;
     ++next_filtered_token_;
     auto& right_token = *next_filtered_token_;
-    token_annotator_(left_token, &right_token, saved_left_context_, Context());
+    const bool first_pair = at_first_pair_;
+    at_first_pair_ = false;
+    if (slice_ == nullptr) {
+      token_annotator_(left_token, &right_token, saved_left_context_,
+                       Context(), common_depth_);
+      continue;
+    }
+    if (first_pair && slice_->skip_first_pair) continue;
+    const InterTokenInfo previous_annotation(right_token.before);
+    token_annotator_(left_token, &right_token, saved_left_context_, Context(),
+                     common_depth_);
+    if (!first_pair && slice_->stop_when_unchanged &&
+        right_token.before == previous_annotation) {
+      done_ = true;
+      return;
+    }
   }
   // next_filtered_token_ now points to leaf_token, now caught up.
-  // TODO(fangism): This costs an entire vector/stack-copy for every leaf token.
-  // May need to choose a different structure for SyntaxTreeContext.
-  saved_left_context_ = Context();
+  saved_left_context_.UpdateFrom(Context(), common_depth_);
+  common_depth_ = Context().size();
 }
 
 }  // namespace
@@ -127,9 +233,101 @@ void AnnotateFormatTokensUsingSyntaxContext(
     std::vector<PreFormatToken>::iterator tokens_begin,
     std::vector<PreFormatToken>::iterator tokens_end,
     const ContextTokenAnnotatorFunction& annotator) {
+  AnnotateFormatTokensUsingSyntaxContext(
+      syntax_tree_root, eof_token, tokens_begin, tokens_end,
+      // lambda: ignore the common depth
+      [&annotator](const PreFormatToken& left, PreFormatToken* right,
+                   const SyntaxTreeContext& left_context,
+                   const SyntaxTreeContext& right_context, size_t) {
+        annotator(left, right, left_context, right_context);
+      });
+}
+
+void AnnotateFormatTokensUsingSyntaxContext(
+    const Symbol* syntax_tree_root, const TokenInfo& eof_token,
+    std::vector<PreFormatToken>::iterator tokens_begin,
+    std::vector<PreFormatToken>::iterator tokens_end,
+    const ContextTokenAnnotatorWithCommonDepthFunction& annotator) {
   TreeAnnotator t(syntax_tree_root, eof_token, tokens_begin, tokens_end,
                   annotator);
   t.Annotate();
 }
 
+void AnnotateFormatTokensUsingSyntaxContext(
+    const Symbol* syntax_tree_root, const TokenInfo& eof_token,
+    std::vector<PreFormatToken>::iterator tokens_begin,
+    std::vector<PreFormatToken>::iterator tokens_end,
+    const ContextTokenAnnotatorWithCommonDepthFunction& annotator,
+    int num_threads) {
+  typedef std::vector<PreFormatToken>::iterator token_iterator;
+  // Split the tokens at the first leaf of top-level items, where a traversal
+  // can start with a known context.  Each slice ends with the first token of
+  // the next one.
+  std::vector<RootSlice> slices;
+  std::vector<std::pair<token_iterator, token_iterator>> slice_tokens;
+  if (syntax_tree_root != nullptr &&
+      syntax_tree_root->Kind() == SymbolKind::kNode &&
+      ResolveNumThreads(num_threads) > 1) {
+    const auto& children = SymbolCastToNode(*syntax_tree_root).children();
+    RootSlice slice;
+    token_iterator slice_begin = tokens_begin;
+    for (size_t i = 1; i < children.size(); ++i) {
+      if (children[i] == nullptr) continue;
+      const SyntaxTreeLeaf* leaf = GetLeftmostLeaf(*children[i]);
+      if (leaf == nullptr) continue;
+      // Format tokens are in text order, so their addresses are sorted.
+      const char* leaf_begin = leaf->get().text.begin();
+      const auto found = std::lower_bound(
+          slice_begin, tokens_end, leaf_begin,
+          [](const PreFormatToken& ftoken, const char* address) {
+            return std::less<const char*>()(ftoken.token->text.begin(),
+                                            address);
+          });
+      if (found == tokens_end || found == slice_begin ||
+          found->token->text.begin() != leaf_begin) {
+        continue;
+      }
+      slice.end_child = i;
+      slice.next_item = children[i].get();
+      slices.push_back(slice);
+      slice_tokens.emplace_back(slice_begin, found + 1);
+      slice = RootSlice();
+      slice.first_child = i;
+      slice_begin = found;
+    }
+    slice.end_child = children.size();
+    slices.push_back(slice);
+    slice_tokens.emplace_back(slice_begin, tokens_end);
+  }
+
+  if (slices.size() <= 1) {
+    AnnotateFormatTokensUsingSyntaxContext(syntax_tree_root, eof_token,
+                                           tokens_begin, tokens_end,
+                                           annotator);
+    return;
+  }
+
+  // An annotation may depend on the left token's annotation, which the
+  // previous slice writes last.  So every slice but the first leaves its
+  // first pair for later, to avoid a data race.
+  ParallelFor(slices.size(), num_threads, [&](size_t i) {
+    RootSlice slice(slices[i]);
+    slice.skip_first_pair = i > 0;
+    TreeAnnotator t(syntax_tree_root, eof_token, slice_tokens[i].first,
+                    slice_tokens[i].second, annotator, &slice);
+    t.Annotate();
+  });
+
+  // Then, in order, annotate the first pair of each slice, and re-annotate
+  // the following tokens until one's annotation no longer changes.
+  // From there on, the annotations match the sequential version.
+  for (size_t i = 1; i < slices.size(); ++i) {
+    RootSlice slice(slices[i]);
+    slice.stop_when_unchanged = true;
+    TreeAnnotator t(syntax_tree_root, eof_token, slice_tokens[i].first,
+                    slice_tokens[i].second, annotator, &slice);
+    t.Annotate();
+  }
+}
+
 }  // namespace verible
@@ -15,6 +15,7 @@
 #ifndef VERIBLE_COMMON_FORMATTING_TREE_ANNOTATOR_H_
 #define VERIBLE_COMMON_FORMATTING_TREE_ANNOTATOR_H_
 
+#include <cstddef>
 #include <functional>
 #include <vector>
 
@@ -32,6 +33,13 @@ using ContextTokenAnnotatorFunction =
     std::function<void(const PreFormatToken&, PreFormatToken*,
                        const SyntaxTreeContext&, const SyntaxTreeContext&)>;
 
+// Same as ContextTokenAnnotatorFunction, with an additional parameter:
+// the number of ancestors that the left and right tokens' contexts have in
+// common, i.e. the depth of their lowest common ancestor.
+using ContextTokenAnnotatorWithCommonDepthFunction = std::function<void(
+    const PreFormatToken&, PreFormatToken*, const SyntaxTreeContext&,
+    const SyntaxTreeContext&, size_t)>;
+
 // Applies inter-token formatting annotations, using syntactic context
 // at every token.
 void AnnotateFormatTokensUsingSyntaxContext(
@@ -40,6 +48,27 @@ void AnnotateFormatTokensUsingSyntaxContext(
     std::vector<PreFormatToken>::iterator tokens_end,
     const ContextTokenAnnotatorFunction& annotator);
 
+// Same as above, but also passes the common depth of the left and right
+// contexts, which is tracked during the traversal at no extra cost.
+void AnnotateFormatTokensUsingSyntaxContext(
+    const Symbol* syntax_tree_root, const TokenInfo& eof_token,
+    std::vector<PreFormatToken>::iterator tokens_begin,
+    std::vector<PreFormatToken>::iterator tokens_end,
+    const ContextTokenAnnotatorWithCommonDepthFunction& annotator);
+
+// Same as above, but annotates the tokens of different top-level items
+// (children of the syntax tree root) concurrently, on up to 'num_threads'
+// threads (see ResolveNumThreads()).  'annotator' must be safe to call
+// concurrently on different right tokens, and its result must depend only
+// on its arguments.  Every token is annotated exactly as by the sequential
+// version.
+void AnnotateFormatTokensUsingSyntaxContext(
+    const Symbol* syntax_tree_root, const TokenInfo& eof_token,
+    std::vector<PreFormatToken>::iterator tokens_begin,
+    std::vector<PreFormatToken>::iterator tokens_end,
+    const ContextTokenAnnotatorWithCommonDepthFunction& annotator,
+    int num_threads);
+
 }  // namespace verible
 
 #endif  // VERIBLE_COMMON_FORMATTING_TREE_ANNOTATOR_H_
@@ -14,6 +14,12 @@
 
 #include "common/formatting/tree_annotator.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "common/formatting/format_token.h"
@@ -224,5 +230,113 @@ TEST(AnnotateFormatTokensUsingSyntaxContextTest, VerifySlidingContexts) {
                   V({6, 8}), V({6, 8}), V({6, 9}), V()));
 }
 
+TEST(AnnotateFormatTokensUsingSyntaxContextTest, VerifyCommonDepth) {
+  const absl::string_view text("abcdefgh");
+  const TokenInfo tokens[] = {
+      {4, text.substr(0, 1)}, {5, text.substr(1, 1)},
+      {6, text.substr(2, 1)}, {4, text.substr(3, 1)},
+      {5, text.substr(4, 1)}, {6, text.substr(5, 1)},
+      {4, text.substr(6, 1)}, {verible::TK_EOF, text.substr(7, 0)},  // EOF
+  };
+  const auto tree = TNode(6,                      // synthesized syntax tree
+                          TNode(7,                //
+                                Leaf(tokens[0]),  //
+                                TNode(10,         //
+                                      Leaf(tokens[1]),  //
+                                      TNode(12)),       //
+                                TNode(11,               //
+                                      TNode(13,         //
+                                            Leaf(tokens[2])),  //
+                                      Leaf(tokens[3]))         //
+                                ),                             //
+                          TNode(8,                             //
+                                Leaf(tokens[4]),               //
+                                Leaf(tokens[5])),              //
+                          TNode(9, TNode(14, Leaf(tokens[6])))  //
+  );
+  std::vector<PreFormatToken> ftokens;
+  for (const auto& t : tokens) {
+    ftokens.emplace_back(&t);
+  }
+  std::vector<size_t> common_depths;
+  auto depth_listener = [&](const PreFormatToken&, PreFormatToken*,
+                            const SyntaxTreeContext& left_context,
+                            const SyntaxTreeContext& right_context,
+                            size_t common_depth) {
+    // Compare against a direct search for the common prefix.
+    size_t expected = 0;
+    while (expected < left_context.size() &&
+           expected < right_context.size() &&
+           *(left_context.begin() + expected) ==
+               *(right_context.begin() + expected)) {
+      ++expected;
+    }
+    EXPECT_EQ(common_depth, expected);
+    common_depths.push_back(common_depth);
+  };
+  AnnotateFormatTokensUsingSyntaxContext(&*tree, tokens[7], ftokens.begin(),
+                                         ftokens.end(), depth_listener);
+  EXPECT_THAT(common_depths, ElementsAre(2, 2, 3, 1, 2, 1, 0));
+}
+
+// Annotates each token with a value that depends on the contexts, the common
+// depth, and the left token's annotation, so that any difference propagates.
+void ChainContexts(const PreFormatToken& left, PreFormatToken* right,
+                   const SyntaxTreeContext& left_context,
+                   const SyntaxTreeContext& right_context,
+                   size_t common_depth) {
+  int64_t value = left.before.spaces_required * 31 + common_depth;
+  for (const auto* node : left_context) value = value * 7 + node->Tag().tag;
+  for (const auto* node : right_context) value = value * 11 + node->Tag().tag;
+  right->before.spaces_required = value % 100003;
+}
+
+TEST(AnnotateFormatTokensUsingSyntaxContextTest, ParallelSameAsSequential) {
+  const absl::string_view text("abcdefghijkl");
+  // Tokens 3 and 8 are not in the tree, like comments.
+  const TokenInfo tokens[] = {
+      {4, text.substr(0, 1)},  {5, text.substr(1, 1)},
+      {6, text.substr(2, 1)},  {4, text.substr(3, 1)},
+      {5, text.substr(4, 1)},  {6, text.substr(5, 1)},
+      {4, text.substr(6, 1)},  {5, text.substr(7, 1)},
+      {6, text.substr(8, 1)},  {4, text.substr(9, 1)},
+      {5, text.substr(10, 1)}, {verible::TK_EOF, text.substr(11, 0)},  // EOF
+  };
+  const auto tree = TNode(6,                                   //
+                          TNode(7,                             //
+                                Leaf(tokens[0]),               //
+                                TNode(10, Leaf(tokens[1]))),   //
+                          TNode(8, Leaf(tokens[2])),           //
+                          TNode(12),                           // no leaves
+                          TNode(9,                             //
+                                TNode(11, Leaf(tokens[4])),    //
+                                Leaf(tokens[5]),               //
+                                Leaf(tokens[6])),              //
+                          nullptr,                             //
+                          TNode(8, Leaf(tokens[7])),           //
+                          TNode(7,                             //
+                                Leaf(tokens[9]),               //
+                                TNode(13, Leaf(tokens[10]))));
+  std::vector<PreFormatToken> expected;
+  for (const auto& t : tokens) {
+    expected.emplace_back(&t);
+  }
+  AnnotateFormatTokensUsingSyntaxContext(&*tree, tokens[11], expected.begin(),
+                                         expected.end(), ChainContexts);
+  for (int num_threads = 1; num_threads <= 4; ++num_threads) {
+    std::vector<PreFormatToken> ftokens;
+    for (const auto& t : tokens) {
+      ftokens.emplace_back(&t);
+    }
+    AnnotateFormatTokensUsingSyntaxContext(&*tree, tokens[11], ftokens.begin(),
+                                           ftokens.end(), ChainContexts,
+                                           num_threads);
+    for (size_t i = 0; i < ftokens.size(); ++i) {
+      EXPECT_EQ(ftokens[i].before, expected[i].before)
+          << "token " << i << " with " << num_threads << " threads";
+    }
+  }
+}
+
 }  // namespace
 }  // namespace verible
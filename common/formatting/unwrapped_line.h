@@ -169,7 +169,8 @@ class FormattedExcerpt {
 
   const std::vector<FormattedToken>& Tokens() const { return tokens_; }
 
-  // Note: The mutable variant is only intended for use in StateNode.
+  // Note: The mutable variant is only intended for use in StateNode and
+  // FormattedExcerptCache.
   std::vector<FormattedToken>& MutableTokens() { return tokens_; }
 
   // Prints formatted text.  If indent is true, include the spacing
@@ -32,7 +32,10 @@
 #ifndef VERIBLE_COMMON_LEXER_FLEX_LEXER_ADAPTER_H_
 #define VERIBLE_COMMON_LEXER_FLEX_LEXER_ADAPTER_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
 #include <string>
@@ -52,11 +55,8 @@ namespace verible {
 class CodeStreamHolder {
  protected:
   // The stream object conforms to the FlexLexer input interface.
-  // Even though scanning is done on the stream's internal copy of the input
-  // string, the byte offsets being tracked can be used to construct
-  // string_views based on the original string's start address.
-  // Using the standard istream interface also lets us switch buffers, e.g.
-  // during preprocessing.
+  // It is never read from, and stays empty, because FlexLexerAdapter
+  // overrides LexerInput() to read directly from the original text.
   std::istringstream code_stream_;
 };
 
@@ -68,10 +68,7 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
       : L(&code_stream_),
         code_(code),
         // last_token_ points to the beginning of the code_ buffer
-        last_token_(0 /* enum doesn't matter */, code_.substr(0, 0)) {
-    code_stream_.str(std::string(code));
-    // istringstream copies text into its own internal buffer.
-  }
+        last_token_(0 /* enum doesn't matter */, code_.substr(0, 0)) {}
 
   // Returns the token associated with the last UpdateLocation() call.
   const TokenInfo& GetLastToken() const override { return last_token_; }
@@ -90,7 +87,7 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
   // Restart lexer by pointing to new input stream, and reset all state.
   void Restart(absl::string_view code) override {
     code_ = code;
-    code_stream_.str(std::string(code_));
+    input_offset_ = 0;
     last_token_ = TokenInfo(0, code_.substr(0, 0));
 
     // Reset buffer stack.
@@ -107,6 +104,18 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
     }
   }
 
+  // Overrides yyFlexLexer's implementation to fill the scanner's buffer
+  // directly from the contiguous text, instead of through an istream, which
+  // would need its own copy of the text.
+  // Returns the number of bytes copied, 0 at end of input.
+  int LexerInput(char* buf, int max_size) override {
+    const size_t size =
+        std::min<size_t>(max_size, code_.length() - input_offset_);
+    std::memcpy(buf, code_.data() + input_offset_, size);
+    input_offset_ += size;
+    return size;
+  }
+
   // Overrides yyFlexLexer's implementation to handle unrecognized chars.
   void LexerOutput(const char* buf, int size) override {
     VLOG(1) << "LexerOutput: rejected text: \"" << std::string(buf, size)
@@ -131,6 +140,9 @@ class FlexLexerAdapter : private CodeStreamHolder, protected L, public Lexer {
   // A read-only view of the entire text to be scanned.
   absl::string_view code_;
 
+  // Position in code_ of the next text to be passed to the scanner.
+  size_t input_offset_ = 0;
+
   // Contains the enumeration and the substring slice of the last lexed token.
   TokenInfo last_token_;
 };
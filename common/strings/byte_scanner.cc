@@ -0,0 +1,145 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/strings/byte_scanner.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace verible {
+
+namespace {
+// Calls visit(offset) for the offset of every byte in 'text' that is equal to
+// 'c', in increasing order.
+template <typename Visitor>
+void ForEachByteEqualTo(absl::string_view text, char c, Visitor visit) {
+  const char* const data = text.data();
+  const size_t size = text.size();
+  size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i pattern32 = _mm256_set1_epi8(c);
+  for (; i + 32 <= size; i += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    uint32_t mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern32)));
+    for (; mask != 0; mask &= mask - 1) visit(i + __builtin_ctz(mask));
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i pattern16 = _mm_set1_epi8(c);
+  for (; i + 16 <= size; i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    uint32_t mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern16)));
+    for (; mask != 0; mask &= mask - 1) visit(i + __builtin_ctz(mask));
+  }
+#endif
+  // Remaining bytes, or all of them without vector instructions.
+  while (i < size) {
+    const void* found = std::memchr(data + i, c, size - i);
+    if (found == nullptr) break;
+    i = static_cast<const char*>(found) - data;
+    visit(i);
+    ++i;
+  }
+}
+
+// Same as std::isspace() in the "C" locale, excluding '\n'.
+bool IsSpaceWithinLine(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+}  // namespace
+
+void AppendLineStartOffsets(absl::string_view text, std::vector<int>* offsets) {
+  ForEachByteEqualTo(text, '\n', [offsets](size_t offset) {
+    offsets->push_back(offset + 1);
+  });
+}
+
+void AppendFirstTabOffsets(absl::string_view text, std::vector<int>* offsets) {
+  const char* const data = text.data();
+  // Tabs before this offset are on a line whose first tab was already found.
+  size_t line_end = 0;
+  ForEachByteEqualTo(text, '\t', [&](size_t offset) {
+    if (offset < line_end) return;
+    offsets->push_back(offset);
+    const void* newline =
+        std::memchr(data + offset, '\n', text.size() - offset);
+    line_end = newline != nullptr ? static_cast<const char*>(newline) - data
+                                  : text.size();
+  });
+}
+
+void AppendTrailingWhitespace(absl::string_view text,
+                              std::vector<absl::string_view>* spans) {
+  size_t line_begin = 0;
+  const auto visit_line_end = [&](size_t line_end) {
+    size_t trailing_begin = line_end;
+    while (trailing_begin > line_begin &&
+           IsSpaceWithinLine(text[trailing_begin - 1])) {
+      --trailing_begin;
+    }
+    if (trailing_begin != line_end) {
+      spans->push_back(text.substr(trailing_begin, line_end - trailing_begin));
+    }
+  };
+  ForEachByteEqualTo(text, '\n', [&](size_t offset) {
+    visit_line_end(offset);
+    line_begin = offset + 1;
+  });
+  // The last line is not terminated by a '\n'.
+  visit_line_end(text.size());
+}
+
+int CountUtf8Characters(absl::string_view text) {
+  const char* const data = text.data();
+  const size_t size = text.size();
+  size_t i = 0;
+  int count = 0;
+  // As signed bytes, continuation bytes are the ones in [-128, -65].
+#if defined(__AVX2__)
+  const __m256i last_continuation32 = _mm256_set1_epi8(-65);
+  for (; i + 32 <= size; i += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    count += __builtin_popcount(static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpgt_epi8(block, last_continuation32))));
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i last_continuation16 = _mm_set1_epi8(-65);
+  for (; i + 16 <= size; i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    count += __builtin_popcount(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(block, last_continuation16))));
+  }
+#endif
+  for (; i < size; ++i) {
+    if ((data[i] & 0xc0) != 0x80) ++count;
+  }
+  return count;
+}
+
+}  // namespace verible
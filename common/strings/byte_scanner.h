@@ -0,0 +1,50 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Scanning kernels that locate classes of bytes in whole buffers at once.
+// They use AVX2 or SSE2 instructions when the compiler targets them
+// (e.g. -mavx2), and otherwise portable scalar code, with identical results.
+
+#ifndef VERIBLE_COMMON_STRINGS_BYTE_SCANNER_H_
+#define VERIBLE_COMMON_STRINGS_BYTE_SCANNER_H_
+
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace verible {
+
+// Appends the offset that follows every '\n' in 'text' to 'offsets', in
+// increasing order.  These are the offsets at which the lines after the first
+// one begin.
+void AppendLineStartOffsets(absl::string_view text, std::vector<int>* offsets);
+
+// Appends the offset of the first '\t' of every line of 'text' that contains
+// one to 'offsets', in increasing order.
+void AppendFirstTabOffsets(absl::string_view text, std::vector<int>* offsets);
+
+// Appends the trailing whitespace of every line of 'text' that ends with any
+// to 'spans', in order.  Lines are separated by '\n', and whitespace is any
+// other character for which std::isspace() is true (in the "C" locale).
+void AppendTrailingWhitespace(absl::string_view text,
+                              std::vector<absl::string_view>* spans);
+
+// Returns the number of characters in UTF-8 encoded 'text', which is the
+// number of bytes that are not continuation bytes (0b10xxxxxx).
+int CountUtf8Characters(absl::string_view text);
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_STRINGS_BYTE_SCANNER_H_
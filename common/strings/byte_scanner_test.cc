@@ -0,0 +1,196 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "common/strings/byte_scanner.h"
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+
+namespace verible {
+namespace {
+
+// Reference implementation.
+std::vector<int> NaiveLineStartOffsets(absl::string_view text) {
+  std::vector<int> offsets;
+  for (size_t i = 0; i < text.size(); ++i) {
+    if (text[i] == '\n') offsets.push_back(i + 1);
+  }
+  return offsets;
+}
+
+std::vector<int> NaiveFirstTabOffsets(absl::string_view text) {
+  std::vector<int> offsets;
+  size_t line_begin = 0;
+  for (const absl::string_view line : absl::StrSplit(text, '\n')) {
+    const size_t tab = line.find('\t');
+    if (tab != absl::string_view::npos) offsets.push_back(line_begin + tab);
+    line_begin += line.length() + 1;
+  }
+  return offsets;
+}
+
+std::vector<absl::string_view> NaiveTrailingWhitespace(absl::string_view text) {
+  std::vector<absl::string_view> spans;
+  for (const absl::string_view line : absl::StrSplit(text, '\n')) {
+    size_t length = line.length();
+    while (length > 0 && std::isspace(line[length - 1])) --length;
+    if (length != line.length()) spans.push_back(line.substr(length));
+  }
+  return spans;
+}
+
+// Returns text with a mix of the byte classes of interest.
+std::string MixedText() {
+  const char kPieces[] = {'a', ' ', '\t', '\n', '\r', 'b', ' ', '\n'};
+  std::string text;
+  for (int i = 0; i < 500; ++i) {
+    text.push_back(kPieces[(i * 7 + i / 5) % sizeof(kPieces)]);
+    if (i % 13 == 0) text.append("\xc3\xa4");        // two byte encoding
+    if (i % 29 == 0) text.append("\xe2\x80\xb1");    // three byte encoding
+    if (i % 31 == 0) text.append(40 - i % 40, 'x');  // longer line
+  }
+  return text;
+}
+
+TEST(AppendLineStartOffsetsTest, Empty) {
+  std::vector<int> offsets;
+  AppendLineStartOffsets("", &offsets);
+  EXPECT_TRUE(offsets.empty());
+}
+
+TEST(AppendLineStartOffsetsTest, Appends) {
+  std::vector<int> offsets{0};
+  AppendLineStartOffsets("ab\n\ncd\n", &offsets);
+  EXPECT_EQ(offsets, (std::vector<int>{0, 3, 4, 7}));
+}
+
+// Covers every position within and across vector-sized blocks.
+TEST(AppendLineStartOffsetsTest, AllPositions) {
+  for (size_t length = 0; length <= 100; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      std::string text(length, 'x');
+      text[position] = '\n';
+      std::vector<int> offsets;
+      AppendLineStartOffsets(text, &offsets);
+      EXPECT_EQ(offsets, std::vector<int>{int(position + 1)})
+          << "length: " << length << ", position: " << position;
+    }
+  }
+}
+
+TEST(AppendLineStartOffsetsTest, ManyNewlines) {
+  std::string text;
+  for (int i = 0; i < 300; ++i) {
+    // Lines of varying lengths, including empty ones.
+    text.append(i % 37, static_cast<char>('a' + i % 26));
+    text.push_back('\n');
+  }
+  // Also start at every alignment.
+  for (size_t start = 0; start < 32; ++start) {
+    const absl::string_view substring = absl::string_view(text).substr(start);
+    std::vector<int> offsets;
+    AppendLineStartOffsets(substring, &offsets);
+    EXPECT_EQ(offsets, NaiveLineStartOffsets(substring)) << "start: " << start;
+  }
+}
+
+TEST(AppendLineStartOffsetsTest, AllNewlines) {
+  const std::string text(70, '\n');
+  std::vector<int> offsets;
+  AppendLineStartOffsets(text, &offsets);
+  EXPECT_EQ(offsets, NaiveLineStartOffsets(text));
+}
+
+TEST(AppendFirstTabOffsetsTest, Various) {
+  const absl::string_view kTexts[] = {
+      "", "\t", "\t\t", "a\tb\tc", "\n\t", "\t\n", "ab\n\t\t\n c\td\t\n",
+  };
+  for (const auto text : kTexts) {
+    std::vector<int> offsets;
+    AppendFirstTabOffsets(text, &offsets);
+    EXPECT_EQ(offsets, NaiveFirstTabOffsets(text)) << "text: " << text;
+  }
+}
+
+TEST(AppendFirstTabOffsetsTest, MixedText) {
+  const std::string text(MixedText());
+  for (size_t start = 0; start < 32; ++start) {
+    const absl::string_view substring = absl::string_view(text).substr(start);
+    std::vector<int> offsets;
+    AppendFirstTabOffsets(substring, &offsets);
+    EXPECT_EQ(offsets, NaiveFirstTabOffsets(substring)) << "start: " << start;
+  }
+}
+
+TEST(AppendTrailingWhitespaceTest, Various) {
+  const absl::string_view kTexts[] = {
+      "",       " ",          "\n",       "a \n",          " a",
+      "a\t \n", "a\r\n b \n", "\v\f\n \n", "  \n  \n  x",
+  };
+  for (const auto text : kTexts) {
+    std::vector<absl::string_view> spans;
+    AppendTrailingWhitespace(text, &spans);
+    const auto expected = NaiveTrailingWhitespace(text);
+    ASSERT_EQ(spans.size(), expected.size()) << "text: " << text;
+    for (size_t i = 0; i < spans.size(); ++i) {
+      // Compare locations, not just contents.
+      EXPECT_EQ(spans[i].data(), expected[i].data()) << "text: " << text;
+      EXPECT_EQ(spans[i].length(), expected[i].length()) << "text: " << text;
+    }
+  }
+}
+
+TEST(AppendTrailingWhitespaceTest, MixedText) {
+  const std::string text(MixedText());
+  for (size_t start = 0; start < 32; ++start) {
+    const absl::string_view substring = absl::string_view(text).substr(start);
+    std::vector<absl::string_view> spans;
+    AppendTrailingWhitespace(substring, &spans);
+    const auto expected = NaiveTrailingWhitespace(substring);
+    ASSERT_EQ(spans.size(), expected.size()) << "start: " << start;
+    for (size_t i = 0; i < spans.size(); ++i) {
+      EXPECT_EQ(spans[i].data(), expected[i].data()) << "start: " << start;
+      EXPECT_EQ(spans[i].length(), expected[i].length()) << "start: " << start;
+    }
+  }
+}
+
+TEST(CountUtf8CharactersTest, Various) {
+  EXPECT_EQ(CountUtf8Characters(""), 0);
+  EXPECT_EQ(CountUtf8Characters("abc"), 3);
+  EXPECT_EQ(CountUtf8Characters("\xc3\xa4"), 1);
+  EXPECT_EQ(CountUtf8Characters("\xf0\x9d\x85\xa0"), 1);
+  EXPECT_EQ(CountUtf8Characters("\x7f\x80\xbf\xc0\xff"), 3);
+}
+
+TEST(CountUtf8CharactersTest, MixedText) {
+  const std::string text(MixedText());
+  for (size_t start = 0; start < 32; ++start) {
+    const absl::string_view substring = absl::string_view(text).substr(start);
+    int expected = 0;
+    for (const char c : substring) {
+      if ((c & 0xc0) != 0x80) ++expected;
+    }
+    EXPECT_EQ(CountUtf8Characters(substring), expected) << "start: " << start;
+  }
+}
+
+}  // namespace
+}  // namespace verible
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "common/strings/byte_scanner.h"
 
 namespace verible {
 
@@ -40,15 +41,25 @@ LineColumnMap::LineColumnMap(absl::string_view text) {
   // The column number after every line break is 0.
   // The first line always starts at offset 0.
   beginning_of_line_offsets_.push_back(0);
-  auto offset = text.find('\n');
-  while (offset != absl::string_view::npos) {
-    beginning_of_line_offsets_.push_back(offset + 1);
-    offset = text.find('\n', offset + 1);
-  }
+  AppendLineStartOffsets(text, &beginning_of_line_offsets_);
   // If the text does not end with a \n (POSIX), don't implicitly behave as if
   // there were one.
 }
 
+LineColumnMap::LineColumnMap(absl::string_view text,
+                             std::vector<absl::string_view>* lines)
+    : LineColumnMap(text) {
+  lines->clear();
+  lines->reserve(beginning_of_line_offsets_.size());
+  auto line_begin = beginning_of_line_offsets_.begin();
+  for (auto next = line_begin + 1; next != beginning_of_line_offsets_.end();
+       line_begin = next, ++next) {
+    // Exclude the '\n'.
+    lines->push_back(text.substr(*line_begin, *next - *line_begin - 1));
+  }
+  lines->push_back(text.substr(*line_begin));
+}
+
 // Constructor that calculates line break offsets given an already-split
 // set of lines for a body of text.
 LineColumnMap::LineColumnMap(const std::vector<absl::string_view>& lines) {
@@ -71,4 +82,32 @@ LineColumn LineColumnMap::operator()(int offset) const {
   return LineColumn{line_number, column};
 }
 
+std::vector<LineColumn> LineColumnMap::GetLineColumns(
+    const std::vector<int>& offsets) const {
+  std::vector<LineColumn> result;
+  result.reserve(offsets.size());
+  const auto begin = beginning_of_line_offsets_.begin();
+  const auto end = beginning_of_line_offsets_.end();
+  // Beginning of the line of the previous offset.
+  auto base = begin;
+  for (const int offset : offsets) {
+    if (offset < *base) base = begin;  // Out of order, start over.
+    // Gallop forward to bracket the next line beginning after 'offset', so
+    // that nearby offsets are found in few steps, and distant ones in
+    // logarithmically many.
+    auto low = base + 1;
+    size_t step = 1;
+    while (step <= static_cast<size_t>(end - low) &&
+           *(low + (step - 1)) <= offset) {
+      low += step;
+      step *= 2;
+    }
+    const auto high = low + std::min(step, static_cast<size_t>(end - low));
+    base = std::upper_bound(low, high, offset) - 1;
+    const int line_number = std::distance(begin, base);
+    result.push_back(LineColumn{line_number, offset - *base});
+  }
+  return result;
+}
+
 }  // namespace verible
@@ -49,6 +49,11 @@ class LineColumnMap {
  public:
   explicit LineColumnMap(absl::string_view);
 
+  // Same as above, and also splits the text into 'lines' (like
+  // absl::StrSplit(text, '\n')) in the same pass.
+  LineColumnMap(absl::string_view text,
+                std::vector<absl::string_view>* lines);
+
   explicit LineColumnMap(const std::vector<absl::string_view>& lines);
 
   void Clear() { beginning_of_line_offsets_.clear(); }
@@ -66,6 +71,12 @@ class LineColumnMap {
   // Translate byte-offset into line and column.
   LineColumn operator()(int bytes_offset) const;
 
+  // Translates many byte-offsets into lines and columns, in one sweep over
+  // the beginning-of-line offsets.  This is fastest for ascending offsets,
+  // such as those of sorted diagnostics, but works for any order.
+  std::vector<LineColumn> GetLineColumns(
+      const std::vector<int>& bytes_offsets) const;
+
   const std::vector<int>& GetBeginningOfLineOffsets() const {
     return beginning_of_line_offsets_;
   }
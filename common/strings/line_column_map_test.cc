@@ -16,7 +16,9 @@
 
 #include "common/strings/line_column_map.h"
 
+#include <algorithm>
 #include <sstream>  // IWYU pragma: keep  // for ostringstream
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -113,6 +115,19 @@ TEST(LineColumnMapTest, OffsetsFromLines) {
   }
 }
 
+// The constructor that also splits lines should split like absl::StrSplit.
+TEST(LineColumnMapTest, OffsetsAndSplitLines) {
+  for (const auto& test_case : map_test_data) {
+    std::vector<absl::string_view> lines;
+    const LineColumnMap line_map(test_case.text, &lines);
+    const std::vector<absl::string_view> expected_lines =
+        absl::StrSplit(test_case.text, '\n');
+    EXPECT_EQ(lines, expected_lines) << "Text: \"" << test_case.text << "\"";
+    EXPECT_EQ(line_map.GetBeginningOfLineOffsets(), test_case.expected_offsets)
+        << "Text: \"" << test_case.text << "\"";
+  }
+}
+
 TEST(LineColumnMapTest, EndOffsetNoLines) {
   const std::vector<absl::string_view> lines;
   const LineColumnMap map(lines);
@@ -152,5 +167,48 @@ TEST(LineColumnMapTest, Lookup) {
   }
 }
 
+// Batched lookups should agree with individual lookups, in any order.
+TEST(LineColumnMapTest, GetLineColumns) {
+  for (const auto& test_case : map_test_data) {
+    const LineColumnMap line_map(test_case.text);
+    std::vector<int> offsets;
+    std::vector<LineColumn> expected;
+    for (const auto& q : test_case.queries) {
+      offsets.push_back(q.offset);
+      expected.push_back(line_map(q.offset));
+    }
+    EXPECT_EQ(line_map.GetLineColumns(offsets), expected)
+        << "Text: \"" << test_case.text << "\"";
+    std::reverse(offsets.begin(), offsets.end());
+    std::reverse(expected.begin(), expected.end());
+    EXPECT_EQ(line_map.GetLineColumns(offsets), expected)
+        << "Text: \"" << test_case.text << "\"";
+  }
+}
+
+TEST(LineColumnMapTest, GetLineColumnsEmpty) {
+  const LineColumnMap line_map("aaa\nbbb\n");
+  EXPECT_TRUE(line_map.GetLineColumns({}).empty());
+}
+
+// Exercises skipping over many lines between lookups.
+TEST(LineColumnMapTest, GetLineColumnsManyLines) {
+  std::string text;
+  for (int i = 0; i < 200; ++i) {
+    text.append(i % 7, 'x');
+    text.push_back('\n');
+  }
+  const LineColumnMap line_map(text);
+  std::vector<int> offsets;
+  for (int offset = 0; offset <= int(text.length()); offset += 13) {
+    offsets.push_back(offset);
+  }
+  offsets.push_back(5);  // out of order
+  offsets.push_back(text.length());
+  std::vector<LineColumn> expected;
+  for (const int offset : offsets) expected.push_back(line_map(offset));
+  EXPECT_EQ(line_map.GetLineColumns(offsets), expected);
+}
+
 }  // namespace
 }  // namespace verible
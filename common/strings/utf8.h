@@ -15,16 +15,12 @@
 #ifndef VERIBLE_COMMON_STRINGS_UTF8_H_
 #define VERIBLE_COMMON_STRINGS_UTF8_H_
 
-#include <algorithm>
-
 #include "absl/strings/string_view.h"
+#include "common/strings/byte_scanner.h"
 
 namespace verible {
 // Determine length in characters of an UTF8-encoded string.
-inline int utf8_len(absl::string_view str) {
-  return std::count_if(str.begin(), str.end(),
-                       [](char c) { return (c & 0xc0) != 0x80; });
-}
+inline int utf8_len(absl::string_view str) { return CountUtf8Characters(str); }
 }  // namespace verible
 
 #endif  // VERIBLE_COMMON_STRINGS_UTF8_H_
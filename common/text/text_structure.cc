@@ -29,6 +29,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "common/strings/line_column_map.h"
 #include "common/text/concrete_syntax_leaf.h"
 #include "common/text/concrete_syntax_tree.h"
@@ -45,8 +46,7 @@ namespace verible {
 
 TextStructureView::TextStructureView(absl::string_view contents)
     : contents_(contents),
-      lines_(absl::StrSplit(contents_, '\n')),  // SplitLines()
-      line_column_map_(lines_) {
+      line_column_map_(contents_, &lines_) {
   // more than sufficient memory as number-of-tokens <= bytes-in-file,
   // push_back() should never re-alloc because size <= initial capacity.
   tokens_.reserve(contents.length());
@@ -63,7 +63,13 @@ TextStructureView::~TextStructureView() {
       << status.message();
 }
 
+void TextStructureView::DiscardDerivedAnalyses() {
+  absl::MutexLock lock(&derived_mutex_);
+  derived_analyses_.clear();
+}
+
 void TextStructureView::Clear() {
+  DiscardDerivedAnalyses();
   syntax_tree_ = nullptr;
   line_column_map_.Clear();
   line_token_map_.clear();
@@ -94,10 +100,12 @@ std::vector<typename V::iterator> _CopyWriteableIterators(
 }
 
 TokenStreamReferenceView TextStructureView::MakeTokenStreamReferenceView() {
+  DiscardDerivedAnalyses();
   return _CopyWriteableIterators(tokens_, tokens_view_);
 }
 
 void TextStructureView::CalculateFirstTokensPerLine() {
+  DiscardDerivedAnalyses();
   line_token_map_.clear();
   auto token_iter = tokens_.cbegin();
   const auto& offset_map = line_column_map_.GetBeginningOfLineOffsets();
@@ -142,6 +150,7 @@ TokenInfo TextStructureView::EOFToken() const {
 // Removes tokens from the TokenStreamView that do not satisfy the keep
 // predicate.
 void TextStructureView::FilterTokens(const TokenFilterPredicate& keep) {
+  DiscardDerivedAnalyses();
   FilterTokenStreamViewInPlace(keep, &tokens_view_);
 }
 
@@ -157,13 +166,13 @@ static void TerminateTokenStream(TokenSequence* tokens) {
 
 void TextStructureView::FocusOnSubtreeSpanningSubstring(int left_offset,
                                                         int length) {
+  DiscardDerivedAnalyses();
   VLOG(2) << __FUNCTION__ << " at " << left_offset << " +" << length;
   const int right_offset = left_offset + length;
   TrimSyntaxTree(left_offset, right_offset);
   TrimTokensToSubstring(left_offset, right_offset);
   TrimContents(left_offset, length);
-  SplitLines();
-  RecalculateLineColumnMap();
+  RecalculateLineColumnMap();  // also re-splits lines
   CalculateFirstTokensPerLine();
   const absl::Status status = InternalConsistencyCheck();
   CHECK(status.ok())
@@ -236,6 +245,7 @@ void TextStructureView::SplitLines() {
 void TextStructureView::RebaseTokensToSuperstring(absl::string_view superstring,
                                                   absl::string_view src_base,
                                                   int offset) {
+  DiscardDerivedAnalyses();
   MutateTokens([&](TokenInfo* token) {
     const int delta = token->left(src_base);
     // Superstring must point to separate memory space.
@@ -248,6 +258,7 @@ void TextStructureView::RebaseTokensToSuperstring(absl::string_view superstring,
 }
 
 void TextStructureView::MutateTokens(const LeafMutator& mutator) {
+  DiscardDerivedAnalyses();
   for (auto& token : tokens_) {
     mutator(&token);
   }
@@ -457,6 +468,7 @@ TextStructure::~TextStructure() {
 }
 
 void TextStructureView::ExpandSubtrees(NodeExpansionMap* expansions) {
+  DiscardDerivedAnalyses();
   TokenSequence combined_tokens;
   // Gather indices and reconstruct iterators after there are no more
   // reallocations due to growing combined_tokens.
@@ -34,6 +34,7 @@
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "common/strings/line_column_map.h"
 #include "common/text/concrete_syntax_tree.h"
 #include "common/text/symbol.h"
@@ -79,15 +80,24 @@ class TextStructureView {
 
   const ConcreteSyntaxTree& SyntaxTree() const { return syntax_tree_; }
 
-  ConcreteSyntaxTree& MutableSyntaxTree() { return syntax_tree_; }
+  ConcreteSyntaxTree& MutableSyntaxTree() {
+    DiscardDerivedAnalyses();
+    return syntax_tree_;
+  }
 
   const TokenSequence& TokenStream() const { return tokens_; }
 
-  TokenSequence& MutableTokenStream() { return tokens_; }
+  TokenSequence& MutableTokenStream() {
+    DiscardDerivedAnalyses();
+    return tokens_;
+  }
 
   const TokenStreamView& GetTokenStreamView() const { return tokens_view_; }
 
-  TokenStreamView& MutableTokenStreamView() { return tokens_view_; }
+  TokenStreamView& MutableTokenStreamView() {
+    DiscardDerivedAnalyses();
+    return tokens_view_;
+  }
 
   // Creates a stream of modifiable iterators to the filtered tokens.
   // Uses tokens_view_ to create the iterators.
@@ -95,8 +105,11 @@ class TextStructureView {
 
   const LineColumnMap& GetLineColumnMap() const { return line_column_map_; }
 
+  // Re-computes the line-column map and Lines() from the current contents,
+  // in a single pass over the text.
   void RecalculateLineColumnMap() {
-    line_column_map_ = LineColumnMap(contents_);
+    DiscardDerivedAnalyses();
+    line_column_map_ = LineColumnMap(contents_, &lines_);
   }
 
   const std::vector<TokenSequence::const_iterator>& GetLineTokenMap() const {
@@ -153,7 +166,31 @@ class TextStructureView {
   // All of this class's consistency checks combined.
   absl::Status InternalConsistencyCheck() const;
 
+  // Returns an analysis of type T that is derived from this text structure.
+  // It is constructed as T(*this) on first use, and then shared by all
+  // callers, so that different consumers (e.g. all lint rules and the
+  // formatter) do not need to re-derive the same facts.
+  // The analysis is discarded by any mutation through a non-const method,
+  // which also invalidates the returned reference.
+  // This is thread-safe.  T's constructor must not call GetDerivedAnalysis()
+  // on the same object.
+  template <typename T>
+  const T& GetDerivedAnalysis() const ABSL_LOCKS_EXCLUDED(derived_mutex_) {
+    absl::MutexLock lock(&derived_mutex_);
+    auto& analysis = derived_analyses_[&DerivedAnalysisKey<T>::kKey];
+    if (analysis == nullptr) analysis = std::make_shared<const T>(*this);
+    return *static_cast<const T*>(analysis.get());
+  }
+
  protected:
+  // Identifies the type of a derived analysis, by the address of kKey.
+  template <typename T>
+  struct DerivedAnalysisKey {
+    static const char kKey;
+  };
+
+  void DiscardDerivedAnalyses() ABSL_LOCKS_EXCLUDED(derived_mutex_);
+
   // This is the text that is spanned by the token sequence and syntax tree.
   // This is required for calculating byte offsets to substrings contained
   // within this structure.  Pass this (via Contents()) to TokenInfo::left() and
@@ -179,6 +216,12 @@ class TextStructureView {
   // Tree representation of file contents.
   ConcreteSyntaxTree syntax_tree_;
 
+  mutable absl::Mutex derived_mutex_;
+
+  // Analyses returned by GetDerivedAnalysis(), keyed by DerivedAnalysisKey.
+  mutable std::map<const char*, std::shared_ptr<const void>> derived_analyses_
+      ABSL_GUARDED_BY(derived_mutex_);
+
   void TrimSyntaxTree(int first_token_offset, int last_token_offset);
 
   void TrimTokensToSubstring(int left_offset, int right_offset);
@@ -206,6 +249,9 @@ class TextStructureView {
   absl::Status SyntaxTreeConsistencyCheck() const;
 };
 
+template <typename T>
+const char TextStructureView::DerivedAnalysisKey<T>::kKey = 0;
+
 // TextStructure holds the results of lexing and parsing.
 // This contains rather than inherits from TextStructureView because
 // the same owned memory can be used for multiple analysis views.
@@ -64,6 +64,42 @@ TEST(TextStructureViewCtorTest, InitializeContents) {
 }
 
 // Test that filtering nothing works.
+// Counts its own constructions, as an example of a derived analysis.
+struct CountingAnalysis {
+  explicit CountingAnalysis(const TextStructureView& view)
+      : num_lines(view.Lines().size()) {
+    ++num_constructed;
+  }
+
+  size_t num_lines;
+  static int num_constructed;
+};
+
+int CountingAnalysis::num_constructed = 0;
+
+struct OtherAnalysis {
+  explicit OtherAnalysis(const TextStructureView&) {}
+};
+
+TEST(GetDerivedAnalysisTest, ComputedOnceUntilMutated) {
+  CountingAnalysis::num_constructed = 0;
+  TextStructureView test_view("foo\nbar\n");
+  const CountingAnalysis& analysis =
+      test_view.GetDerivedAnalysis<CountingAnalysis>();
+  EXPECT_EQ(analysis.num_lines, 3);
+  EXPECT_EQ(CountingAnalysis::num_constructed, 1);
+
+  // Shared by later callers, regardless of other analysis types.
+  test_view.GetDerivedAnalysis<OtherAnalysis>();
+  EXPECT_EQ(&test_view.GetDerivedAnalysis<CountingAnalysis>(), &analysis);
+  EXPECT_EQ(CountingAnalysis::num_constructed, 1);
+
+  // Mutation discards it.
+  test_view.MutableSyntaxTree();
+  test_view.GetDerivedAnalysis<CountingAnalysis>();
+  EXPECT_EQ(CountingAnalysis::num_constructed, 2);
+}
+
 TEST(FilterTokensTest, EmptyTokens) {
   TextStructureView test_view("blah");
   EXPECT_THAT(test_view.GetTokenStreamView(), IsEmpty());
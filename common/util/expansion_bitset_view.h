@@ -0,0 +1,120 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_UTIL_EXPANSION_BITSET_VIEW_H_
+#define VERIBLE_COMMON_UTIL_EXPANSION_BITSET_VIEW_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "common/util/vector_tree.h"
+
+namespace verible {
+
+// ExpansionBitsetView is a read-only, selectively expanded view of a
+// VectorTree, like ExpandableTreeView, with the same visiting rule: an
+// expanded node with children is represented by its children, any other
+// node is visited as a whole.
+//
+// Whereas ExpandableTreeView builds a parallel tree of node references,
+// this only stores one bit per node, indexed by the node's position in a
+// pre-order traversal, and hands out pointers to the visible nodes of the
+// original tree instead of copies of their values.
+//
+// Structural modifications to the viewed tree invalidate the view.
+template <class T>
+class ExpansionBitsetView {
+ public:
+  typedef VectorTree<T> tree_type;
+
+  // Returns true if 'node' should be expanded, given whether any of its
+  // children is expanded.
+  using ExpansionPolicy =
+      std::function<bool(const tree_type& node, bool any_child_expanded)>;
+
+  // Constructs a fully-expanded view of 'tree'.
+  explicit ExpansionBitsetView(const tree_type& tree)
+      : tree_(tree), expanded_(CountNodes(tree), true) {}
+
+  ExpansionBitsetView(const ExpansionBitsetView&) = default;
+  ExpansionBitsetView(ExpansionBitsetView&&) = default;
+
+  // Returns the number of nodes in the viewed tree.
+  size_t NumNodes() const { return expanded_.size(); }
+
+  // Returns true if the node at pre-order position 'index' is expanded.
+  bool IsExpanded(size_t index) const { return expanded_[index]; }
+
+  // Decides whether to expand every node, in a post-order traversal, so that
+  // 'policy' knows about the children's expansions.
+  void DecideExpansionsPostOrder(const ExpansionPolicy& policy) {
+    DecideSubtree(tree_, 0, policy);
+  }
+
+  // Returns the visible nodes in order.
+  std::vector<const tree_type*> VisibleNodes() const {
+    std::vector<const tree_type*> visible;
+    CollectVisible(tree_, 0, &visible);
+    return visible;
+  }
+
+ private:
+  static size_t CountNodes(const tree_type& node) {
+    size_t count = 1;
+    for (const auto& child : node.Children()) count += CountNodes(child);
+    return count;
+  }
+
+  // Decides the expansions of the subtree rooted at 'node', whose pre-order
+  // position is 'index'.  Returns the position that follows the subtree.
+  size_t DecideSubtree(const tree_type& node, size_t index,
+                       const ExpansionPolicy& policy) {
+    bool any_child_expanded = false;
+    size_t next_index = index + 1;
+    for (const auto& child : node.Children()) {
+      const size_t child_index = next_index;
+      next_index = DecideSubtree(child, child_index, policy);
+      any_child_expanded = any_child_expanded || expanded_[child_index];
+    }
+    expanded_[index] = policy(node, any_child_expanded);
+    return next_index;
+  }
+
+  // Appends the visible nodes of the subtree rooted at 'node', whose
+  // pre-order position is 'index'.  Returns the position that follows the
+  // subtree.
+  size_t CollectVisible(const tree_type& node, size_t index,
+                        std::vector<const tree_type*>* visible) const {
+    if (!expanded_[index] || node.Children().empty()) {
+      visible->push_back(&node);
+      return index + CountNodes(node);
+    }
+    size_t next_index = index + 1;
+    for (const auto& child : node.Children()) {
+      next_index = CollectVisible(child, next_index, visible);
+    }
+    return next_index;
+  }
+
+  // The viewed tree.
+  const tree_type& tree_;
+
+  // Expansion of every node, in pre-order.
+  std::vector<bool> expanded_;
+};
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_EXPANSION_BITSET_VIEW_H_
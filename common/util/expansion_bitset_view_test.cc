@@ -0,0 +1,127 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/expansion_bitset_view.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "common/util/expandable_tree_view.h"
+#include "common/util/vector_tree.h"
+#include "common/util/vector_tree_test_util.h"
+
+namespace verible {
+namespace {
+
+using ::testing::ElementsAre;
+using verible::testing::NamedInterval;
+using verible::testing::VectorTreeTestType;
+
+using ExpansionBitsetViewTestType = ExpansionBitsetView<NamedInterval>;
+
+std::vector<absl::string_view> VisibleNames(
+    const ExpansionBitsetViewTestType& view) {
+  std::vector<absl::string_view> names;
+  for (const auto* node : view.VisibleNodes()) {
+    names.push_back(node->Value().name);
+  }
+  return names;
+}
+
+TEST(ExpansionBitsetViewTest, RootOnly) {
+  const VectorTreeTestType tree(verible::testing::MakeRootOnlyExampleTree());
+  const ExpansionBitsetViewTestType view(tree);
+  EXPECT_EQ(view.NumNodes(), 1);
+  EXPECT_TRUE(view.IsExpanded(0));
+  const auto visible = view.VisibleNodes();
+  ASSERT_EQ(visible.size(), 1);
+  EXPECT_EQ(visible.front(), &tree);
+}
+
+TEST(ExpansionBitsetViewTest, FamilyTreeFullyExpanded) {
+  const auto tree = verible::testing::MakeExampleFamilyTree();
+  const ExpansionBitsetViewTestType view(tree);
+  EXPECT_EQ(view.NumNodes(), 7);
+  EXPECT_THAT(VisibleNames(view),
+              ElementsAre("child1", "child2", "child3", "child4"));
+  // References point into the original tree.
+  const auto& child1 = tree.Children().front().Children().front();
+  EXPECT_EQ(view.VisibleNodes().front(), &child1);
+}
+
+TEST(ExpansionBitsetViewTest, FamilyTreeUnexpanded) {
+  const auto tree = verible::testing::MakeExampleFamilyTree();
+  ExpansionBitsetViewTestType view(tree);
+  view.DecideExpansionsPostOrder(
+      [](const VectorTreeTestType&, bool) { return false; });
+  EXPECT_THAT(VisibleNames(view), ElementsAre("grandparent"));
+}
+
+TEST(ExpansionBitsetViewTest, FamilyTreePartiallyExpanded) {
+  const auto tree = verible::testing::MakeExampleFamilyTree();
+  ExpansionBitsetViewTestType view(tree);
+  // Expand parent2, which forces grandparent to expand.
+  view.DecideExpansionsPostOrder(
+      [](const VectorTreeTestType& node, bool any_child_expanded) {
+        return any_child_expanded || node.Value().name == "parent2";
+      });
+  EXPECT_THAT(VisibleNames(view), ElementsAre("parent1", "child3", "child4"));
+  // Pre-order: grandparent, parent1, child1, child2, parent2, child3, child4
+  EXPECT_TRUE(view.IsExpanded(0));
+  EXPECT_FALSE(view.IsExpanded(1));
+  EXPECT_TRUE(view.IsExpanded(4));
+  EXPECT_FALSE(view.IsExpanded(5));
+}
+
+// Expect the same visible nodes as ExpandableTreeView, for every combination
+// of expansions on the family tree.
+TEST(ExpansionBitsetViewTest, SameAsExpandableTreeView) {
+  const auto tree = verible::testing::MakeExampleFamilyTree();
+  for (int mask = 0; mask < (1 << 7); ++mask) {
+    // Decide expansions by pre-order position.
+    std::vector<bool> expansions;
+    for (int i = 0; i < 7; ++i) expansions.push_back((mask >> i) & 1);
+
+    ExpandableTreeView<NamedInterval> expected_view(tree);
+    int index = 0;
+    expected_view.ApplyPreOrder(
+        [&](VectorTree<TreeViewNodeInfo<NamedInterval>>& node) {
+          if (expansions[index++]) {
+            node.Value().Expand();
+          } else {
+            node.Value().Unexpand();
+          }
+        });
+    std::vector<const NamedInterval*> expected;
+    for (const auto& value : expected_view) expected.push_back(&value);
+
+    // Post-order on the family tree visits pre-order positions in this order.
+    const std::vector<int> post_order{2, 3, 1, 5, 6, 4, 0};
+    ExpansionBitsetViewTestType view(tree);
+    index = 0;
+    view.DecideExpansionsPostOrder([&](const VectorTreeTestType&, bool) {
+      return bool(expansions[post_order[index++]]);
+    });
+    std::vector<const NamedInterval*> actual;
+    for (const auto* node : view.VisibleNodes()) {
+      actual.push_back(&node->Value());
+    }
+    EXPECT_EQ(actual, expected) << "mask: " << mask;
+  }
+}
+
+}  // namespace
+}  // namespace verible
@@ -43,6 +43,14 @@ absl::string_view Basename(absl::string_view filename) {
              : filename.substr(last_slash_pos + 1);
 }
 
+absl::string_view Dirname(absl::string_view filename) {
+  auto last_slash_pos = filename.find_last_of("/\\");
+
+  if (last_slash_pos == absl::string_view::npos) return "";
+  return last_slash_pos == 0 ? filename.substr(0, 1)
+                             : filename.substr(0, last_slash_pos);
+}
+
 absl::string_view Stem(absl::string_view filename) {
   auto last_dot_pos = filename.find_last_of('.');
 
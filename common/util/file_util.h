@@ -31,6 +31,11 @@ namespace file {
 // empty string.
 absl::string_view Basename(absl::string_view filename);
 
+// Returns the part of the path before the final "/", which is "/" for files
+// in the root directory.  If there is no "/" in the path, the result is the
+// empty string.
+absl::string_view Dirname(absl::string_view filename);
+
 // Returns the part of the basename of path prior to the final ".".  If
 // there is no "." in the basename, this is equivalent to file::Basename(path).
 absl::string_view Stem(absl::string_view filename);
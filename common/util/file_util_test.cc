@@ -33,6 +33,15 @@ TEST(FileUtil, Basename) {
   EXPECT_EQ(file::Basename(""), "");
 }
 
+TEST(FileUtil, Dirname) {
+  EXPECT_EQ(file::Dirname("/foo/bar/baz"), "/foo/bar");
+  EXPECT_EQ(file::Dirname("foo/bar/baz"), "foo/bar");
+  EXPECT_EQ(file::Dirname("/foo/bar/"), "/foo/bar");
+  EXPECT_EQ(file::Dirname("/foo"), "/");
+  EXPECT_EQ(file::Dirname("foo"), "");
+  EXPECT_EQ(file::Dirname(""), "");
+}
+
 TEST(FileUtil, Stem) {
   EXPECT_EQ(file::Stem(""), "");
   EXPECT_EQ(file::Stem("/foo/bar.baz"), "/foo/bar");
@@ -0,0 +1,51 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace verible {
+
+int ResolveNumThreads(int num_threads) {
+  if (num_threads > 0) return num_threads;
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ParallelFor(size_t num_tasks, int num_threads,
+                 const std::function<void(size_t)>& task) {
+  const size_t max_threads =
+      std::min(static_cast<size_t>(ResolveNumThreads(num_threads)), num_tasks);
+  if (max_threads <= 1) {
+    for (size_t i = 0; i < num_tasks; ++i) task(i);
+    return;
+  }
+
+  std::atomic<size_t> next_task(0);
+  const auto worker = [&]() {
+    for (size_t i = next_task++; i < num_tasks; i = next_task++) task(i);
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(max_threads - 1);
+  for (size_t i = 1; i < max_threads; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace verible
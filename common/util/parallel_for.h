@@ -0,0 +1,40 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_COMMON_UTIL_PARALLEL_FOR_H_
+#define VERIBLE_COMMON_UTIL_PARALLEL_FOR_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace verible {
+
+// Returns 'num_threads' if it is positive, or else the number of hardware
+// threads (at least 1).
+int ResolveNumThreads(int num_threads);
+
+// Calls task(i) for every i in [0, num_tasks), on up to 'num_threads' threads
+// (see ResolveNumThreads()), one of which is the calling thread.
+// Returns after all calls have returned.
+// Each thread claims the next unclaimed index when it is done with its last,
+// so that a few expensive tasks do not hold up the rest.  Tasks are claimed
+// in index order, so put the most expensive ones first.
+// With one thread (or one task), this runs all tasks in order on the calling
+// thread, without starting any other thread.
+void ParallelFor(size_t num_tasks, int num_threads,
+                 const std::function<void(size_t)>& task);
+
+}  // namespace verible
+
+#endif  // VERIBLE_COMMON_UTIL_PARALLEL_FOR_H_
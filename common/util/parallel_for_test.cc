@@ -0,0 +1,59 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/util/parallel_for.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace verible {
+namespace {
+
+TEST(ResolveNumThreadsTest, Positive) { EXPECT_EQ(ResolveNumThreads(3), 3); }
+
+TEST(ResolveNumThreadsTest, HardwareDefault) {
+  EXPECT_GE(ResolveNumThreads(0), 1);
+  EXPECT_GE(ResolveNumThreads(-1), 1);
+}
+
+TEST(ParallelForTest, NoTasks) {
+  ParallelFor(0, 4, [](size_t) { FAIL(); });
+}
+
+TEST(ParallelForTest, SingleThreadRunsInOrderOnCaller) {
+  const auto caller = std::this_thread::get_id();
+  std::vector<size_t> order;
+  ParallelFor(5, 1, [&](size_t i) {
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+    order.push_back(i);
+  });
+  EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(ParallelForTest, EveryTaskRunsOnce) {
+  constexpr size_t kNumTasks = 1000;
+  std::vector<std::atomic<int>> counts(kNumTasks);
+  for (auto& count : counts) count = 0;
+  for (int num_threads : {2, 4, 0}) {
+    ParallelFor(kNumTasks, num_threads, [&](size_t i) { ++counts[i]; });
+  }
+  for (const auto& count : counts) EXPECT_EQ(count, 3);
+}
+
+}  // namespace
+}  // namespace verible
@@ -279,7 +279,9 @@ class VectorTree : private _VectorTreeImpl {
     AdoptSubtree(std::forward<Args>(args)...);
   }
 
-  ~VectorTree() { CHECK(CheckIntegrity()); }
+  // Checking integrity is linear in the size of the subtree, and runs at
+  // every node's destruction, so it is only done in debug builds.
+  ~VectorTree() { DCHECK(CheckIntegrity()); }
 
   // Swaps values and subtrees of two nodes.
   // This operation is safe for unrelated trees (no common ancestor).
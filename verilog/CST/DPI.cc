@@ -22,7 +22,7 @@ using verible::Symbol;
 using verible::SyntaxTreeNode;
 
 std::vector<verible::TreeSearchMatch> FindAllDPIImports(const Symbol& root) {
-  return SearchSyntaxTree(root, NodekDPIImportItem());
+  return SearchSyntaxTree(root, StaticNodekDPIImportItem());
 }
 
 const SyntaxTreeNode& GetDPIImportPrototype(const Symbol& symbol) {
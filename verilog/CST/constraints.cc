@@ -33,7 +33,7 @@ namespace verilog {
 
 std::vector<verible::TreeSearchMatch> FindAllConstraintDeclarations(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekConstraintDeclaration());
+  return verible::SearchSyntaxTree(root, StaticNodekConstraintDeclaration());
 }
 
 bool IsOutOfLineConstraintDefinition(const verible::Symbol& symbol) {
@@ -59,20 +59,20 @@ NodeEnum DeclarationKeywordToNodeEnum(const Symbol& symbol) {
 
 std::vector<verible::TreeSearchMatch> FindAllDataDeclarations(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekDataDeclaration());
+  return SearchSyntaxTree(root, StaticNodekDataDeclaration());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllNetVariables(const Symbol& root) {
-  return SearchSyntaxTree(root, NodekNetVariable());
+  return SearchSyntaxTree(root, StaticNodekNetVariable());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllRegisterVariables(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekRegisterVariable());
+  return SearchSyntaxTree(root, StaticNodekRegisterVariable());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllGateInstances(const Symbol& root) {
-  return SearchSyntaxTree(root, NodekGateInstance());
+  return SearchSyntaxTree(root, StaticNodekGateInstance());
 }
 
 // Don't want to expose kInstantiationBase because it is an artificial grouping.
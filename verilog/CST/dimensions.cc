@@ -30,17 +30,17 @@ using verible::Symbol;
 
 std::vector<verible::TreeSearchMatch> FindAllPackedDimensions(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekPackedDimensions());
+  return SearchSyntaxTree(root, StaticNodekPackedDimensions());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllUnpackedDimensions(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekUnpackedDimensions());
+  return SearchSyntaxTree(root, StaticNodekUnpackedDimensions());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllDeclarationDimensions(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekDeclarationDimensions());
+  return SearchSyntaxTree(root, StaticNodekDeclarationDimensions());
 }
 
 const Symbol* GetDimensionRangeLeftBound(const Symbol& s) {
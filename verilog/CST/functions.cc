@@ -33,7 +33,7 @@ using verible::SyntaxTreeNode;
 
 std::vector<verible::TreeSearchMatch> FindAllFunctionDeclarations(
     const Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekFunctionDeclaration());
+  return verible::SearchSyntaxTree(root, StaticNodekFunctionDeclaration());
 }
 
 const verible::SyntaxTreeNode& GetFunctionHeader(const Symbol& function_decl) {
@@ -35,12 +35,12 @@ using verible::SymbolKind;
 
 std::vector<verible::TreeSearchMatch> FindAllUnqualifiedIds(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekUnqualifiedId());
+  return verible::SearchSyntaxTree(root, StaticNodekUnqualifiedId());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllQualifiedIds(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekQualifiedId());
+  return verible::SearchSyntaxTree(root, StaticNodekQualifiedId());
 }
 
 bool IdIsQualified(const verible::Symbol& symbol) {
@@ -28,12 +28,12 @@ using verible::SyntaxTreeNode;
 using verible::TokenInfo;
 
 std::vector<verible::TreeSearchMatch> FindAllMacroCalls(const Symbol& root) {
-  return SearchSyntaxTree(root, NodekMacroCall());
+  return SearchSyntaxTree(root, StaticNodekMacroCall());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllMacroGenericItems(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekMacroGenericItem());
+  return SearchSyntaxTree(root, StaticNodekMacroGenericItem());
 }
 
 const TokenInfo& GetMacroCallId(const Symbol& s) {
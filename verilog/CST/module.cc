@@ -34,7 +34,12 @@ using verible::TokenInfo;
 
 std::vector<verible::TreeSearchMatch> FindAllModuleDeclarations(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekModuleDeclaration());
+  return SearchSyntaxTree(root, StaticNodekModuleDeclaration());
+}
+
+std::vector<verible::TreeSearchMatch> FindAllInterfaceDeclarations(
+    const Symbol& root) {
+  return SearchSyntaxTree(root, StaticNodekInterfaceDeclaration());
 }
 
 const SyntaxTreeNode& GetModuleHeader(const Symbol& module_symbol) {
@@ -96,6 +96,27 @@ endclass
   EXPECT_EQ(module_declarations.size(), 2);
 }
 
+TEST(FindAllInterfaceDeclarationsTest, OnlyInterfaces) {
+  VerilogAnalyzer analyzer(R"(
+module mod1;
+endmodule
+interface if1;
+endinterface
+interface if2(input clk);
+endinterface
+)",
+                           "");
+  EXPECT_OK(analyzer.Analyze());
+  const auto& root = analyzer.Data().SyntaxTree();
+  const auto interface_declarations =
+      FindAllInterfaceDeclarations(*ABSL_DIE_IF_NULL(root));
+  ASSERT_EQ(interface_declarations.size(), 2);
+  EXPECT_EQ(GetInterfaceNameToken(*interface_declarations[0].match).text,
+            "if1");
+  EXPECT_EQ(GetInterfaceNameToken(*interface_declarations[1].match).text,
+            "if2");
+}
+
 TEST(GetModuleNameTokenTest, RootIsNotAModule) {
   VerilogAnalyzer analyzer("module foo; endmodule", "");
   EXPECT_OK(analyzer.Analyze());
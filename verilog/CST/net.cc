@@ -33,7 +33,7 @@ using verible::TokenInfo;
 
 std::vector<verible::TreeSearchMatch> FindAllNetDeclarations(
     const verible::Symbol& root) {
-  return SearchSyntaxTree(root, NodekNetDeclaration());
+  return SearchSyntaxTree(root, StaticNodekNetDeclaration());
 }
 
 // Helper predicate to match all types of applicable nets
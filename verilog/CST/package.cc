@@ -30,7 +30,7 @@ namespace verilog {
 
 std::vector<verible::TreeSearchMatch> FindAllPackageDeclarations(
     const verible::Symbol& root) {
-  return SearchSyntaxTree(root, NodekPackageDeclaration());
+  return SearchSyntaxTree(root, StaticNodekPackageDeclaration());
 }
 
 const verible::TokenInfo& GetPackageNameToken(const verible::Symbol& s) {
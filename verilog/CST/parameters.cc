@@ -39,7 +39,7 @@ using verible::SyntaxTreeLeaf;
 
 std::vector<verible::TreeSearchMatch> FindAllParamDeclarations(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekParamDeclaration());
+  return verible::SearchSyntaxTree(root, StaticNodekParamDeclaration());
 }
 
 verilog_tokentype GetParamKeyword(const verible::Symbol& symbol) {
@@ -100,7 +100,7 @@ std::vector<const verible::Symbol*> GetAllAssignedParameterSymbols(
     const verible::Symbol& root) {
   std::vector<const verible::Symbol*> symbols;
 
-  for (const auto& id : SearchSyntaxTree(root, NodekParameterAssign())) {
+  for (const auto& id : SearchSyntaxTree(root, StaticNodekParameterAssign())) {
     symbols.push_back(id.match);
   }
 
@@ -34,12 +34,12 @@ using verible::SyntaxTreeLeaf;
 
 std::vector<verible::TreeSearchMatch> FindAllModulePortDeclarations(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekPortDeclaration());
+  return SearchSyntaxTree(root, StaticNodekPortDeclaration());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllTaskFunctionPortDeclarations(
     const Symbol& root) {
-  return SearchSyntaxTree(root, NodekPortItem());
+  return SearchSyntaxTree(root, StaticNodekPortItem());
 }
 
 const SyntaxTreeLeaf* GetIdentifierFromModulePortDeclaration(
@@ -28,7 +28,7 @@ namespace verilog {
 
 std::vector<verible::TreeSearchMatch> FindAllTaskDeclarations(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekTaskDeclaration());
+  return verible::SearchSyntaxTree(root, StaticNodekTaskDeclaration());
 }
 
 const verible::SyntaxTreeNode& GetTaskHeader(const verible::Symbol& symbol) {
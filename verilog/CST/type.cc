@@ -30,32 +30,32 @@ namespace verilog {
 
 std::vector<verible::TreeSearchMatch> FindAllDataTypeDeclarations(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekDataType());
+  return verible::SearchSyntaxTree(root, StaticNodekDataType());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllTypeDeclarations(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekTypeDeclaration());
+  return verible::SearchSyntaxTree(root, StaticNodekTypeDeclaration());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllEnumTypes(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekEnumType());
+  return verible::SearchSyntaxTree(root, StaticNodekEnumType());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllStructTypes(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekStructType());
+  return verible::SearchSyntaxTree(root, StaticNodekStructType());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllUnionTypes(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekUnionType());
+  return verible::SearchSyntaxTree(root, StaticNodekUnionType());
 }
 
 std::vector<verible::TreeSearchMatch> FindAllInterfaceTypes(
     const verible::Symbol& root) {
-  return verible::SearchSyntaxTree(root, NodekInterfaceType());
+  return verible::SearchSyntaxTree(root, StaticNodekInterfaceType());
 }
 
 bool IsStorageTypeOfDataTypeSpecified(const verible::Symbol& symbol) {
@@ -16,6 +16,7 @@
 #define VERIBLE_VERILOG_CST_VERILOG_MATCHERS_H_
 
 #include "common/analysis/matcher/matcher_builders.h"
+#include "common/analysis/matcher/static_matchers.h"
 #include "common/text/symbol.h"
 #include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/parser/verilog_token_enum.h"
@@ -77,6 +78,30 @@ static const LeafMatcher<MacroCallId> MacroCallIdLeaf;
 #include "verilog/CST/verilog_nonterminals_foreach.inc"  // IWYU pragma: keep
 #undef CONSIDER
 
+// StaticNodeMatcher and StaticLeafMatcher are the compile-time counterparts
+// of NodeMatcher and LeafMatcher, which build static matchers
+// (see common/analysis/matcher/static_matchers.h).
+template <NodeEnum NodeTag>
+using StaticNodeMatcher =
+    verible::matcher::StaticTagMatchBuilder<verible::SymbolKind::kNode,
+                                            NodeEnum, NodeTag>;
+
+template <int LeafTag>
+using StaticLeafMatcher =
+    verible::matcher::StaticTagMatchBuilder<verible::SymbolKind::kLeaf, int,
+                                            LeafTag>;
+
+// Declare every syntax tree node static matcher.
+// StaticNodekFoo is the static counterpart of NodekFoo, e.g.
+//   SearchSyntaxTree(root, StaticNodekModuleDeclaration());
+// finds the same nodes as
+//   SearchSyntaxTree(root, NodekModuleDeclaration());
+// but faster.
+#define CONSIDER(tag) \
+  constexpr StaticNodeMatcher<NodeEnum::tag> StaticNode##tag{};
+#include "verilog/CST/verilog_nonterminals_foreach.inc"  // IWYU pragma: keep
+#undef CONSIDER
+
 // These matchers match on a specific type of AST Node
 
 // NodekGenerateBlock matches against generate blocks
@@ -0,0 +1,110 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares searching a syntax tree with the runtime matchers (NodekFoo)
+// against searching it with their static counterparts (StaticNodekFoo).
+//
+// Usage:
+//   bazel run -c opt //verilog/CST:verilog_matchers_benchmark
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "absl/memory/memory.h"
+#include "common/analysis/matcher/static_matchers.h"
+#include "common/analysis/syntax_tree_search.h"
+#include "common/text/symbol.h"
+#include "common/util/logging.h"
+#include "verilog/CST/verilog_matchers.h"
+#include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/parser/verilog_token_enum.h"
+
+namespace verilog {
+namespace {
+
+using verible::SearchSyntaxTree;
+
+constexpr char kRtlBlock[] = R"(
+module counter #(parameter int WIDTH = 8) (
+  input  logic             clk,
+  input  logic             rst_n,
+  input  logic             enable,
+  output logic [WIDTH-1:0] count
+);
+  logic [WIDTH-1:0] next_count;
+  always_comb begin
+    next_count = count;
+    if (enable) next_count = count + 1'b1;
+  end
+  always_ff @(posedge clk or negedge rst_n) begin
+    if (!rst_n) count <= '0;
+    else count <= next_count;
+  end
+  always @(posedge clk) begin
+    if (enable && &count) $display("wrap");
+  end
+endmodule
+)";
+
+// Parses kRtlBlock repeated 'count' times.
+std::unique_ptr<VerilogAnalyzer> ParseRtl(int count) {
+  std::string code;
+  code.reserve(count * sizeof(kRtlBlock));
+  for (int i = 0; i < count; ++i) code += kRtlBlock;
+  auto analyzer = absl::make_unique<VerilogAnalyzer>(code, "<benchmark>");
+  CHECK(analyzer->Analyze().ok());
+  return analyzer;
+}
+
+template <typename M>
+void SearchRtl(benchmark::State& state, const M& matcher) {
+  const auto analyzer = ParseRtl(state.range(0));
+  const auto& root = *analyzer->Data().SyntaxTree();
+  size_t num_matches = 0;
+  for (auto _ : state) {
+    num_matches = SearchSyntaxTree(root, matcher).size();
+    benchmark::DoNotOptimize(num_matches);
+  }
+  state.SetItemsProcessed(state.iterations() * num_matches);
+}
+
+// Searches for a single tag.
+void BM_SearchTag(benchmark::State& state) {
+  SearchRtl(state, NodekAlwaysStatement());
+}
+BENCHMARK(BM_SearchTag)->Arg(1)->Arg(64)->Arg(1024);
+
+void BM_SearchTagStatic(benchmark::State& state) {
+  SearchRtl(state, StaticNodekAlwaysStatement());
+}
+BENCHMARK(BM_SearchTagStatic)->Arg(1)->Arg(64)->Arg(1024);
+
+// Searches for a tag with a nested path, and binds what the path found.
+void BM_SearchPathBind(benchmark::State& state) {
+  SearchRtl(state, NodekAlwaysStatement(AlwaysFFKeyword().Bind("keyword")));
+}
+BENCHMARK(BM_SearchPathBind)->Arg(1)->Arg(64)->Arg(1024);
+
+void BM_SearchPathBindStatic(benchmark::State& state) {
+  const auto always_ff_keyword =
+      verible::matcher::MakeStaticPathMatcher({verible::LeafTag(TK_always_ff)});
+  SearchRtl(state, StaticNodekAlwaysStatement(
+                       always_ff_keyword().Bind("keyword")));
+}
+BENCHMARK(BM_SearchPathBindStatic)->Arg(1)->Arg(64)->Arg(1024);
+
+}  // namespace
+}  // namespace verilog
@@ -68,7 +68,7 @@ void AlwaysCombBlockingRule::HandleSymbol(const verible::Symbol& symbol,
           *node, NodeEnum::kNonblockingAssignmentStatement, 1);
 
       if (leaf.get().token_enum == TK_LE)
-        violations_.insert(LintViolation(leaf, kMessage, match.context));
+        violations_.push_back(LintViolation(leaf, kMessage, match.context));
     }
   }
 }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_ALWAYS_COMB_BLOCKING_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_ALWAYS_COMB_BLOCKING_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -42,6 +41,8 @@ class AlwaysCombBlockingRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -55,8 +56,6 @@ class AlwaysCombBlockingRule : public verible::SyntaxTreeLintRule {
 
   const Matcher always_comb_matcher_ =
       NodekAlwaysStatement(AlwaysCombKeyword());
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -55,7 +55,7 @@ void AlwaysCombRule::HandleSymbol(const verible::Symbol& symbol,
   // Check for offending use of always @*
   verible::matcher::BoundSymbolManager manager;
   if (always_star_matcher_.Matches(symbol, &manager)) {
-    violations_.insert(LintViolation(symbol, kMessage, context));
+    violations_.push_back(LintViolation(symbol, kMessage, context));
   }
 }
 
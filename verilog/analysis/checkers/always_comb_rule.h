@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_ALWAYS_COMB_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_ALWAYS_COMB_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -45,6 +44,8 @@ class AlwaysCombRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -63,8 +64,6 @@ class AlwaysCombRule : public verible::SyntaxTreeLintRule {
   //   end
   const Matcher always_star_matcher_ = NodekAlwaysStatement(
       AlwaysKeyword(), AlwaysStatementHasEventControlStar());
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -74,7 +74,7 @@ void AlwaysFFNonBlockingRule::HandleSymbol(const verible::Symbol &symbol,
       if (leaf == nullptr) continue;
 
       if (leaf->get().token_enum == '=')
-        violations_.insert(LintViolation(*leaf, kMessage, match.context));
+        violations_.push_back(LintViolation(*leaf, kMessage, match.context));
     }
   }
 }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_ALWAYS_FF_NON_BLOCKING_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_ALWAYS_FF_NON_BLOCKING_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -42,6 +41,8 @@ class AlwaysFFNonBlockingRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -54,8 +55,6 @@ class AlwaysFFNonBlockingRule : public verible::SyntaxTreeLintRule {
   using Matcher = verible::matcher::Matcher;
 
   const Matcher always_ff_matcher_ = NodekAlwaysStatement(AlwaysFFKeyword());
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -55,7 +55,7 @@ void CaseMissingDefaultRule::HandleSymbol(
   verible::matcher::BoundSymbolManager manager;
   if (context.DirectParentIs(NodeEnum::kCaseStatement) &&
       matcher_.Matches(symbol, &manager)) {
-    violations_.insert(LintViolation(symbol, kMessage, context));
+    violations_.push_back(LintViolation(symbol, kMessage, context));
   }
 }
 
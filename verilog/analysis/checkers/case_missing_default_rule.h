@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_CASE_MISSING_DEFAULT_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_CASE_MISSING_DEFAULT_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -45,6 +44,8 @@ class CaseMissingDefaultRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -58,8 +59,6 @@ class CaseMissingDefaultRule : public verible::SyntaxTreeLintRule {
 
   Matcher matcher_ =
       NodekCaseItemList(verible::matcher::Unless(HasDefaultCase()));
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -77,7 +77,7 @@ void ConstraintNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
 
     if (!verible::IsLowerSnakeCaseWithDigits(constraint_name) ||
         !absl::EndsWith(constraint_name, "_c"))
-      violations_.insert(LintViolation(identifier_token, kMessage, context));
+      violations_.push_back(LintViolation(identifier_token, kMessage, context));
   }
 }
 
@@ -180,7 +180,7 @@ void CreateObjectNameMatchRule::HandleSymbol(const verible::Symbol& symbol,
     if (const auto* expr = GetFirstExpressionFromArgs(*args)) {
       if (const TokenInfo* name_token = ExtractStringLiteralToken(*expr)) {
         if (StripOuterQuotes(name_token->text) != lval_token.text) {
-          violations_.insert(LintViolation(
+          violations_.push_back(LintViolation(
               *name_token, FormatReason(lval_token.text, name_token->text)));
         }
       }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_CREATE_OBJECT_NAME_MATCH_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_CREATE_OBJECT_NAME_MATCH_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -53,6 +52,8 @@ class CreateObjectNameMatchRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -76,9 +77,6 @@ class CreateObjectNameMatchRule : public verible::SyntaxTreeLintRule {
           verible::matcher::Unless(ReferenceHasIndex())),
       RValueIsFunctionCall(FunctionCallIsQualified().Bind("func"),
                            FunctionCallArguments().Bind("args")));
-
-  // Record of found violations.
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
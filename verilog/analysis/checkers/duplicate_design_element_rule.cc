@@ -0,0 +1,75 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "verilog/analysis/checkers/duplicate_design_element_rule.h"
+
+#include <map>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/citation.h"
+#include "common/analysis/lint_rule_status.h"
+#include "verilog/analysis/descriptions.h"
+#include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/project_declaration_index.h"
+
+namespace verilog {
+namespace analysis {
+
+using verible::GetStyleGuideCitation;
+using verible::LintRuleStatus;
+
+// Register DuplicateDesignElementRule
+VERILOG_REGISTER_LINT_RULE(DuplicateDesignElementRule);
+
+absl::string_view DuplicateDesignElementRule::Name() {
+  return "duplicate-design-element";
+}
+const char DuplicateDesignElementRule::kTopic[] = "naming";
+
+std::string DuplicateDesignElementRule::GetDescription(
+    DescriptionType description_type) {
+  return absl::StrCat(
+      "Checks that no module, interface, or package name is declared more "
+      "than once across the files of a project.  Only checked with ",
+      Codify("--project_mode", description_type), ".  See ",
+      GetStyleGuideCitation(kTopic), ".");
+}
+
+void DuplicateDesignElementRule::Lint(const ProjectDeclarationIndex& index) {
+  // First declaration of every name.  Modules, interfaces, and packages share
+  // one namespace here, because tools differ in how they separate them.
+  std::map<absl::string_view, const DesignElementSymbol*> declared;
+  for (const auto& declaration : index.Declarations()) {
+    const auto inserted = declared.emplace(declaration.name, &declaration);
+    if (inserted.second) continue;
+    const DesignElementSymbol& first = *inserted.first->second;
+    project_violations_.push_back(
+        {&declaration,
+         absl::StrCat(DesignElementKindName(declaration.kind), " name \"",
+                      declaration.name, "\" is already declared as a ",
+                      DesignElementKindName(first.kind), " at ",
+                      first.filename, ":", first.position.line + 1, ":",
+                      first.position.column + 1, ".")});
+  }
+}
+
+LintRuleStatus DuplicateDesignElementRule::Report() const {
+  return LintRuleStatus(violations_, Name(), GetStyleGuideCitation(kTopic));
+}
+
+}  // namespace analysis
+}  // namespace verilog
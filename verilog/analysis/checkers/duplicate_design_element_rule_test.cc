@@ -0,0 +1,57 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "verilog/analysis/checkers/duplicate_design_element_rule.h"
+
+#include "gtest/gtest.h"
+#include "verilog/analysis/project_declaration_index.h"
+#include "verilog/analysis/project_declaration_index_test_utils.h"
+
+namespace verilog {
+namespace analysis {
+namespace {
+
+TEST(DuplicateDesignElementRuleTest, UniqueNames) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("package p;\nendpackage\nmodule m;\nendmodule\n", "a.sv",
+                 &index);
+  AddCodeToIndex("interface i;\nendinterface\n", "b.sv", &index);
+  index.Sort();
+  DuplicateDesignElementRule rule;
+  rule.Lint(index);
+  EXPECT_TRUE(rule.Violations().empty());
+}
+
+TEST(DuplicateDesignElementRuleTest, LaterDeclarationsAreDuplicates) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("module m;\nendmodule\n", "b.sv", &index);
+  AddCodeToIndex("module m;\nendmodule\npackage m;\nendpackage\n", "a.sv",
+                 &index);
+  index.Sort();
+  DuplicateDesignElementRule rule;
+  rule.Lint(index);
+  const auto& violations = rule.Violations();
+  ASSERT_EQ(violations.size(), 2);
+  EXPECT_EQ(violations[0].symbol->filename, "a.sv");
+  EXPECT_EQ(violations[0].symbol->position.line, 2);
+  EXPECT_EQ(violations[0].reason,
+            "package name \"m\" is already declared as a module at a.sv:1:8.");
+  EXPECT_EQ(violations[1].symbol->filename, "b.sv");
+  EXPECT_EQ(violations[1].symbol->position.line, 0);
+}
+
+}  // namespace
+}  // namespace analysis
+}  // namespace verilog
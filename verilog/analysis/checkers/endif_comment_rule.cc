@@ -107,7 +107,7 @@ void EndifCommentRule::HandleToken(const TokenInfo& token) {
           const absl::string_view contents =
               verible::StripCommentAndSpacePadding(token.text);
           if (contents != expect) {
-            violations_.insert(LintViolation(
+            violations_.push_back(LintViolation(
                 last_endif_, absl::StrCat(kMessage, " (", expect, ")")));
           }
           conditional_scopes_.pop();
@@ -116,7 +116,7 @@ void EndifCommentRule::HandleToken(const TokenInfo& token) {
         }
         default:
           // includes TK_NEWLINE and TK_EOF.
-          violations_.insert(LintViolation(
+          violations_.push_back(LintViolation(
               last_endif_, absl::StrCat(kMessage, " (", expect, ")")));
           conditional_scopes_.pop();
           state_ = State::kNormal;
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_ENDIF_COMMENT_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_ENDIF_COMMENT_RULE_H_
 
-#include <set>
 #include <stack>
 #include <string>
 
@@ -81,9 +80,6 @@ class EndifCommentRule : public verible::TokenStreamLintRule {
 
   // Stack of nested preprocessor conditionals.
   std::stack<verible::TokenInfo> conditional_scopes_;
-
-  // Collection of found violations.
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
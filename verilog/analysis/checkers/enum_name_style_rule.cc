@@ -63,7 +63,7 @@ void EnumNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
       const auto name = ABSL_DIE_IF_NULL(identifier_leaf)->get().text;
       if (!verible::IsLowerSnakeCaseWithDigits(name) ||
           !(absl::EndsWith(name, "_t") || absl::EndsWith(name, "_e"))) {
-        violations_.insert(
+        violations_.push_back(
             LintViolation(identifier_leaf->get(), kMessage, context));
       }
     } else {
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_ENUM_NAME_STYLE_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_ENUM_NAME_STYLE_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -44,6 +43,8 @@ class EnumNameStyleRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -56,8 +57,6 @@ class EnumNameStyleRule : public verible::SyntaxTreeLintRule {
   using Matcher = verible::matcher::Matcher;
 
   Matcher matcher_typedef_ = NodekTypeDeclaration();
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
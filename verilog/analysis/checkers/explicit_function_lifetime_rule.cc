@@ -74,7 +74,7 @@ void ExplicitFunctionLifetimeRule::HandleSymbol(
       // Point to the function id.
       const verible::TokenInfo token(SymbolIdentifier,
                                      verible::StringSpanOfSymbol(*function_id));
-      violations_.insert(LintViolation(token, kMessage, context));
+      violations_.push_back(LintViolation(token, kMessage, context));
     }
   }
 }
@@ -64,7 +64,7 @@ void ExplicitFunctionTaskParameterTypeRule::HandleSymbol(
     const auto* type_node = GetTypeOfTaskFunctionPortItem(symbol);
     if (!IsStorageTypeOfDataTypeSpecified(*ABSL_DIE_IF_NULL(type_node))) {
       const auto* port_id = GetIdentifierFromTaskFunctionPortItem(symbol);
-      violations_.insert(LintViolation(*port_id, kMessage, context));
+      violations_.push_back(LintViolation(*port_id, kMessage, context));
     }
   }
 }
@@ -86,7 +86,7 @@ void ExplicitParameterStorageTypeRule::HandleSymbol(
     if (IsTypeInfoEmpty(*ABSL_DIE_IF_NULL(type_info_symbol))) {
       if (exempt_string_ && HasStringAssignment(symbol)) return;
       const verible::TokenInfo& param_name = GetParameterNameToken(symbol);
-      violations_.insert(LintViolation(
+      violations_.push_back(LintViolation(
           param_name, absl::StrCat(kMessage, "(", param_name.text, ")."),
           context));
     }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_EXPLICIT_PARAMETER_STORAGE_TYPE_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_EXPLICIT_PARAMETER_STORAGE_TYPE_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -44,6 +43,8 @@ class ExplicitParameterStorageTypeRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
   absl::Status Configure(absl::string_view configuration) override;
@@ -61,8 +62,6 @@ class ExplicitParameterStorageTypeRule : public verible::SyntaxTreeLintRule {
   using Matcher = verible::matcher::Matcher;
 
   Matcher matcher_ = NodekParamDeclaration();
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -74,7 +74,7 @@ void ExplicitTaskLifetimeRule::HandleSymbol(const verible::Symbol& symbol,
       // Point to the task id.
       const verible::TokenInfo token(SymbolIdentifier,
                                      verible::StringSpanOfSymbol(*task_id));
-      violations_.insert(LintViolation(token, kMessage, context));
+      violations_.push_back(LintViolation(token, kMessage, context));
     }
   }
 }
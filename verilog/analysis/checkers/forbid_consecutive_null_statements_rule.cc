@@ -68,7 +68,7 @@ void ForbidConsecutiveNullStatementsRule::HandleLeaf(
 
       case State::kExpectNonSemicolon: {
         if (leaf.Tag().tag == ';') {
-          violations_.insert(LintViolation(leaf, kMessage, context));
+          violations_.push_back(LintViolation(leaf, kMessage, context));
         } else {
           state_ = State::kNormal;
         }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_FORBID_CONSECUTIVE_NULL_STATEMENTS_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_FORBID_CONSECUTIVE_NULL_STATEMENTS_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -63,8 +62,6 @@ class ForbidConsecutiveNullStatementsRule : public verible::SyntaxTreeLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -52,7 +52,7 @@ void ForbidDefparamRule::HandleSymbol(
     const auto& defparam_token =
         GetSubtreeAsLeaf(symbol, NodeEnum::kParameterOverride, 0).get();
     CHECK_EQ(defparam_token.token_enum, TK_defparam);
-    violations_.insert(
+    violations_.push_back(
         verible::LintViolation(defparam_token, kMessage, context));
   }
 }
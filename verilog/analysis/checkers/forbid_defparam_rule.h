@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_FORBID_DEFPARAM_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_FORBID_DEFPARAM_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -44,6 +43,8 @@ class ForbidDefparamRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -55,8 +56,6 @@ class ForbidDefparamRule : public verible::SyntaxTreeLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -58,7 +58,7 @@ void ForbiddenAnonymousEnumsRule::HandleSymbol(
     // Check if it is preceded by a typedef
     if (!context.DirectParentsAre(
             {NodeEnum::kDataTypePrimitive, NodeEnum::kTypeDeclaration})) {
-      violations_.insert(LintViolation(symbol, kMessage, context));
+      violations_.push_back(LintViolation(symbol, kMessage, context));
     }
   }
 }
@@ -90,9 +90,9 @@ void ForbiddenAnonymousStructsUnionsRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
   if (matcher_struct_.Matches(symbol, &manager) && !IsRuleMet(context)) {
-    violations_.insert(LintViolation(symbol, kMessageStruct, context));
+    violations_.push_back(LintViolation(symbol, kMessageStruct, context));
   } else if (matcher_union_.Matches(symbol, &manager) && !IsRuleMet(context)) {
-    violations_.insert(LintViolation(symbol, kMessageUnion, context));
+    violations_.push_back(LintViolation(symbol, kMessageUnion, context));
   }
 }
 
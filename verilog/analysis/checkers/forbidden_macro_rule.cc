@@ -67,7 +67,7 @@ void ForbiddenMacroRule::HandleSymbol(
     if (auto leaf = manager.GetAs<verible::SyntaxTreeLeaf>("name")) {
       const auto& imm = InvalidMacrosMap();
       if (imm.find(std::string(leaf->get().text)) != imm.end()) {
-        violations_.insert(
+        violations_.push_back(
             verible::LintViolation(leaf->get(), FormatReason(*leaf), context));
       }
     }
@@ -85,7 +85,7 @@ void ForbiddenSystemTaskFunctionRule::HandleSymbol(
     if (auto leaf = manager.GetAs<verible::SyntaxTreeLeaf>("name")) {
       const auto& ism = InvalidSymbolsMap();
       if (ism.find(std::string(leaf->get().text)) != ism.end()) {
-        violations_.insert(
+        violations_.push_back(
             verible::LintViolation(leaf->get(), FormatReason(*leaf), context));
       }
     }
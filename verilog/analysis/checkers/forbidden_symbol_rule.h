@@ -16,7 +16,6 @@
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_FORBIDDEN_SYMBOL_RULE_H_
 
 #include <map>
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -53,6 +52,8 @@ class ForbiddenSystemTaskFunctionRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -66,9 +67,6 @@ class ForbiddenSystemTaskFunctionRule : public verible::SyntaxTreeLintRule {
 
   const verible::matcher::Matcher matcher_ =
       SystemTFIdentifierLeaf().Bind("name");
-
- private:
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
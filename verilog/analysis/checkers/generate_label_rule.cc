@@ -51,7 +51,7 @@ void GenerateLabelRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
   if (matcher_.Matches(symbol, &manager)) {
-    violations_.insert(verible::LintViolation(symbol, kMessage, context));
+    violations_.push_back(verible::LintViolation(symbol, kMessage, context));
   }
 }
 
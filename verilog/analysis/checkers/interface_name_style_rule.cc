@@ -66,7 +66,8 @@ void InterfaceNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
 
     if (!verible::IsLowerSnakeCaseWithDigits(name) ||
         !absl::EndsWith(name, "_if")) {
-      violations_.insert(LintViolation(*identifier_token, kMessage, context));
+      violations_.push_back(
+          LintViolation(*identifier_token, kMessage, context));
     }
   }
 }
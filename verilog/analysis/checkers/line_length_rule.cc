@@ -162,9 +162,13 @@ static bool AllowLongLineException(TokenSequence::const_iterator token_begin,
 
 void LineLengthRule::Lint(const TextStructureView& text_structure,
                           absl::string_view) {
-  size_t lineno = 0;
-  for (const auto& line : text_structure.Lines()) {
+  const auto& lines = text_structure.Lines();
+  for (size_t lineno = 0; lineno < lines.size(); ++lineno) {
+    const absl::string_view line = lines[lineno];
     VLOG(2) << "Examining line: " << lineno + 1;
+    // A line has no more characters than bytes, so only lines that are too
+    // long in bytes need their characters counted.
+    if (static_cast<int>(line.length()) <= line_length_limit_) continue;
     const int observed_line_length = verible::utf8_len(line);
     if (observed_line_length > line_length_limit_) {
       const auto token_range = text_structure.TokenRangeOnLine(lineno);
@@ -175,10 +179,9 @@ void LineLengthRule::Lint(const TextStructureView& text_structure,
         TokenInfo token(TK_OTHER, line.substr(line_length_limit_));
         const std::string msg = absl::StrCat(kMessage, line_length_limit_,
                                              "; is: ", observed_line_length);
-        violations_.insert(LintViolation(token, msg));
+        violations_.push_back(LintViolation(token, msg));
       }
     }
-    ++lineno;
   }
 }
 
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_LINE_LENGTH_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_LINE_LENGTH_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "absl/status/status.h"
@@ -54,6 +53,11 @@ class LineLengthRule : public verible::TextStructureLintRule {
 
   void Lint(const verible::TextStructureView&, absl::string_view) override;
 
+  // Long-line exceptions are determined by the tokens on each line.
+  verible::TextAnalysisLevel RequiredAnalysisLevel() const override {
+    return verible::TextAnalysisLevel::kTokens;
+  }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -64,9 +68,6 @@ class LineLengthRule : public verible::TextStructureLintRule {
   static const char kMessage[];
 
   int line_length_limit_ = kDefaultLineLength;
-
-  // Collection of found violations.
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -71,7 +71,7 @@ void MacroNameStyleRule::HandleToken(const TokenInfo& token) {
           break;
         case PP_Identifier: {
           if (!verible::IsNameAllCapsUnderscoresDigits(token.text))
-            violations_.insert(LintViolation(token, kMessage));
+            violations_.push_back(LintViolation(token, kMessage));
           state_ = State::kNormal;
           break;
         }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_MACRO_NAME_STYLE_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_MACRO_NAME_STYLE_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -58,8 +57,6 @@ class MacroNameStyleRule : public verible::TokenStreamLintRule {
 
   // Internal lexical analysis state.
   State state_;
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -71,7 +71,7 @@ void MismatchedLabelsRule::HandleSymbol(
 
     // Error if there is no begin label
     if (begin_label == nullptr) {
-      violations_.insert(
+      violations_.push_back(
           verible::LintViolation(symbol, kMessageMissing, context));
 
       return;
@@ -79,7 +79,7 @@ void MismatchedLabelsRule::HandleSymbol(
 
     // Finally compare the two labels
     if (begin_label->text != end_label->text) {
-      violations_.insert(
+      violations_.push_back(
           verible::LintViolation(*end_label, kMessageMismatch, context));
     }
   }
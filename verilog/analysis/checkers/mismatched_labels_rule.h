@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_MISMATCHED_LABELS_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_MISMATCHED_LABELS_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -45,6 +44,8 @@ class MismatchedLabelsRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -57,8 +58,6 @@ class MismatchedLabelsRule : public verible::SyntaxTreeLintRule {
   // Diagnostic message.
   static const char kMessageMismatch[];
   static const char kMessageMissing[];
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
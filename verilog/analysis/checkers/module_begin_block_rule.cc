@@ -52,7 +52,7 @@ void ModuleBeginBlockRule::HandleSymbol(
     const verible::Symbol& symbol, const verible::SyntaxTreeContext& context) {
   verible::matcher::BoundSymbolManager manager;
   if (matcher_.Matches(symbol, &manager)) {
-    violations_.insert(verible::LintViolation(symbol, kMessage, context));
+    violations_.push_back(verible::LintViolation(symbol, kMessage, context));
   }
 }
 
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_MODULE_BEGIN_BLOCK_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_MODULE_BEGIN_BLOCK_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -51,6 +50,8 @@ class ModuleBeginBlockRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -62,8 +63,6 @@ class ModuleBeginBlockRule : public verible::SyntaxTreeLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
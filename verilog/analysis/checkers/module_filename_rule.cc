@@ -35,6 +35,7 @@
 #include "verilog/CST/verilog_matchers.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/verilog_declaration_index.h"
 
 namespace verilog {
 namespace analysis {
@@ -72,7 +73,8 @@ void ModuleFilenameRule::Lint(const TextStructureView& text_structure,
   if (tree == nullptr) return;
 
   // Find all module declarations.
-  auto module_matches = FindAllModuleDeclarations(*tree);
+  const auto& module_matches =
+      VerilogDeclarationIndex::Get(text_structure).ModuleDeclarations();
 
   // If there are no modules in this source unit, suppress finding.
   if (module_matches.empty()) return;
@@ -83,7 +85,7 @@ void ModuleFilenameRule::Lint(const TextStructureView& text_structure,
   std::back_insert_iterator<std::vector<verible::TreeSearchMatch>> back_it(
       module_cleaned);
   std::remove_copy_if(module_matches.begin(), module_matches.end(), back_it,
-                      [](verible::TreeSearchMatch& m) {
+                      [](const verible::TreeSearchMatch& m) {
                         return m.context.IsInside(NodeEnum::kModuleDeclaration);
                       });
 
@@ -105,7 +107,7 @@ void ModuleFilenameRule::Lint(const TextStructureView& text_structure,
 
   // Only report a violation on the last module declaration.
   const auto& last_module_id = GetModuleNameToken(*module_cleaned.back().match);
-  violations_.insert(verible::LintViolation(
+  violations_.push_back(verible::LintViolation(
       last_module_id, absl::StrCat(kMessage, "\"", unitname, "\"")));
 }
 
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_MODULE_FILENAME_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_MODULE_FILENAME_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -49,9 +48,6 @@ class ModuleFilenameRule : public verible::TextStructureLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  // Collection of found violations.
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_MODULE_INSTANTIATION_RULES_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_MODULE_INSTANTIATION_RULES_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -44,6 +43,8 @@ class ModuleParameterRule : public verible::SyntaxTreeLintRule {
 
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -59,8 +60,6 @@ class ModuleParameterRule : public verible::SyntaxTreeLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  std::set<verible::LintViolation> violations_;
 };
 
 // ModuleParamRule is an implementation of LintRule that handles incorrect
@@ -76,6 +75,8 @@ class ModulePortRule : public verible::SyntaxTreeLintRule {
 
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -96,8 +97,6 @@ class ModulePortRule : public verible::SyntaxTreeLintRule {
   // Returns false if a port list node is in violation of this rule and
   // true if it is not.
   bool IsPortListCompliant(const verible::SyntaxTreeNode& port_list_node) const;
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -17,11 +17,13 @@
 #include <cstddef>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/citation.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/byte_scanner.h"
 #include "common/text/token_info.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
@@ -55,7 +57,18 @@ void NoTabsRule::HandleLine(absl::string_view line) {
   const auto tab_pos = line.find('\t');
   if (tab_pos != absl::string_view::npos) {
     TokenInfo token(TK_SPACE, line.substr(tab_pos, 1));
-    violations_.insert(LintViolation(token, kMessage));
+    violations_.push_back(LintViolation(token, kMessage));
+  }
+}
+
+void NoTabsRule::HandleText(absl::string_view text) {
+  // Like HandleLine(), reports only the first tab of each line.
+  std::vector<int> tab_offsets;
+  verible::AppendFirstTabOffsets(text, &tab_offsets);
+  for (const int offset : tab_offsets) {
+    if (ReachedViolationLimit()) return;
+    TokenInfo token(TK_SPACE, text.substr(offset, 1));
+    violations_.push_back(LintViolation(token, kMessage));
   }
 }
 
@@ -21,11 +21,13 @@
 #include <iterator>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/citation.h"
 #include "common/analysis/lint_rule_status.h"
+#include "common/strings/byte_scanner.h"
 #include "common/text/token_info.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
@@ -65,11 +67,21 @@ void NoTrailingSpacesRule::HandleLine(absl::string_view line) {
     if (trailing != 0) {
       const int column = line.length() - trailing;
       const TokenInfo token(TK_SPACE, line.substr(column));
-      violations_.insert(LintViolation(token, kMessage));
+      violations_.push_back(LintViolation(token, kMessage));
     }
   }
 }
 
+void NoTrailingSpacesRule::HandleText(absl::string_view text) {
+  std::vector<absl::string_view> trailing_spaces;
+  verible::AppendTrailingWhitespace(text, &trailing_spaces);
+  for (const auto spaces : trailing_spaces) {
+    if (ReachedViolationLimit()) return;
+    const TokenInfo token(TK_SPACE, spaces);
+    violations_.push_back(LintViolation(token, kMessage));
+  }
+}
+
 LintRuleStatus NoTrailingSpacesRule::Report() const {
   return LintRuleStatus(violations_, Name(), GetStyleGuideCitation(kTopic));
 }
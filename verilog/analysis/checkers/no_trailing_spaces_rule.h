@@ -17,7 +17,6 @@
 
 #include <stddef.h>
 
-#include <set>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -42,6 +41,8 @@ class NoTrailingSpacesRule : public verible::LineLintRule {
 
   void HandleLine(absl::string_view line) override;
 
+  void HandleText(absl::string_view text) override;
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -50,9 +51,6 @@ class NoTrailingSpacesRule : public verible::LineLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  // Collection of found violations.
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
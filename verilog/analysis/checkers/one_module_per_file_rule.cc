@@ -35,6 +35,7 @@
 #include "verilog/CST/verilog_matchers.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/verilog_declaration_index.h"
 
 namespace verilog {
 namespace analysis {
@@ -63,7 +64,8 @@ void OneModulePerFileRule::Lint(const TextStructureView& text_structure,
   const auto& tree = text_structure.SyntaxTree();
   if (tree == nullptr) return;
 
-  auto module_matches = FindAllModuleDeclarations(*tree);
+  const auto& module_matches =
+      VerilogDeclarationIndex::Get(text_structure).ModuleDeclarations();
   if (module_matches.empty()) {
     return;
   }
@@ -74,14 +76,14 @@ void OneModulePerFileRule::Lint(const TextStructureView& text_structure,
   std::back_insert_iterator<std::vector<verible::TreeSearchMatch>> back_it(
       module_cleaned);
   std::remove_copy_if(module_matches.begin(), module_matches.end(), back_it,
-                      [](verible::TreeSearchMatch& m) {
+                      [](const verible::TreeSearchMatch& m) {
                         return m.context.IsInside(NodeEnum::kModuleDeclaration);
                       });
 
   if (module_cleaned.size() > 1) {
     // Report second module declaration
     const auto& second_module_id = GetModuleNameToken(*module_cleaned[1].match);
-    violations_.insert(verible::LintViolation(
+    violations_.push_back(verible::LintViolation(
         second_module_id, absl::StrCat(kMessage, module_cleaned.size())));
   }
 }
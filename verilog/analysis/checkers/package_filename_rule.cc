@@ -32,6 +32,7 @@
 #include "verilog/CST/package.h"
 #include "verilog/analysis/descriptions.h"
 #include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/verilog_declaration_index.h"
 
 namespace verilog {
 namespace analysis {
@@ -63,7 +64,8 @@ void PackageFilenameRule::Lint(const TextStructureView& text_structure,
   if (tree == nullptr) return;
 
   // Find all package declarations.
-  auto package_matches = FindAllPackageDeclarations(*tree);
+  const auto& package_matches =
+      VerilogDeclarationIndex::Get(text_structure).PackageDeclarations();
 
   // See if names match the stem of the filename.
   //
@@ -87,7 +89,7 @@ void PackageFilenameRule::Lint(const TextStructureView& text_structure,
     absl::string_view package_id = package_name_token.text;
     auto package_id_plus_suffix = absl::StrCat(package_id, optional_suffix);
     if ((package_id != unitname) && (package_id_plus_suffix != unitname)) {
-      violations_.insert(verible::LintViolation(
+      violations_.push_back(verible::LintViolation(
           package_name_token,
           absl::StrCat(kMessage, "declaration: \"", package_id,
                        "\" vs. basename(file): \"", unitname, "\"")));
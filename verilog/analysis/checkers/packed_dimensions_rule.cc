@@ -82,7 +82,7 @@ void PackedDimensionsRule::HandleSymbol(
         (left_is_constant && right_is_constant && left_value < right_value)) {
       const verible::TokenInfo token(TK_OTHER,
                                      verible::StringSpanOfSymbol(left, right));
-      violations_.insert(LintViolation(token, kMessage, context));
+      violations_.push_back(LintViolation(token, kMessage, context));
     }
   }
 }
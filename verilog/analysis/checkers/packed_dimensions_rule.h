@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_PACKED_DIMENSIONS_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_PACKED_DIMENSIONS_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -43,6 +42,8 @@ class PackedDimensionsRule : public verible::SyntaxTreeLintRule {
 
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -53,8 +54,6 @@ class PackedDimensionsRule : public verible::SyntaxTreeLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
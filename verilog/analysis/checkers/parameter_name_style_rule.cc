@@ -105,12 +105,12 @@ void ParameterNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
 
       if (param_decl_token == TK_localparam && localparam_allowed_style_ &&
           (observed_style & localparam_allowed_style_) == 0) {
-        violations_.insert(LintViolation(
+        violations_.push_back(LintViolation(
             *id, ViolationMsg("localparam", localparam_allowed_style_),
             context));
       } else if (param_decl_token == TK_parameter && parameter_allowed_style_ &&
                  (observed_style & parameter_allowed_style_) == 0) {
-        violations_.insert(LintViolation(
+        violations_.push_back(LintViolation(
             *id, ViolationMsg("parameter", parameter_allowed_style_), context));
       }
     }
@@ -16,7 +16,6 @@
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_PARAMETER_NAME_STYLE_RULE_H_
 
 #include <cstdint>
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -49,6 +48,8 @@ class ParameterNameStyleRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -70,8 +71,6 @@ class ParameterNameStyleRule : public verible::SyntaxTreeLintRule {
   using Matcher = verible::matcher::Matcher;
 
   Matcher matcher_ = NodekParamDeclaration();
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
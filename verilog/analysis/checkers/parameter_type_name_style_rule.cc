@@ -72,7 +72,8 @@ void ParameterTypeNameStyleRule::HandleSymbol(
 
     if (!verible::IsLowerSnakeCaseWithDigits(param_name) ||
         !absl::EndsWith(param_name, "_t"))
-      violations_.insert(LintViolation(*param_name_token, kMessage, context));
+      violations_.push_back(
+          LintViolation(*param_name_token, kMessage, context));
   }
 }
 
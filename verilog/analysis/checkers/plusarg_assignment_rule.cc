@@ -56,7 +56,7 @@ void PlusargAssignmentRule::HandleSymbol(
   if (matcher_.Matches(symbol, &manager)) {
     if (auto leaf = manager.GetAs<verible::SyntaxTreeLeaf>("name")) {
       if (kForbiddenFunctionName == leaf->get().text) {
-        violations_.insert(
+        violations_.push_back(
             verible::LintViolation(leaf->get(), FormatReason(), context));
       }
     }
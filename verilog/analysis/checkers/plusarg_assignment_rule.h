@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_PLUSARG_ASSIGNMENT_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_PLUSARG_ASSIGNMENT_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -52,6 +51,8 @@ class PlusargAssignmentRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -65,9 +66,6 @@ class PlusargAssignmentRule : public verible::SyntaxTreeLintRule {
 
   const verible::matcher::Matcher matcher_ =
       SystemTFIdentifierLeaf().Bind("name");
-
- private:
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
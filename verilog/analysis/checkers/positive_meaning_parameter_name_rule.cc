@@ -70,7 +70,7 @@ void PositiveMeaningParameterNameRule::HandleSymbol(
       const auto param_name = id->text;
 
       if (absl::StartsWithIgnoreCase(param_name, "disable"))
-        violations_.insert(LintViolation(
+        violations_.push_back(LintViolation(
             *id, absl::StrCat(kMessage, "  (got: ", param_name, ")"), context));
     }
   }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_POSIX_EOF_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_POSIX_EOF_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -48,6 +47,10 @@ class PosixEOFRule : public verible::TextStructureLintRule {
 
   void Lint(const verible::TextStructureView&, absl::string_view) override;
 
+  verible::TextAnalysisLevel RequiredAnalysisLevel() const override {
+    return verible::TextAnalysisLevel::kLines;
+  }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -56,9 +59,6 @@ class PosixEOFRule : public verible::TextStructureLintRule {
 
   // Diagnostic message.
   static const char kMessage[];
-
-  // Collection of found violations.
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -73,15 +73,18 @@ void ProperParameterDeclarationRule::HandleSymbol(
       // kFormalParameterList.
       if (ContextIsInsideClass(context) &&
           !ContextIsInsideFormalParameterList(context)) {
-        violations_.insert(LintViolation(symbol, kParameterMessage, context));
+        violations_.push_back(
+            LintViolation(symbol, kParameterMessage, context));
       } else if (ContextIsInsideModule(context) &&
                  !ContextIsInsideFormalParameterList(context)) {
-        violations_.insert(LintViolation(symbol, kParameterMessage, context));
+        violations_.push_back(
+            LintViolation(symbol, kParameterMessage, context));
       }
     } else if (param_decl_token == TK_localparam) {
       // If the context is not inside a class or module, report violation.
       if (!ContextIsInsideClass(context) && !ContextIsInsideModule(context))
-        violations_.insert(LintViolation(symbol, kLocalParamMessage, context));
+        violations_.push_back(
+            LintViolation(symbol, kLocalParamMessage, context));
     }
   }
 }
@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_SIGNAL_NAME_STYLE_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_SIGNAL_NAME_STYLE_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -45,6 +44,8 @@ class SignalNameStyleRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -59,8 +60,6 @@ class SignalNameStyleRule : public verible::SyntaxTreeLintRule {
   Matcher matcher_port_ = NodekPortDeclaration();
   Matcher matcher_net_ = NodekNetDeclaration();
   Matcher matcher_data_ = NodekDataDeclaration();
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -75,7 +75,8 @@ void StructUnionNameStyleRule::HandleSymbol(const verible::Symbol& symbol,
     const auto name = ABSL_DIE_IF_NULL(identifier_leaf)->get().text;
     if (!verible::IsLowerSnakeCaseWithDigits(name) ||
         !absl::EndsWith(name, "_t")) {
-      violations_.insert(LintViolation(identifier_leaf->get(), msg, context));
+      violations_.push_back(
+          LintViolation(identifier_leaf->get(), msg, context));
     }
   }
 }
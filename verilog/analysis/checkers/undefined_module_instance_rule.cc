@@ -0,0 +1,73 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "verilog/analysis/checkers/undefined_module_instance_rule.h"
+
+#include <set>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/citation.h"
+#include "common/analysis/lint_rule_status.h"
+#include "verilog/analysis/descriptions.h"
+#include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/project_declaration_index.h"
+
+namespace verilog {
+namespace analysis {
+
+using verible::GetStyleGuideCitation;
+using verible::LintRuleStatus;
+
+// Register UndefinedModuleInstanceRule
+VERILOG_REGISTER_LINT_RULE(UndefinedModuleInstanceRule);
+
+absl::string_view UndefinedModuleInstanceRule::Name() {
+  return "undefined-module-instance";
+}
+const char UndefinedModuleInstanceRule::kTopic[] = "module-instantiation";
+
+std::string UndefinedModuleInstanceRule::GetDescription(
+    DescriptionType description_type) {
+  return absl::StrCat(
+      "Checks that every instantiated module or interface is declared in one "
+      "of the files of a project.  Only checked with ",
+      Codify("--project_mode", description_type), ".  See ",
+      GetStyleGuideCitation(kTopic), ".");
+}
+
+void UndefinedModuleInstanceRule::Lint(const ProjectDeclarationIndex& index) {
+  std::set<absl::string_view> declared_modules;
+  for (const auto& declaration : index.Declarations()) {
+    if (declaration.kind != DesignElementKind::kPackage) {
+      declared_modules.insert(declaration.name);
+    }
+  }
+  for (const auto& instance : index.Instances()) {
+    if (declared_modules.count(instance.name) > 0) continue;
+    project_violations_.push_back(
+        {&instance, absl::StrCat("Instance of \"", instance.name,
+                                 "\", which is not a module or interface "
+                                 "declared in this project.")});
+  }
+}
+
+LintRuleStatus UndefinedModuleInstanceRule::Report() const {
+  return LintRuleStatus(violations_, Name(), GetStyleGuideCitation(kTopic));
+}
+
+}  // namespace analysis
+}  // namespace verilog
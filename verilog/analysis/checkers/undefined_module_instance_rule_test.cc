@@ -0,0 +1,58 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "verilog/analysis/checkers/undefined_module_instance_rule.h"
+
+#include "gtest/gtest.h"
+#include "verilog/analysis/project_declaration_index.h"
+#include "verilog/analysis/project_declaration_index_test_utils.h"
+
+namespace verilog {
+namespace analysis {
+namespace {
+
+TEST(UndefinedModuleInstanceRuleTest, DeclaredModulesAndInterfaces) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("module sub;\nendmodule\ninterface bus;\nendinterface\n",
+                 "a.sv", &index);
+  AddCodeToIndex("module top;\n  sub u_sub();\n  bus u_bus();\nendmodule\n",
+                 "b.sv", &index);
+  index.Sort();
+  UndefinedModuleInstanceRule rule;
+  rule.Lint(index);
+  EXPECT_TRUE(rule.Violations().empty());
+}
+
+TEST(UndefinedModuleInstanceRuleTest, UndeclaredOrPackage) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("package p;\nendpackage\n", "a.sv", &index);
+  AddCodeToIndex("module top;\n  missing u_missing();\n  p u_p();\nendmodule\n",
+                 "b.sv", &index);
+  index.Sort();
+  UndefinedModuleInstanceRule rule;
+  rule.Lint(index);
+  const auto& violations = rule.Violations();
+  ASSERT_EQ(violations.size(), 2);
+  EXPECT_EQ(violations[0].symbol->name, "missing");
+  EXPECT_EQ(violations[0].symbol->position.line, 1);
+  EXPECT_EQ(violations[0].reason,
+            "Instance of \"missing\", which is not a module or interface "
+            "declared in this project.");
+  EXPECT_EQ(violations[1].symbol->name, "p");
+}
+
+}  // namespace
+}  // namespace analysis
+}  // namespace verilog
@@ -81,7 +81,7 @@ void UndersizedBinaryLiteralRule::HandleSymbol(
             CHECK_EQ(number.base,
                      'b');  // guaranteed by matching TK_BinBase
             if (width > number.literal.length() && number.literal != "0") {
-              violations_.insert(LintViolation(
+              violations_.push_back(LintViolation(
                   digits_leaf->get(),
                   FormatReason(width_text, base_text, digits_text), context));
             }
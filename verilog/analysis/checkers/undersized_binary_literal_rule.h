@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_UNDERSIZED_BINARY_LITERAL_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_UNDERSIZED_BINARY_LITERAL_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -47,6 +46,8 @@ class UndersizedBinaryLiteralRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -66,8 +67,6 @@ class UndersizedBinaryLiteralRule : public verible::SyntaxTreeLintRule {
       NumberHasConstantWidth().Bind("width"),
       NumberHasBasedLiteral(NumberIsBinary().Bind("base"),
                             NumberHasBinaryDigits().Bind("digits")));
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -91,12 +91,14 @@ void UnpackedDimensionsRule::HandleSymbol(
     const verible::TokenInfo token(TK_OTHER,
                                    verible::StringSpanOfSymbol(left, right));
     if (left_is_zero) {
-      violations_.insert(LintViolation(token, kMessageScalarInOrder, context));
+      violations_.push_back(
+          LintViolation(token, kMessageScalarInOrder, context));
     } else if (right_is_zero) {
-      violations_.insert(LintViolation(token, kMessageScalarReversed, context));
+      violations_.push_back(
+          LintViolation(token, kMessageScalarReversed, context));
     } else if (left_is_constant && right_is_constant &&
                left_value > right_value) {
-      violations_.insert(LintViolation(token, kMessageReorder, context));
+      violations_.push_back(LintViolation(token, kMessageReorder, context));
     }
   }
 }
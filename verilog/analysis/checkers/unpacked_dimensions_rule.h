@@ -15,7 +15,6 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_CHECKERS_UNPACKED_DIMENSIONS_RULE_H_
 #define VERIBLE_VERILOG_ANALYSIS_CHECKERS_UNPACKED_DIMENSIONS_RULE_H_
 
-#include <set>
 #include <string>
 
 #include "common/analysis/lint_rule_status.h"
@@ -44,6 +43,8 @@ class UnpackedDimensionsRule : public verible::SyntaxTreeLintRule {
 
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -51,8 +52,6 @@ class UnpackedDimensionsRule : public verible::SyntaxTreeLintRule {
 
   // Link to style guide rule.
   static const char kTopic[];
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
@@ -0,0 +1,72 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "verilog/analysis/checkers/unused_package_rule.h"
+
+#include <set>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "common/analysis/citation.h"
+#include "common/analysis/lint_rule_status.h"
+#include "verilog/analysis/descriptions.h"
+#include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/project_declaration_index.h"
+
+namespace verilog {
+namespace analysis {
+
+using verible::GetStyleGuideCitation;
+using verible::LintRuleStatus;
+
+// Register UnusedPackageRule
+VERILOG_REGISTER_LINT_RULE(UnusedPackageRule);
+
+absl::string_view UnusedPackageRule::Name() { return "unused-package"; }
+const char UnusedPackageRule::kTopic[] = "packages";
+
+std::string UnusedPackageRule::GetDescription(
+    DescriptionType description_type) {
+  return absl::StrCat(
+      "Checks that every package is referenced (e.g. imported) in one of the "
+      "files of a project.  Only checked with ",
+      Codify("--project_mode", description_type), ".  See ",
+      GetStyleGuideCitation(kTopic), ".");
+}
+
+void UnusedPackageRule::Lint(const ProjectDeclarationIndex& index) {
+  std::set<absl::string_view> referenced_packages;
+  for (const auto& reference : index.PackageReferences()) {
+    referenced_packages.insert(reference.name);
+  }
+  for (const auto& declaration : index.Declarations()) {
+    if (declaration.kind != DesignElementKind::kPackage ||
+        referenced_packages.count(declaration.name) > 0) {
+      continue;
+    }
+    project_violations_.push_back(
+        {&declaration, absl::StrCat("Package \"", declaration.name,
+                                    "\" is never referenced in this "
+                                    "project.")});
+  }
+}
+
+LintRuleStatus UnusedPackageRule::Report() const {
+  return LintRuleStatus(violations_, Name(), GetStyleGuideCitation(kTopic));
+}
+
+}  // namespace analysis
+}  // namespace verilog
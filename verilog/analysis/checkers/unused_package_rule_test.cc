@@ -0,0 +1,54 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "verilog/analysis/checkers/unused_package_rule.h"
+
+#include "gtest/gtest.h"
+#include "verilog/analysis/project_declaration_index.h"
+#include "verilog/analysis/project_declaration_index_test_utils.h"
+
+namespace verilog {
+namespace analysis {
+namespace {
+
+TEST(UnusedPackageRuleTest, ReferencedPackages) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("package p;\nendpackage\npackage q;\nendpackage\n", "a.sv",
+                 &index);
+  AddCodeToIndex("module top;\n  import p::*;\n  q::t x;\nendmodule\n",
+                 "b.sv", &index);
+  index.Sort();
+  UnusedPackageRule rule;
+  rule.Lint(index);
+  EXPECT_TRUE(rule.Violations().empty());
+}
+
+TEST(UnusedPackageRuleTest, UnreferencedPackage) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("package p;\nendpackage\nmodule p_user;\nendmodule\n",
+                 "a.sv", &index);
+  index.Sort();
+  UnusedPackageRule rule;
+  rule.Lint(index);
+  const auto& violations = rule.Violations();
+  ASSERT_EQ(violations.size(), 1);
+  EXPECT_EQ(violations[0].symbol->name, "p");
+  EXPECT_EQ(violations[0].reason,
+            "Package \"p\" is never referenced in this project.");
+}
+
+}  // namespace
+}  // namespace analysis
+}  // namespace verilog
@@ -59,8 +59,8 @@ void V2001GenerateBeginRule::HandleSymbol(
   verible::matcher::BoundSymbolManager manager;
   if (matcher_.Matches(symbol, &manager)) {
     if (const auto* block = manager.GetAs<verible::SyntaxTreeNode>("block")) {
-      violations_.insert(LintViolation(verible::GetLeftmostLeaf(*block)->get(),
-                                       kMessage, context));
+      violations_.push_back(LintViolation(
+          verible::GetLeftmostLeaf(*block)->get(), kMessage, context));
     }
   }
 }
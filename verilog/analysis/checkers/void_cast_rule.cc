@@ -68,8 +68,8 @@ void VoidCastRule::HandleSymbol(const verible::Symbol& symbol,
     if (auto function_id = manager.GetAs<verible::SyntaxTreeLeaf>("id")) {
       const auto& bfs = BlacklistedFunctionsSet();
       if (bfs.find(std::string(function_id->get().text)) != bfs.end()) {
-        violations_.insert(LintViolation(function_id->get(),
-                                         FormatReason(*function_id), context));
+        violations_.push_back(LintViolation(
+            function_id->get(), FormatReason(*function_id), context));
       }
     }
   }
@@ -80,7 +80,7 @@ void VoidCastRule::HandleSymbol(const verible::Symbol& symbol,
     if (auto randomize_node = manager.GetAs<verible::SyntaxTreeNode>("id")) {
       auto leaf_ptr = verible::GetLeftmostLeaf(*randomize_node);
       const verible::TokenInfo token = ABSL_DIE_IF_NULL(leaf_ptr)->get();
-      violations_.insert(LintViolation(
+      violations_.push_back(LintViolation(
           token, "randomize() is forbidden within void casts", context));
     }
   }
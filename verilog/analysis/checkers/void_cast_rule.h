@@ -46,6 +46,8 @@ class VoidCastRule : public verible::SyntaxTreeLintRule {
   void HandleSymbol(const verible::Symbol& symbol,
                     const verible::SyntaxTreeContext& context) override;
 
+  bool CanLintSubtreesSeparately() const override { return true; }
+
   verible::LintRuleStatus Report() const override;
 
  private:
@@ -80,8 +82,6 @@ class VoidCastRule : public verible::SyntaxTreeLintRule {
   const Matcher randomize_matcher_ = NodekVoidcast(VoidcastHasExpression(
       verible::matcher::AnyOf(ExpressionHasRandomizeCallExtension().Bind("id"),
                               ExpressionHasRandomizeFunction().Bind("id"))));
-
-  std::set<verible::LintViolation> violations_;
 };
 
 }  // namespace analysis
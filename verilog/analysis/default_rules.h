@@ -60,6 +60,10 @@ constexpr const char* kDefaultRuleSet[] = {
     "case-missing-default",
     "interface-name-style",
     "positive-meaning-parameter-name",
+    // Project rules, only checked with --project_mode:
+    "duplicate-design-element",
+    "undefined-module-instance",
+    "unused-package",
     // TODO(fangism): enable in production:
     // TODO(b/117131903): "proper-parameter-declaration",
     // TODO(b/131637160): "signal-name-style",
@@ -27,6 +27,7 @@
 #include "common/util/container_util.h"
 #include "common/util/logging.h"
 #include "verilog/analysis/descriptions.h"
+#include "verilog/analysis/project_lint_rule.h"
 
 namespace verilog {
 namespace analysis {
@@ -126,7 +127,8 @@ bool IsRegisteredLintRule(const LintRuleId& rule_name) {
   return LintRuleRegistry<SyntaxTreeLintRule>::ContainsLintRule(rule_name) ||
          LintRuleRegistry<TokenStreamLintRule>::ContainsLintRule(rule_name) ||
          LintRuleRegistry<LineLintRule>::ContainsLintRule(rule_name) ||
-         LintRuleRegistry<TextStructureLintRule>::ContainsLintRule(rule_name);
+         LintRuleRegistry<TextStructureLintRule>::ContainsLintRule(rule_name) ||
+         LintRuleRegistry<ProjectLintRule>::ContainsLintRule(rule_name);
 }
 
 // The following functions are LintRule-type-specific:
@@ -166,6 +168,15 @@ std::unique_ptr<TextStructureLintRule> CreateTextStructureLintRule(
   return LintRuleRegistry<TextStructureLintRule>::CreateLintRule(rule_name);
 }
 
+std::vector<LintRuleId> RegisteredProjectRulesNames() {
+  return LintRuleRegistry<ProjectLintRule>::GetRegisteredRulesNames();
+}
+
+std::unique_ptr<ProjectLintRule> CreateProjectLintRule(
+    const LintRuleId& rule_name) {
+  return LintRuleRegistry<ProjectLintRule>::CreateLintRule(rule_name);
+}
+
 std::set<LintRuleId> GetAllRegisteredLintRuleNames() {
   std::set<LintRuleId> result;
   for (const auto name : RegisteredSyntaxTreeRulesNames()) {
@@ -180,6 +191,9 @@ std::set<LintRuleId> GetAllRegisteredLintRuleNames() {
   for (const auto name : RegisteredTextStructureRulesNames()) {
     result.insert(name);
   }
+  for (const auto name : RegisteredProjectRulesNames()) {
+    result.insert(name);
+  }
   return result;
 }
 
@@ -197,6 +211,8 @@ LintRuleDescriptionsMap GetAllRuleDescriptionsHelpFlag() {
       &rule_map, DescriptionType::kHelpRulesFlag);
   LintRuleRegistry<TextStructureLintRule>::GetRegisteredRuleDescriptions(
       &rule_map, DescriptionType::kHelpRulesFlag);
+  LintRuleRegistry<ProjectLintRule>::GetRegisteredRuleDescriptions(
+      &rule_map, DescriptionType::kHelpRulesFlag);
   return rule_map;
 }
 
@@ -211,11 +227,14 @@ LintRuleDescriptionsMap GetAllRuleDescriptionsMarkdown() {
       &rule_map, DescriptionType::kMarkdown);
   LintRuleRegistry<TextStructureLintRule>::GetRegisteredRuleDescriptions(
       &rule_map, DescriptionType::kMarkdown);
+  LintRuleRegistry<ProjectLintRule>::GetRegisteredRuleDescriptions(
+      &rule_map, DescriptionType::kMarkdown);
   return rule_map;
 }
 
 // Explicit template class instantiations
 template class LintRuleRegisterer<LineLintRule>;
+template class LintRuleRegisterer<ProjectLintRule>;
 template class LintRuleRegisterer<SyntaxTreeLintRule>;
 template class LintRuleRegisterer<TextStructureLintRule>;
 template class LintRuleRegisterer<TokenStreamLintRule>;
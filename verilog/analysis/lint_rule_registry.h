@@ -42,6 +42,7 @@
 #include "common/analysis/token_stream_lint_rule.h"
 #include "common/strings/compare.h"
 #include "verilog/analysis/descriptions.h"
+#include "verilog/analysis/project_lint_rule.h"
 
 namespace verilog {
 namespace analysis {
@@ -149,6 +150,13 @@ std::vector<LintRuleId> RegisteredTextStructureRulesNames();
 std::unique_ptr<verible::TextStructureLintRule> CreateTextStructureLintRule(
     const LintRuleId& rule_name);
 
+// Returns sequence of project rule names.
+std::vector<LintRuleId> RegisteredProjectRulesNames();
+
+// Returns a project lint rule object corresponding the rule_name.
+std::unique_ptr<ProjectLintRule> CreateProjectLintRule(
+    const LintRuleId& rule_name);
+
 // Returns set of all registered lint rule names.
 // When storing string_views to the lint rule keys, use the ones returned in
 // this set, because their lifetime is guaranteed by the registration process.
@@ -0,0 +1,166 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/analysis/project_declaration_index.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "common/strings/line_column_map.h"
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/text_structure.h"
+#include "common/text/token_info.h"
+#include "common/text/tree_utils.h"
+#include "verilog/CST/declaration.h"
+#include "verilog/CST/module.h"
+#include "verilog/CST/package.h"
+#include "verilog/analysis/verilog_declaration_index.h"
+#include "verilog/parser/verilog_token_enum.h"
+
+namespace verilog {
+
+using verible::TextStructureView;
+using verible::TokenInfo;
+
+absl::string_view DesignElementKindName(DesignElementKind kind) {
+  switch (kind) {
+    case DesignElementKind::kModule:
+      return "module";
+    case DesignElementKind::kInterface:
+      return "interface";
+    case DesignElementKind::kPackage:
+      return "package";
+  }
+  return "???";
+}
+
+bool SymbolLocationLess(const DesignElementSymbol& left,
+                        const DesignElementSymbol& right) {
+  return std::tie(left.filename, left.position.line, left.position.column) <
+         std::tie(right.filename, right.position.line, right.position.column);
+}
+
+namespace {
+// Design elements of one file, collected before merging into the index.
+struct FileSymbols {
+  std::vector<DesignElementSymbol> declarations;
+  std::vector<DesignElementSymbol> instances;
+  std::vector<DesignElementSymbol> package_references;
+};
+
+class FileSymbolCollector {
+ public:
+  FileSymbolCollector(absl::string_view filename,
+                      const TextStructureView& text_structure)
+      : filename_(filename), text_structure_(text_structure) {}
+
+  void Add(DesignElementKind kind, const TokenInfo& token,
+           std::vector<DesignElementSymbol>* symbols) const {
+    symbols->push_back(
+        {kind, std::string(token.text), std::string(filename_),
+         text_structure_.GetLineColumnMap()(
+             token.left(text_structure_.Contents()))});
+  }
+
+ private:
+  const absl::string_view filename_;
+  const TextStructureView& text_structure_;
+};
+
+FileSymbols CollectFileSymbols(absl::string_view filename,
+                               const TextStructureView& text_structure) {
+  FileSymbols symbols;
+  const FileSymbolCollector collector(filename, text_structure);
+
+  // Scope prefixes only need the token stream, so they are found even where
+  // the syntax tree was not recovered.
+  const auto& tokens = text_structure.GetTokenStreamView();
+  for (auto iter = tokens.begin(); iter != tokens.end(); ++iter) {
+    const auto next = std::next(iter);
+    if (next == tokens.end()) break;
+    if ((*iter)->token_enum == verilog_tokentype::SymbolIdentifier &&
+        (*next)->token_enum == verilog_tokentype::TK_SCOPE_RES) {
+      collector.Add(DesignElementKind::kPackage, **iter,
+                    &symbols.package_references);
+    }
+  }
+
+  const auto& index = VerilogDeclarationIndex::Get(text_structure);
+  for (const auto& match : index.ModuleDeclarations()) {
+    collector.Add(DesignElementKind::kModule,
+                  GetModuleNameToken(*match.match), &symbols.declarations);
+  }
+  for (const auto& match : index.InterfaceDeclarations()) {
+    collector.Add(DesignElementKind::kInterface,
+                  GetInterfaceNameToken(*match.match), &symbols.declarations);
+  }
+  for (const auto& match : index.PackageDeclarations()) {
+    collector.Add(DesignElementKind::kPackage,
+                  GetPackageNameToken(*match.match), &symbols.declarations);
+  }
+
+  // Module instances are data declarations whose instances have port
+  // connections, e.g. "foo bar(...);", as opposed to "foo_t bar;".
+  for (const auto& match : index.Instantiations()) {
+    const auto* type_leaf =
+        verible::GetLeftmostLeaf(GetTypeOfDataDeclaration(*match.match));
+    // Built-in gates like "and" or "nand" are keywords, not identifiers.
+    if (type_leaf == nullptr ||
+        type_leaf->get().token_enum != verilog_tokentype::SymbolIdentifier) {
+      continue;
+    }
+    collector.Add(DesignElementKind::kModule, type_leaf->get(),
+                  &symbols.instances);
+  }
+  return symbols;
+}
+
+void AppendSymbols(std::vector<DesignElementSymbol>* from,
+                   std::vector<DesignElementSymbol>* to) {
+  to->insert(to->end(), std::make_move_iterator(from->begin()),
+             std::make_move_iterator(from->end()));
+}
+
+void SortSymbols(std::vector<DesignElementSymbol>* symbols) {
+  std::sort(symbols->begin(), symbols->end(), SymbolLocationLess);
+}
+}  // namespace
+
+std::ostream& operator<<(std::ostream& stream, DesignElementKind kind) {
+  return stream << DesignElementKindName(kind);
+}
+
+void ProjectDeclarationIndex::AddFile(absl::string_view filename,
+                                      const TextStructureView& text_structure) {
+  FileSymbols symbols(CollectFileSymbols(filename, text_structure));
+  absl::MutexLock lock(&mutex_);
+  AppendSymbols(&symbols.declarations, &declarations_);
+  AppendSymbols(&symbols.instances, &instances_);
+  AppendSymbols(&symbols.package_references, &package_references_);
+}
+
+void ProjectDeclarationIndex::Sort() {
+  absl::MutexLock lock(&mutex_);
+  SortSymbols(&declarations_);
+  SortSymbols(&instances_);
+  SortSymbols(&package_references_);
+}
+
+}  // namespace verilog
@@ -0,0 +1,109 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ProjectDeclarationIndex collects the modules, interfaces, and packages
+// that each file of a project declares and references, for checks across
+// files (see ProjectLintRule).
+
+#ifndef VERIBLE_VERILOG_ANALYSIS_PROJECT_DECLARATION_INDEX_H_
+#define VERIBLE_VERILOG_ANALYSIS_PROJECT_DECLARATION_INDEX_H_
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "common/strings/line_column_map.h"
+#include "common/text/text_structure.h"
+
+namespace verilog {
+
+enum class DesignElementKind {
+  kModule,
+  kInterface,
+  kPackage,
+};
+
+std::ostream& operator<<(std::ostream&, DesignElementKind);
+
+// A design element that is named in one file of a project, either where it
+// is declared, or where it is referenced.
+struct DesignElementSymbol {
+  DesignElementKind kind;
+  std::string name;
+  std::string filename;
+  verible::LineColumn position;  // 0-based
+};
+
+// ProjectDeclarationIndex collects the design elements declared and
+// referenced across all files of a project.
+class ProjectDeclarationIndex {
+ public:
+  // Collects declarations and references from one analyzed file.
+  // This may be called concurrently for different files: symbols are
+  // extracted without holding any lock, and only merged under the lock.
+  void AddFile(absl::string_view filename,
+               const verible::TextStructureView& text_structure)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Sorts all symbols by file and position, so that results do not depend
+  // on the order in which files were added.
+  // Call this once, after all files have been added.
+  void Sort() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // The following accessors are not synchronized, and may only be used after
+  // all calls to AddFile() have returned.
+
+  // Module, interface, and package declarations.
+  const std::vector<DesignElementSymbol>& Declarations() const
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    return declarations_;
+  }
+
+  // Type names of module (or interface) instances, e.g. "foo" in
+  // "foo #(.N(1)) bar(...);".  These are all of kind kModule, because
+  // modules and interfaces cannot be told apart at the instantiation.
+  const std::vector<DesignElementSymbol>& Instances() const
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    return instances_;
+  }
+
+  // Names used as a scope prefix, as in "import p::*;" or "p::T".
+  // These are all of kind kPackage, even though a class scope looks the same.
+  const std::vector<DesignElementSymbol>& PackageReferences() const
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    return package_references_;
+  }
+
+ private:
+  absl::Mutex mutex_;
+
+  std::vector<DesignElementSymbol> declarations_ ABSL_GUARDED_BY(mutex_);
+
+  std::vector<DesignElementSymbol> instances_ ABSL_GUARDED_BY(mutex_);
+
+  std::vector<DesignElementSymbol> package_references_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Returns "module", "interface", or "package".
+absl::string_view DesignElementKindName(DesignElementKind kind);
+
+// Orders symbols by file, then by position.
+bool SymbolLocationLess(const DesignElementSymbol& left,
+                        const DesignElementSymbol& right);
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_ANALYSIS_PROJECT_DECLARATION_INDEX_H_
@@ -0,0 +1,78 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/analysis/project_declaration_index.h"
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "verilog/analysis/project_declaration_index_test_utils.h"
+
+namespace verilog {
+namespace {
+
+TEST(ProjectDeclarationIndexTest, CollectsDeclarationsAndReferences) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex(
+      "package p;\n"
+      "endpackage\n"
+      "interface i;\n"
+      "endinterface\n"
+      "module m;\n"
+      "  import p::*;\n"
+      "  foo_t not_an_instance;\n"
+      "  and g(a, b, c);\n"
+      "  sub #(.N(1)) u_sub(.x(y));\n"
+      "endmodule\n",
+      "a.sv", &index);
+  index.Sort();
+
+  const auto& declarations = index.Declarations();
+  ASSERT_EQ(declarations.size(), 3);
+  EXPECT_EQ(declarations[0].kind, DesignElementKind::kPackage);
+  EXPECT_EQ(declarations[0].name, "p");
+  EXPECT_EQ(declarations[0].filename, "a.sv");
+  EXPECT_EQ(declarations[0].position.line, 0);
+  EXPECT_EQ(declarations[0].position.column, 8);
+  EXPECT_EQ(declarations[1].kind, DesignElementKind::kInterface);
+  EXPECT_EQ(declarations[1].name, "i");
+  EXPECT_EQ(declarations[2].kind, DesignElementKind::kModule);
+  EXPECT_EQ(declarations[2].name, "m");
+
+  ASSERT_EQ(index.Instances().size(), 1);
+  EXPECT_EQ(index.Instances()[0].name, "sub");
+  EXPECT_EQ(index.Instances()[0].position.line, 8);
+
+  ASSERT_EQ(index.PackageReferences().size(), 1);
+  EXPECT_EQ(index.PackageReferences()[0].name, "p");
+}
+
+TEST(ProjectDeclarationIndexTest, SortIsIndependentOfAddOrder) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("module b;\nendmodule\n", "b.sv", &index);
+  AddCodeToIndex("module a;\nendmodule\n", "a.sv", &index);
+  index.Sort();
+  ASSERT_EQ(index.Declarations().size(), 2);
+  EXPECT_EQ(index.Declarations()[0].filename, "a.sv");
+  EXPECT_EQ(index.Declarations()[1].filename, "b.sv");
+}
+
+TEST(DesignElementKindTest, Print) {
+  std::ostringstream stream;
+  stream << DesignElementKind::kInterface;
+  EXPECT_EQ(stream.str(), "interface");
+}
+
+}  // namespace
+}  // namespace verilog
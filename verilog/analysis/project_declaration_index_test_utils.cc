@@ -0,0 +1,33 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "verilog/analysis/project_declaration_index_test_utils.h"
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "common/util/logging.h"
+#include "verilog/analysis/project_declaration_index.h"
+#include "verilog/analysis/verilog_analyzer.h"
+
+namespace verilog {
+
+void AddCodeToIndex(absl::string_view code, absl::string_view filename,
+                    ProjectDeclarationIndex* index) {
+  const auto analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(code, filename);
+  ASSERT_TRUE(ABSL_DIE_IF_NULL(analyzer)->ParseStatus().ok()) << code;
+  index->AddFile(filename, analyzer->Data());
+}
+
+}  // namespace verilog
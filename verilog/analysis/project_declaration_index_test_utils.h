@@ -0,0 +1,31 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VERIBLE_VERILOG_ANALYSIS_PROJECT_DECLARATION_INDEX_TEST_UTILS_H_
+#define VERIBLE_VERILOG_ANALYSIS_PROJECT_DECLARATION_INDEX_TEST_UTILS_H_
+
+#include "absl/strings/string_view.h"
+#include "verilog/analysis/project_declaration_index.h"
+
+namespace verilog {
+
+// Parses 'code' (which must be free of syntax errors) as if it were the
+// contents of 'filename', and adds it to 'index'.
+void AddCodeToIndex(absl::string_view code, absl::string_view filename,
+                    ProjectDeclarationIndex* index);
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_ANALYSIS_PROJECT_DECLARATION_INDEX_TEST_UTILS_H_
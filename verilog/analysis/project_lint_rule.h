@@ -0,0 +1,61 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// ProjectLintRule is the base class of rules that check all files of a
+// project together, like the consistency of declarations across files.
+
+#ifndef VERIBLE_VERILOG_ANALYSIS_PROJECT_LINT_RULE_H_
+#define VERIBLE_VERILOG_ANALYSIS_PROJECT_LINT_RULE_H_
+
+#include <string>
+#include <vector>
+
+#include "common/analysis/lint_rule.h"
+#include "verilog/analysis/project_declaration_index.h"
+
+namespace verilog {
+
+// A violation of a ProjectLintRule, found at a symbol of the index.
+struct ProjectLintViolation {
+  // Points into the ProjectDeclarationIndex that was linted.
+  const DesignElementSymbol* symbol;
+
+  // Explanation of the violation.
+  std::string reason;
+};
+
+// ProjectLintRule runs only in project mode, once every file of the project
+// has been added to the index.  By then the files' text is gone, so
+// violations refer to symbols of the index instead of tokens: Report()
+// only supplies the rule name and citation, and Violations() the findings.
+class ProjectLintRule : public verible::LintRule {
+ public:
+  ~ProjectLintRule() override {}
+
+  // Analyzes the complete, sorted index of a project.
+  virtual void Lint(const ProjectDeclarationIndex& index) = 0;
+
+  // Returns the violations found, in the order they were found.
+  const std::vector<ProjectLintViolation>& Violations() const {
+    return project_violations_;
+  }
+
+ protected:
+  std::vector<ProjectLintViolation> project_violations_;
+};
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_ANALYSIS_PROJECT_LINT_RULE_H_
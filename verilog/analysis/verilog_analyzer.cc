@@ -41,6 +41,7 @@
 #include "common/text/visitors.h"
 #include "common/util/container_util.h"
 #include "common/util/logging.h"
+#include "common/util/range.h"
 #include "common/util/status_macros.h"
 #include "verilog/analysis/verilog_excerpt_parse.h"
 #include "verilog/parser/verilog_lexer.h"
@@ -55,6 +56,7 @@ namespace verilog {
 using verible::FileAnalyzer;
 using verible::TokenInfo;
 using verible::TokenSequence;
+using verible::TokenStreamView;
 using verible::container::InsertKeyOrDie;
 
 const char VerilogAnalyzer::kParseDirectiveName[] = "verilog_syntax:";
@@ -206,6 +208,31 @@ void VerilogAnalyzer::ContextualizeTokens() {
   context.TransformVerilogSymbols(data_.MakeTokenStreamReferenceView());
 }
 
+void VerilogAnalyzer::StreamTokensToPreprocessor(
+    VerilogPreprocess* preprocessor) {
+  TokenSequence& tokens = MutableData().MutableTokenStream();
+  TokenStreamView& tokens_view = MutableData().MutableTokenStreamView();
+  // The view is rebuilt from scratch.  It never holds more than all of the
+  // tokens, so it is never reallocated while the preprocessor scans it.
+  tokens_view.clear();
+  tokens_view.reserve(tokens.size());
+  LexicalContext context;
+  auto next = tokens.begin();
+  const auto end = tokens.end();
+  // Each token pulled by the preprocessor passes through the filter and
+  // lexical context stages right before it is preprocessed.
+  const auto generator = [&]() -> TokenStreamView::const_iterator {
+    for (; next != end; ++next) {
+      if (!VerilogLexer::KeepSyntaxTreeTokens(*next)) continue;
+      context.AdvanceToken(&*next);
+      tokens_view.push_back(next++);
+      return tokens_view.end() - 1;
+    }
+    return tokens_view.end();
+  };
+  preprocessor_data_ = preprocessor->ScanStream(&tokens_view, generator);
+}
+
 // Analyzes Verilog code: lexer, filter, parser.
 // Result of parsing is stored in syntax_tree_ (if passed)
 // or rejected_token_ (if failed).
@@ -213,18 +240,24 @@ absl::Status VerilogAnalyzer::Analyze() {
   // Lex into tokens.
   RETURN_IF_ERROR(Tokenize());
 
-  // Here would be one place to analyze the raw token stream.
-  FilterTokensForSyntaxTree();
-
-  // Disambiguate tokens using lexical context.
-  ContextualizeTokens();
-
   // pseudo-preprocess token stream.
-  // TODO(fangism): preprocessor_.Configure();
   //   Not all analyses will want to preprocess.
   {
-    VerilogPreprocess preprocessor;
-    preprocessor_data_ = preprocessor.ScanStream(Data().GetTokenStreamView());
+    VerilogPreprocess preprocessor(preprocess_config_, filename_);
+    if (streaming_pipeline_) {
+      StreamTokensToPreprocessor(&preprocessor);
+    } else {
+      // Here would be one place to analyze the raw token stream.
+      FilterTokensForSyntaxTree();
+
+      // Disambiguate tokens using lexical context.
+      ContextualizeTokens();
+
+      // The token stream view is filtered in-place, without copying, unless
+      // the configuration expands `includes or macros.
+      preprocessor_data_ =
+          preprocessor.ScanStream(&MutableData().MutableTokenStreamView());
+    }
     if (!preprocessor_data_.errors.empty()) {
       for (const auto& error : preprocessor_data_.errors) {
         rejected_tokens_.push_back(verible::RejectedToken{
@@ -234,9 +267,6 @@ absl::Status VerilogAnalyzer::Analyze() {
       parse_status_ = absl::InvalidArgumentError("Preprocessor error.");
       return parse_status_;
     }
-    MutableData().MutableTokenStreamView() =
-        preprocessor_data_.preprocessed_token_stream;  // copy
-    // TODO(fangism): could we just move, swap, or directly reference?
   }
 
   auto generator = MakeTokenViewer(Data().GetTokenStreamView());
@@ -270,7 +300,9 @@ class MacroCallArgExpander : public MutableTreeVisitorRecursive {
 
   void Visit(const SyntaxTreeLeaf& leaf, SymbolPtr* leaf_owner) override {
     const TokenInfo& token(leaf.get());
-    if (token.token_enum == MacroArg) {
+    // Skip macro arguments that came from expanded `included files.
+    if (token.token_enum == MacroArg &&
+        verible::IsSubRange(token.text, full_text_)) {
       VLOG(3) << "MacroCallArgExpander: examining token: " << token;
       // Attempt to parse text as an expression.
       std::unique_ptr<VerilogAnalyzer> expr_analyzer =
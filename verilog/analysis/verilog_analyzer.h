@@ -49,6 +49,19 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   // if there are syntax errors.
   absl::Status Analyze();
 
+  // Configures the preprocessing stage of Analyze().
+  // The default configuration does not expand `includes or macros.
+  void SetPreprocessConfig(const VerilogPreprocessConfig& config) {
+    preprocess_config_ = config;
+  }
+
+  // If true, Analyze() runs filtering, context disambiguation, and
+  // preprocessing as chained stages in a single pass over the lexed tokens,
+  // which writes the final token stream view for the parser directly.
+  // Otherwise, each stage makes its own pass over the tokens.
+  // Both modes produce the same results.
+  void SetStreamingPipeline(bool streaming) { streaming_pipeline_ = streaming; }
+
   absl::Status LexStatus() const { return lex_status_; }
 
   absl::Status ParseStatus() const { return parse_status_; }
@@ -88,6 +101,9 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   // syntax tree.  If parsing fails, leave the MacroArg token unexpanded.
   void ExpandMacroCallArgExpressions();
 
+  // Filters, contextualizes, and preprocesses the lexed tokens in one pass.
+  void StreamTokensToPreprocessor(VerilogPreprocess* preprocessor);
+
   // Information about parser internals.
 
   // True if input text has already been lexed.
@@ -96,9 +112,15 @@ class VerilogAnalyzer : public verible::FileAnalyzer {
   // Maximum symbol stack depth.
   size_t max_used_stack_size_;
 
+  // Preprocessor configuration.
+  VerilogPreprocessConfig preprocess_config_;
+
   // Preprocessor.
   VerilogPreprocessData preprocessor_data_;
 
+  // If true, run the token stages between lexing and parsing in one pass.
+  bool streaming_pipeline_ = false;
+
   // If true, let comments control the parsing mode.
   bool use_parser_directive_comments_ = true;
 
@@ -696,6 +696,54 @@ TEST(VerilogAnalyzerExpandsMacroArgsTest, MultipleMacroCalls) {
   }
 }
 
+// Test that the streaming token pipeline produces the same token stream
+// view as the staged pipeline.
+TEST(VerilogAnalyzerStreamingPipelineTest, SameAsStaged) {
+  const char* test_cases[] = {
+      "",
+      "// just a comment\n",
+      "module m;\nendmodule\n",
+      "`define FOO(a, b=1) a+b\n"
+      "module m;\n"
+      "  assign x = `FOO(y);  // comment\n"
+      "endmodule : m\n",
+      "class c;\n"
+      "  constraint co { a -> { b < 4; } if (c) d == 0; }\n"
+      "  function void f(); void'(randomize(a) with { a -> b; }); endfunction\n"
+      "endclass\n",
+      "module m;\n"
+      "  property p; @(posedge clk) a |-> b; endproperty\n"
+      "endmodule\n",
+      "`define 123\n"  // preprocessing error
+      "module m;\nendmodule\n",
+      "module m;\n  wire w = ;\nendmodule\n",  // syntax error
+  };
+  for (const auto* code : test_cases) {
+    VerilogAnalyzer staged(code, "<<inline>>");
+    const auto staged_status = staged.Analyze();
+    VerilogAnalyzer streaming(code, "<<inline>>");
+    streaming.SetStreamingPipeline(true);
+    const auto streaming_status = streaming.Analyze();
+    EXPECT_EQ(streaming_status.code(), staged_status.code()) << code;
+    EXPECT_EQ(streaming.GetRejectedTokens().size(),
+              staged.GetRejectedTokens().size())
+        << code;
+    const auto& staged_view = staged.Data().GetTokenStreamView();
+    const auto& streaming_view = streaming.Data().GetTokenStreamView();
+    ASSERT_EQ(streaming_view.size(), staged_view.size()) << code;
+    for (size_t i = 0; i < staged_view.size(); ++i) {
+      EXPECT_EQ(streaming_view[i]->token_enum, staged_view[i]->token_enum)
+          << code << "\nat token " << i;
+      EXPECT_EQ(streaming_view[i]->left(streaming.Data().Contents()),
+                staged_view[i]->left(staged.Data().Contents()))
+          << code << "\nat token " << i;
+    }
+    EXPECT_EQ(streaming.PreprocessorData().macro_definitions.size(),
+              staged.PreprocessorData().macro_definitions.size())
+        << code;
+  }
+}
+
 // Helper class for testing internals.
 class VerilogAnalyzerInternalsTest : public testing::Test,
                                      public VerilogAnalyzer {
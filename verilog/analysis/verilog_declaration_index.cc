@@ -0,0 +1,115 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/analysis/verilog_declaration_index.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "common/analysis/syntax_tree_search.h"
+#include "common/text/concrete_syntax_leaf.h"
+#include "common/text/concrete_syntax_tree.h"
+#include "common/text/text_structure.h"
+#include "common/text/tree_context_visitor.h"
+#include "verilog/CST/verilog_nonterminals.h"
+#include "verilog/parser/verilog_token_enum.h"
+
+namespace verilog {
+
+using verible::SyntaxTreeLeaf;
+using verible::SyntaxTreeNode;
+using verible::TreeSearchMatch;
+
+// Fills in all lists of a VerilogDeclarationIndex in one pre-order traversal.
+class DeclarationIndexBuilder : public verible::TreeContextVisitor {
+ public:
+  explicit DeclarationIndexBuilder(VerilogDeclarationIndex* index)
+      : index_(index) {}
+
+  void Visit(const SyntaxTreeLeaf& leaf) override {
+    if (leaf.get().token_enum == verilog_tokentype::SymbolIdentifier) {
+      index_->identifiers_.push_back(&leaf.get());
+    }
+  }
+
+  void Visit(const SyntaxTreeNode& node) override {
+    const auto tag = NodeEnum(node.Tag().tag);
+    switch (tag) {
+      case NodeEnum::kModuleDeclaration:
+        Add(node, &index_->module_declarations_);
+        break;
+      case NodeEnum::kInterfaceDeclaration:
+        Add(node, &index_->interface_declarations_);
+        break;
+      case NodeEnum::kPackageDeclaration:
+        Add(node, &index_->package_declarations_);
+        break;
+      case NodeEnum::kPortDeclaration:
+        Add(node, &index_->port_declarations_);
+        break;
+      case NodeEnum::kParamDeclaration:
+        Add(node, &index_->param_declarations_);
+        break;
+      case NodeEnum::kDataDeclaration:
+        open_data_declarations_.push_back(
+            index_->data_declarations_.size());
+        Add(node, &index_->data_declarations_);
+        is_instantiation_.push_back(false);
+        break;
+      case NodeEnum::kGateInstance:
+        // Any instance inside a data declaration makes it an instantiation.
+        for (const size_t i : open_data_declarations_) {
+          is_instantiation_[i] = true;
+        }
+        break;
+      default:
+        break;
+    }
+    TreeContextVisitor::Visit(node);
+    if (tag == NodeEnum::kDataDeclaration) open_data_declarations_.pop_back();
+  }
+
+  void Finish() {
+    for (size_t i = 0; i < is_instantiation_.size(); ++i) {
+      if (is_instantiation_[i]) {
+        index_->instantiations_.push_back(index_->data_declarations_[i]);
+      }
+    }
+  }
+
+ private:
+  void Add(const SyntaxTreeNode& node, std::vector<TreeSearchMatch>* matches) {
+    matches->push_back(TreeSearchMatch{&node, Context()});
+  }
+
+  VerilogDeclarationIndex* const index_;
+
+  // Positions in data_declarations_ of the data declarations that enclose the
+  // current node.
+  std::vector<size_t> open_data_declarations_;
+
+  // Parallel to data_declarations_.
+  std::vector<bool> is_instantiation_;
+};
+
+VerilogDeclarationIndex::VerilogDeclarationIndex(
+    const verible::TextStructureView& text_structure) {
+  const auto& root = text_structure.SyntaxTree();
+  if (root == nullptr) return;
+  DeclarationIndexBuilder builder(this);
+  root->Accept(&builder);
+  builder.Finish();
+}
+
+}  // namespace verilog
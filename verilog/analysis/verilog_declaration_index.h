@@ -0,0 +1,102 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VERIBLE_VERILOG_ANALYSIS_VERILOG_DECLARATION_INDEX_H_
+#define VERIBLE_VERILOG_ANALYSIS_VERILOG_DECLARATION_INDEX_H_
+
+#include <vector>
+
+#include "common/analysis/syntax_tree_search.h"
+#include "common/text/text_structure.h"
+#include "common/text/token_info.h"
+
+namespace verilog {
+
+// VerilogDeclarationIndex holds the declarations and identifiers of one
+// analyzed source file, all collected in a single traversal of its syntax
+// tree.
+// Every list is in syntax tree pre-order, and contains the same matches
+// (with the same context) as the corresponding FindAll*() function in
+// verilog/CST, which it replaces for consumers that use several of them.
+class VerilogDeclarationIndex {
+ public:
+  explicit VerilogDeclarationIndex(
+      const verible::TextStructureView& text_structure);
+
+  // Returns the index of 'text_structure', which is built on first use and
+  // then shared by all lint rules and the formatter that look at it.
+  static const VerilogDeclarationIndex& Get(
+      const verible::TextStructureView& text_structure) {
+    return text_structure.GetDerivedAnalysis<VerilogDeclarationIndex>();
+  }
+
+  // Same as FindAllModuleDeclarations().
+  const std::vector<verible::TreeSearchMatch>& ModuleDeclarations() const {
+    return module_declarations_;
+  }
+
+  // Same as FindAllInterfaceDeclarations().
+  const std::vector<verible::TreeSearchMatch>& InterfaceDeclarations() const {
+    return interface_declarations_;
+  }
+
+  // Same as FindAllPackageDeclarations().
+  const std::vector<verible::TreeSearchMatch>& PackageDeclarations() const {
+    return package_declarations_;
+  }
+
+  // Same as FindAllModulePortDeclarations().
+  const std::vector<verible::TreeSearchMatch>& PortDeclarations() const {
+    return port_declarations_;
+  }
+
+  // Same as FindAllParamDeclarations().
+  const std::vector<verible::TreeSearchMatch>& ParamDeclarations() const {
+    return param_declarations_;
+  }
+
+  // Same as FindAllDataDeclarations().
+  const std::vector<verible::TreeSearchMatch>& DataDeclarations() const {
+    return data_declarations_;
+  }
+
+  // The subset of DataDeclarations() that contain a module or gate-like
+  // instance with ports in parentheses, i.e. those for which
+  // FindAllGateInstances() is not empty.
+  const std::vector<verible::TreeSearchMatch>& Instantiations() const {
+    return instantiations_;
+  }
+
+  // All plain (non-escaped) identifier tokens, in order of position.
+  // Use TokenInfo::left() with the text structure's Contents() for offsets.
+  const std::vector<const verible::TokenInfo*>& Identifiers() const {
+    return identifiers_;
+  }
+
+ private:
+  friend class DeclarationIndexBuilder;
+
+  std::vector<verible::TreeSearchMatch> module_declarations_;
+  std::vector<verible::TreeSearchMatch> interface_declarations_;
+  std::vector<verible::TreeSearchMatch> package_declarations_;
+  std::vector<verible::TreeSearchMatch> port_declarations_;
+  std::vector<verible::TreeSearchMatch> param_declarations_;
+  std::vector<verible::TreeSearchMatch> data_declarations_;
+  std::vector<verible::TreeSearchMatch> instantiations_;
+  std::vector<const verible::TokenInfo*> identifiers_;
+};
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_ANALYSIS_VERILOG_DECLARATION_INDEX_H_
@@ -0,0 +1,114 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/analysis/verilog_declaration_index.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "common/analysis/syntax_tree_search.h"
+#include "common/util/logging.h"
+#include "verilog/CST/declaration.h"
+#include "verilog/CST/module.h"
+#include "verilog/CST/package.h"
+#include "verilog/CST/parameters.h"
+#include "verilog/CST/port.h"
+#include "verilog/analysis/verilog_analyzer.h"
+
+namespace verilog {
+namespace {
+
+using verible::TreeSearchMatch;
+
+// Expects the same matches, in the same order, with the same context.
+void ExpectSameMatches(const std::vector<TreeSearchMatch>& actual,
+                       const std::vector<TreeSearchMatch>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_EQ(actual[i].match, expected[i].match) << "at " << i;
+    EXPECT_TRUE(std::equal(actual[i].context.begin(), actual[i].context.end(),
+                           expected[i].context.begin(),
+                           expected[i].context.end()))
+        << "at " << i;
+  }
+}
+
+TEST(VerilogDeclarationIndexTest, EmptySource) {
+  VerilogAnalyzer analyzer("", "");
+  ASSERT_TRUE(analyzer.Analyze().ok());
+  const auto& index = VerilogDeclarationIndex::Get(analyzer.Data());
+  EXPECT_TRUE(index.ModuleDeclarations().empty());
+  EXPECT_TRUE(index.DataDeclarations().empty());
+  EXPECT_TRUE(index.Identifiers().empty());
+}
+
+TEST(VerilogDeclarationIndexTest, SameAsFindAll) {
+  VerilogAnalyzer analyzer(R"(
+package p;
+  parameter int W = 1;
+endpackage
+interface i;
+endinterface
+module outer(input clk, output logic q);
+  localparam int N = 2;
+  foo_t not_an_instance;
+  sub u1(.clk(clk)), u2();
+  module inner;
+    sub u3();
+  endmodule
+endmodule
+)",
+                           "");
+  ASSERT_TRUE(analyzer.Analyze().ok());
+  const auto& root = *ABSL_DIE_IF_NULL(analyzer.Data().SyntaxTree());
+  const auto& index = VerilogDeclarationIndex::Get(analyzer.Data());
+
+  ExpectSameMatches(index.ModuleDeclarations(),
+                    FindAllModuleDeclarations(root));
+  EXPECT_EQ(index.ModuleDeclarations().size(), 2);
+  ExpectSameMatches(index.InterfaceDeclarations(),
+                    FindAllInterfaceDeclarations(root));
+  ExpectSameMatches(index.PackageDeclarations(),
+                    FindAllPackageDeclarations(root));
+  ExpectSameMatches(index.PortDeclarations(),
+                    FindAllModulePortDeclarations(root));
+  EXPECT_EQ(index.PortDeclarations().size(), 2);
+  ExpectSameMatches(index.ParamDeclarations(), FindAllParamDeclarations(root));
+  EXPECT_EQ(index.ParamDeclarations().size(), 2);
+  ExpectSameMatches(index.DataDeclarations(), FindAllDataDeclarations(root));
+
+  std::vector<TreeSearchMatch> instantiations;
+  for (const auto& data : FindAllDataDeclarations(root)) {
+    if (!FindAllGateInstances(*data.match).empty()) {
+      instantiations.push_back(data);
+    }
+  }
+  ExpectSameMatches(index.Instantiations(), instantiations);
+  EXPECT_EQ(index.Instantiations().size(), 2);
+
+  ASSERT_FALSE(index.Identifiers().empty());
+  EXPECT_EQ(index.Identifiers().front()->text, "p");
+  EXPECT_EQ(index.Identifiers().back()->text, "u3");
+}
+
+TEST(VerilogDeclarationIndexTest, SharedPerTextStructure) {
+  VerilogAnalyzer analyzer("module m; endmodule", "");
+  ASSERT_TRUE(analyzer.Analyze().ok());
+  const auto& index = VerilogDeclarationIndex::Get(analyzer.Data());
+  EXPECT_EQ(&VerilogDeclarationIndex::Get(analyzer.Data()), &index);
+}
+
+}  // namespace
+}  // namespace verilog
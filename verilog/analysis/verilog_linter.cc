@@ -14,21 +14,25 @@
 
 #include "verilog/analysis/verilog_linter.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iomanip>
+#include <iterator>
 #include <map>
 #include <memory>
-#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/flags/flag.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/line_lint_rule.h"
 #include "common/analysis/line_linter.h"
+#include "common/analysis/lint_diagnostic_sink.h"
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/lint_waiver.h"
 #include "common/analysis/syntax_tree_lint_rule.h"
@@ -43,6 +47,7 @@
 #include "common/text/token_info.h"
 #include "common/util/file_util.h"
 #include "common/util/logging.h"
+#include "common/util/parallel_for.h"
 #include "verilog/analysis/default_rules.h"
 #include "verilog/analysis/lint_rule_registry.h"
 #include "verilog/analysis/verilog_analyzer.h"
@@ -67,6 +72,21 @@ ABSL_FLAG(verilog::RuleSet, ruleset, verilog::RuleSet::kDefault,
 ABSL_FLAG(std::string, waiver_files, "",
           "Path to waiver config files (comma-separated). "
           "Please refer to the README file for information about its format.");
+ABSL_FLAG(int, max_violations_per_rule, 0,
+          "If positive, each rule stops looking for violations in a file "
+          "after finding this many that are not waived.");
+ABSL_FLAG(int, max_violations_per_file, 0,
+          "If positive, report at most this many violations per file.");
+ABSL_FLAG(int, threads_per_file, 1,
+          "Number of threads that run lint rules on each file concurrently, "
+          "0 for one per hardware thread.  This speeds up linting very large "
+          "files.");
+
+ABSL_FLAG(bool, partition_syntax_tree, false,
+          "If true, and --threads_per_file is not 1, syntax tree rules lint "
+          "the top-level modules, packages, classes, etc. of a file on "
+          "different threads.  This is faster for files with many top-level "
+          "items.");
 
 namespace verilog {
 
@@ -79,17 +99,41 @@ using verible::TokenInfo;
 int LintOneFile(std::ostream* stream, absl::string_view filename,
                 const LinterConfiguration& config, bool parse_fatal,
                 bool lint_fatal) {
+  verible::TextLintDiagnosticSink sink(stream);
+  return LintOneFile(stream, &sink, filename, config, parse_fatal, lint_fatal);
+}
+
+int LintOneFile(std::ostream* stream, verible::LintDiagnosticSink* sink,
+                absl::string_view filename, const LinterConfiguration& config,
+                bool parse_fatal, bool lint_fatal) {
   std::string content;
   if (!verible::file::GetContents(filename, &content).ok()) return 2;
 
-  // Lex and parse the contents of the file.
-  const auto analyzer =
-      VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
-  const auto lex_status = ABSL_DIE_IF_NULL(analyzer)->LexStatus();
-  const auto parse_status = analyzer->ParseStatus();
+  // Lex and parse the contents of the file, but only as far as the enabled
+  // rules require.  Lexing is always needed to find waiver comments.
+  std::unique_ptr<VerilogAnalyzer> analyzer;
+  if (config.RequiredAnalysisLevel() ==
+      verible::TextAnalysisLevel::kSyntaxTree) {
+    analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
+  } else {
+    VLOG(1) << "No syntax tree rules enabled, skipping parsing.";
+    analyzer = absl::make_unique<VerilogAnalyzer>(content, filename);
+    analyzer->Tokenize();
+  }
+  return LintAnalyzedFile(stream, sink, filename, *ABSL_DIE_IF_NULL(analyzer),
+                          config, parse_fatal, lint_fatal);
+}
+
+int LintAnalyzedFile(std::ostream* stream, verible::LintDiagnosticSink* sink,
+                     absl::string_view filename,
+                     const VerilogAnalyzer& analyzer,
+                     const LinterConfiguration& config, bool parse_fatal,
+                     bool lint_fatal, LintWaiver* project_waivers) {
+  const auto lex_status = analyzer.LexStatus();
+  const auto parse_status = analyzer.ParseStatus();
   if (!lex_status.ok() || !parse_status.ok()) {
     const std::vector<std::string> syntax_error_messages(
-        analyzer->LinterTokenErrorMessages());
+        analyzer.LinterTokenErrorMessages());
     for (const auto& message : syntax_error_messages) {
       *stream << message << std::endl;
     }
@@ -101,16 +145,17 @@ int LintOneFile(std::ostream* stream, absl::string_view filename,
   }
 
   // Analyze the parsed structure for lint violations.
-  std::ostringstream lint_stream;
-  const absl::Status lint_status = VerilogLintTextStructure(
-      &lint_stream, std::string(filename), content, config, analyzer->Data());
+  size_t num_violations = 0;
+  const absl::Status lint_status =
+      VerilogLintTextStructure(sink, std::string(filename), config,
+                               analyzer.Data(), &num_violations,
+                               project_waivers);
   if (!lint_status.ok()) {
     // Something went wrong with running the lint analysis itself.
     LOG(ERROR) << "Fatal error: " << lint_status.message();
     return 2;
   }
-  *stream << lint_stream.str();
-  if (!lint_stream.str().empty() && lint_fatal) {
+  if (num_violations > 0 && lint_fatal) {
     return 1;
   }
   return 0;
@@ -134,21 +179,46 @@ absl::Status VerilogLinter::Configure(
       LOG(INFO) << "active rule: '" << name << '\'';
     }
   }
+  max_violations_per_rule_ = configuration.max_violations_per_rule;
   auto text_rules = configuration.CreateTextStructureRules();
   for (auto& rule : text_rules) {
+    LimitViolations(rule.get());
     text_structure_linter_.AddRule(std::move(rule));
   }
   auto line_rules = configuration.CreateLineRules();
   for (auto& rule : line_rules) {
+    LimitViolations(rule.get());
     line_linter_.AddRule(std::move(rule));
   }
   auto token_rules = configuration.CreateTokenStreamRules();
   for (auto& rule : token_rules) {
+    LimitViolations(rule.get());
     token_stream_linter_.AddRule(std::move(rule));
   }
-  auto syntax_rules = configuration.CreateSyntaxTreeRules();
-  for (auto& rule : syntax_rules) {
-    syntax_tree_linter_.AddRule(std::move(rule));
+  num_threads_ = verible::ResolveNumThreads(configuration.threads_per_file);
+  if (configuration.partition_syntax_tree && num_threads_ > 1) {
+    // Each thread traverses a share of the syntax tree with its own instances
+    // of all rules.
+    partitioned_syntax_tree_linter_ =
+        absl::make_unique<verible::PartitionedSyntaxTreeLinter>(
+            [this, configuration]() {
+              auto rules = configuration.CreateSyntaxTreeRules();
+              for (auto& rule : rules) LimitViolations(rule.get());
+              return rules;
+            },
+            num_threads_);
+  } else {
+    auto syntax_rules = configuration.CreateSyntaxTreeRules();
+    // Each thread can traverse the syntax tree with a share of the rules.
+    const size_t num_syntax_tree_linters = std::max<size_t>(
+        1, std::min<size_t>(num_threads_, syntax_rules.size()));
+    syntax_tree_linters_.resize(num_syntax_tree_linters);
+    for (size_t i = 0; i < syntax_rules.size(); ++i) {
+      auto& rule = syntax_rules[i];
+      LimitViolations(rule.get());
+      syntax_tree_linters_[i * num_syntax_tree_linters / syntax_rules.size()]
+          .AddRule(std::move(rule));
+    }
   }
 
   absl::Status rc = absl::OkStatus();
@@ -171,25 +241,92 @@ absl::Status VerilogLinter::Configure(
   return rc;
 }
 
-void VerilogLinter::Lint(const TextStructureView& text_structure,
-                         absl::string_view filename) {
-  // Collect all lint waivers in an initial pass.
-  lint_waiver_.ProcessTokenRangesByLine(text_structure);
+void VerilogLinter::LimitViolations(verible::LintRule* rule) const {
+  rule->SetViolationLimit(max_violations_per_rule_);
+  if (max_violations_per_rule_ == 0) return;
+  // Waived violations must not use up the limit, or they could hide the
+  // violations that are reported.
+  const absl::string_view rule_name = rule->Report().lint_rule_name;
+  rule->SetViolationWaivedPredicate(
+      [this, rule_name](const verible::LintViolation& violation) {
+        return ViolationIsWaived(rule_name, violation);
+      });
+}
 
-  // Analyze general text structure.
-  text_structure_linter_.Lint(text_structure, filename);
+bool VerilogLinter::ViolationIsWaived(
+    absl::string_view rule_name,
+    const verible::LintViolation& violation) const {
+  const size_t offset = violation.token.left(text_structure_->Contents());
+  const size_t line = text_structure_->GetLineColumnMap()(offset).line;
+  return lint_waiver_.GetLintWaiver().RuleIsWaivedOnLine(rule_name, line);
+}
 
-  // Analyze lines of text.
-  line_linter_.Lint(text_structure.Lines());
+void VerilogLinter::Lint(const TextStructureView& text_structure,
+                         absl::string_view filename) {
+  text_structure_ = &text_structure;
+  // Rules that stop at a violation limit consult the waivers as they go,
+  // so those must be complete before any rule runs.
+  const bool waivers_first = max_violations_per_rule_ != 0;
+  if (waivers_first) LintWaiversAndTokens(text_structure, true, false);
 
-  // Analyze token stream.
-  token_stream_linter_.Lint(text_structure.TokenStream());
+  // All linters only read the text structure, and every rule belongs to
+  // exactly one of the following tasks, so the tasks can run concurrently.
+  std::vector<std::function<void()>> tasks;
 
   // Analyze syntax tree.
   const verible::ConcreteSyntaxTree& syntax_tree = text_structure.SyntaxTree();
   if (syntax_tree != nullptr) {
-    syntax_tree_linter_.Lint(*syntax_tree);
+    if (partitioned_syntax_tree_linter_ != nullptr) {
+      // This task runs its own threads for the parts of the tree.
+      tasks.push_back(
+          [&]() { partitioned_syntax_tree_linter_->Lint(*syntax_tree); });
+    }
+    for (auto& linter : syntax_tree_linters_) {
+      tasks.push_back([&]() { linter.Lint(*syntax_tree); });
+    }
   }
+
+  // Analyze lines of text, scanning the whole buffer at once.
+  tasks.push_back([&]() { line_linter_.LintText(text_structure.Contents()); });
+
+  // Collect lint waivers, and analyze the token stream, in a single pass over
+  // the lines and their tokens.
+  tasks.push_back([&]() {
+    LintWaiversAndTokens(text_structure, !waivers_first, true);
+  });
+
+  // Analyze general text structure.
+  for (size_t i = 0; i < text_structure_linter_.NumRules(); ++i) {
+    tasks.push_back([&, i]() {
+      text_structure_linter_.LintOneRule(i, text_structure, filename);
+    });
+  }
+
+  verible::ParallelFor(tasks.size(), num_threads_,
+                       [&](size_t i) { tasks[i](); });
+}
+
+void VerilogLinter::LintWaiversAndTokens(
+    const TextStructureView& text_structure, bool collect_waivers,
+    bool lint_tokens) {
+  const auto& lines = text_structure.Lines();
+  const auto& tokens = text_structure.TokenStream();
+  auto next_token = tokens.begin();
+  for (size_t i = 0; i < lines.size(); ++i) {
+    const auto token_range = text_structure.TokenRangeOnLine(i);
+    if (collect_waivers) lint_waiver_.ProcessLine(token_range, i);
+    if (!lint_tokens) continue;
+    for (; next_token < token_range.end(); ++next_token) {
+      token_stream_linter_.HandleToken(*next_token);
+    }
+  }
+  if (lint_tokens) {
+    // Tokens that do not start on any line, like a trailing EOF token.
+    for (; next_token != tokens.end(); ++next_token) {
+      token_stream_linter_.HandleToken(*next_token);
+    }
+  }
+  if (collect_waivers) lint_waiver_.Finalize(text_structure);
 }
 
 static void AppendLintRuleStatuses(
@@ -200,15 +337,29 @@ static void AppendLintRuleStatuses(
   for (const auto& status : new_statuses) {
     cumulative_statuses->push_back(status);
     const auto* waived_lines = waivers.LookupLineSet(status.lint_rule_name);
-    if (waived_lines) {
+    if (waived_lines && !waived_lines->empty()) {
+      // Violations are sorted by location, so the waived line intervals can
+      // be visited in a single merged sweep alongside them.
+      auto next_interval = waived_lines->begin();
       cumulative_statuses->back().WaiveViolations(
           [&](const verible::LintViolation& violation) {
             // Lookup the line number on which the offending token resides.
             const size_t offset = violation.token.left(text_base);
             const size_t line = line_map(offset).line;
+            // Skip past intervals that end at or before this line.
+            // Intervals are half-open: [first, second).
+            if (next_interval != waived_lines->begin() &&
+                line < std::prev(next_interval)->second) {
+              // Out of order (not expected), restart the sweep.
+              next_interval = waived_lines->begin();
+            }
+            while (next_interval != waived_lines->end() &&
+                   next_interval->second <= line) {
+              ++next_interval;
+            }
             // Check that line number against the set of waived lines.
-            const bool waived =
-                LintWaiver::LineSetContains(*waived_lines, line);
+            const bool waived = next_interval != waived_lines->end() &&
+                                next_interval->first <= line;
             VLOG(2) << "Violation of " << status.lint_rule_name
                     << " rule on line " << line + 1
                     << (waived ? " is waived." : " is not waived.");
@@ -228,8 +379,27 @@ std::vector<LintRuleStatus> VerilogLinter::ReportStatus(
                          line_map, text_base, &statuses);
   AppendLintRuleStatuses(token_stream_linter_.ReportStatus(), waivers, line_map,
                          text_base, &statuses);
-  AppendLintRuleStatuses(syntax_tree_linter_.ReportStatus(), waivers, line_map,
-                         text_base, &statuses);
+  // Syntax tree rules are reported in the same order regardless of how they
+  // were distributed among linters.
+  if (partitioned_syntax_tree_linter_ != nullptr) {
+    AppendLintRuleStatuses(partitioned_syntax_tree_linter_->ReportStatus(),
+                           waivers, line_map, text_base, &statuses);
+  }
+  for (const auto& linter : syntax_tree_linters_) {
+    AppendLintRuleStatuses(linter.ReportStatus(), waivers, line_map, text_base,
+                           &statuses);
+  }
+  if (max_violations_per_rule_ != 0) {
+    // Rules may overshoot their limit by the few violations found in their
+    // last step.
+    for (auto& status : statuses) {
+      if (status.violations.size() > max_violations_per_rule_) {
+        status.violations.erase(
+            status.violations.begin() + max_violations_per_rule_,
+            status.violations.end());
+      }
+    }
+  }
   return statuses;
 }
 
@@ -303,6 +473,13 @@ LinterConfiguration LinterConfigurationFromFlags(
   // Apply external waivers
   config.external_waivers = absl::GetFlag(FLAGS_waiver_files);
 
+  config.max_violations_per_rule =
+      std::max(absl::GetFlag(FLAGS_max_violations_per_rule), 0);
+  config.max_violations_per_file =
+      std::max(absl::GetFlag(FLAGS_max_violations_per_file), 0);
+  config.threads_per_file = absl::GetFlag(FLAGS_threads_per_file);
+  config.partition_syntax_tree = absl::GetFlag(FLAGS_partition_syntax_tree);
+
   return config;
 }
 
@@ -311,6 +488,33 @@ absl::Status VerilogLintTextStructure(std::ostream* stream,
                                       const std::string& contents,
                                       const LinterConfiguration& config,
                                       const TextStructureView& text_structure) {
+  verible::TextLintDiagnosticSink sink(stream);
+  size_t num_violations;
+  return VerilogLintTextStructure(&sink, filename, config, text_structure,
+                                  &num_violations);
+}
+
+// Copies the waived lines of the enabled project rules from 'from' to 'to',
+// keyed by the registered rule names instead of the text of waiver comments.
+static void CopyProjectRuleWaivers(const LinterConfiguration& config,
+                                   const LintWaiver& from, LintWaiver* to) {
+  for (const auto rule_name : analysis::RegisteredProjectRulesNames()) {
+    if (!config.RuleIsOn(rule_name)) continue;
+    const auto* waived_lines = from.LookupLineSet(rule_name);
+    if (waived_lines == nullptr) continue;
+    for (const auto& interval : *waived_lines) {
+      to->WaiveLineRange(rule_name, interval.first, interval.second);
+    }
+  }
+}
+
+absl::Status VerilogLintTextStructure(verible::LintDiagnosticSink* sink,
+                                      const std::string& filename,
+                                      const LinterConfiguration& config,
+                                      const TextStructureView& text_structure,
+                                      size_t* num_violations,
+                                      LintWaiver* project_waivers) {
+  *num_violations = 0;
   // Create the linter, add rules, and run it.
   VerilogLinter linter;
   const absl::Status configuration_status = linter.Configure(config);
@@ -319,6 +523,9 @@ absl::Status VerilogLintTextStructure(std::ostream* stream,
   }
 
   linter.Lint(text_structure, filename);
+  if (project_waivers != nullptr) {
+    CopyProjectRuleWaivers(config, linter.Waivers(), project_waivers);
+  }
 
   const absl::string_view text_base = text_structure.Contents();
   // Each enabled lint rule yields a collection of violations.
@@ -333,10 +540,9 @@ absl::Status VerilogLintTextStructure(std::ostream* stream,
     VLOG(1) << "No lint violations found." << std::endl;
   } else {
     VLOG(1) << "Lint Violations (" << total_violations << "): " << std::endl;
-    // Output results to stream using formatter.
-    verible::LintStatusFormatter formatter(contents);
-    formatter.FormatLintRuleStatuses(stream, linter_statuses, text_base,
-                                     filename);
+    *num_violations = verible::ReportLintRuleStatuses(
+        linter_statuses, text_structure.GetLineColumnMap(), text_base, filename,
+        config.max_violations_per_file, sink);
   }
   return absl::OkStatus();
 }
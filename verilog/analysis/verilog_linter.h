@@ -15,21 +15,27 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_VERILOG_LINTER_H_
 #define VERIBLE_VERILOG_ANALYSIS_VERILOG_LINTER_H_
 
+#include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/analysis/line_linter.h"
+#include "common/analysis/lint_diagnostic_sink.h"
+#include "common/analysis/lint_rule.h"
 #include "common/analysis/lint_rule_status.h"
 #include "common/analysis/lint_waiver.h"
+#include "common/analysis/partitioned_syntax_tree_linter.h"
 #include "common/analysis/syntax_tree_linter.h"
 #include "common/analysis/text_structure_linter.h"
 #include "common/analysis/token_stream_linter.h"
 #include "common/strings/line_column_map.h"
 #include "common/text/text_structure.h"
 #include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/verilog_analyzer.h"
 #include "verilog/analysis/verilog_linter_configuration.h"
 
 namespace verilog {
@@ -48,6 +54,24 @@ int LintOneFile(std::ostream* stream, absl::string_view filename,
                 const LinterConfiguration& config, bool parse_fatal,
                 bool lint_fatal);
 
+// Same as above, except that syntax errors are printed to 'stream', and
+// lint violations are passed to 'sink' as soon as the file is analyzed.
+int LintOneFile(std::ostream* stream, verible::LintDiagnosticSink* sink,
+                absl::string_view filename, const LinterConfiguration& config,
+                bool parse_fatal, bool lint_fatal);
+
+// Same as above, except that the file has already been lexed (and parsed, if
+// any enabled rule needs a syntax tree) by 'analyzer'.
+// If 'project_waivers' is not null, it receives the file's waivers of the
+// enabled project rules (see ProjectLintRule), which stay valid after the
+// file's text is gone.
+int LintAnalyzedFile(std::ostream* stream, verible::LintDiagnosticSink* sink,
+                     absl::string_view filename,
+                     const VerilogAnalyzer& analyzer,
+                     const LinterConfiguration& config, bool parse_fatal,
+                     bool lint_fatal,
+                     verible::LintWaiver* project_waivers = nullptr);
+
 // VerilogLinter analyzes a TextStructureView of Verilog source code.
 // This uses syntax-tree based analyses and lexical token-stream analyses.
 class VerilogLinter {
@@ -65,21 +89,55 @@ class VerilogLinter {
   std::vector<verible::LintRuleStatus> ReportStatus(
       const verible::LineColumnMap&, absl::string_view text_base);
 
+  // Returns the waivers collected by Lint().
+  const verible::LintWaiver& Waivers() const {
+    return lint_waiver_.GetLintWaiver();
+  }
+
  private:
+  // Collects lint waivers, and/or runs the token stream rules, in a single
+  // pass over the lines and their tokens.
+  void LintWaiversAndTokens(const verible::TextStructureView& text_structure,
+                            bool collect_waivers, bool lint_tokens);
+
+  // Applies max_violations_per_rule_ to 'rule', counting only the violations
+  // that are not waived.
+  void LimitViolations(verible::LintRule* rule) const;
+
+  // Returns true if 'violation' of the named rule is waived in the text
+  // structure being linted.  Waivers must have been collected.
+  bool ViolationIsWaived(absl::string_view rule_name,
+                         const verible::LintViolation& violation) const;
+
   // Line based linter.
   verible::LineLinter line_linter_;
 
   // Token-based linter.
   verible::TokenStreamLinter token_stream_linter_;
 
-  // Syntax-tree based linter.
-  verible::SyntaxTreeLinter syntax_tree_linter_;
+  // Syntax-tree based linters, each with a consecutive subset of the rules,
+  // so that each can traverse the syntax tree on a different thread.
+  std::vector<verible::SyntaxTreeLinter> syntax_tree_linters_;
+
+  // Replaces syntax_tree_linters_ if the configuration partitions the syntax
+  // tree instead of the rules.
+  std::unique_ptr<verible::PartitionedSyntaxTreeLinter>
+      partitioned_syntax_tree_linter_;
 
   // TextStructure-based linter.
   verible::TextStructureLinter text_structure_linter_;
 
   // Tracks the set of waived lines per rule.
   verible::LintWaiverBuilder lint_waiver_;
+
+  // Maximum number of violations reported by each rule (0: no limit).
+  size_t max_violations_per_rule_ = 0;
+
+  // Text structure being linted, set by Lint().
+  const verible::TextStructureView* text_structure_ = nullptr;
+
+  // Number of threads that run the rules concurrently (see ResolveNumThreads).
+  int num_threads_ = 1;
 };
 
 // Creates a linter configuration from global flags.
@@ -115,6 +173,15 @@ absl::Status VerilogLintTextStructure(
     const std::string& contents, const LinterConfiguration& config,
     const verible::TextStructureView& text_structure);
 
+// Same as above, except that violations are passed to 'sink', and
+// 'num_violations' is set to the number of violations that were reported.
+// 'project_waivers' is as in LintAnalyzedFile().
+absl::Status VerilogLintTextStructure(
+    verible::LintDiagnosticSink* sink, const std::string& filename,
+    const LinterConfiguration& config,
+    const verible::TextStructureView& text_structure, size_t* num_violations,
+    verible::LintWaiver* project_waivers = nullptr);
+
 // Prints the rule, description and default_enabled.
 absl::Status PrintRuleInfo(std::ostream*,
                            const analysis::LintRuleDescriptionsMap&,
@@ -155,6 +155,16 @@ std::string RuleBundle::UnparseConfiguration(const char separator) const {
                        std::string(1, separator));
 }
 
+void LinterConfiguration::TurnOn(const analysis::LintRuleId& rule) {
+  configuration_[rule] = {true, ""};
+  UpdateRequiredAnalysisLevel();
+}
+
+void LinterConfiguration::TurnOff(const analysis::LintRuleId& rule) {
+  configuration_[rule] = {false, ""};
+  UpdateRequiredAnalysisLevel();
+}
+
 bool LinterConfiguration::RuleIsOn(const analysis::LintRuleId& rule) const {
   const auto* entry = FindOrNull(configuration_, rule);
   if (entry == nullptr) return false;
@@ -166,16 +176,19 @@ void LinterConfiguration::UseRuleSet(const RuleSet& rules) {
   switch (rules) {
     case RuleSet::kAll: {
       for (const auto& rule : analysis::RegisteredTextStructureRulesNames()) {
-        TurnOn(rule);
+        configuration_[rule] = {true, ""};
       }
       for (const auto& rule : analysis::RegisteredSyntaxTreeRulesNames()) {
-        TurnOn(rule);
+        configuration_[rule] = {true, ""};
       }
       for (const auto& rule : analysis::RegisteredTokenStreamRulesNames()) {
-        TurnOn(rule);
+        configuration_[rule] = {true, ""};
       }
       for (const auto& rule : analysis::RegisteredLineRulesNames()) {
-        TurnOn(rule);
+        configuration_[rule] = {true, ""};
+      }
+      for (const auto& rule : analysis::RegisteredProjectRulesNames()) {
+        configuration_[rule] = {true, ""};
       }
       break;
     }
@@ -183,9 +196,10 @@ void LinterConfiguration::UseRuleSet(const RuleSet& rules) {
       break;
     case RuleSet::kDefault:
       for (const auto& rule : analysis::kDefaultRuleSet) {
-        TurnOn(rule);
+        configuration_[rule] = {true, ""};
       }
   }
+  UpdateRequiredAnalysisLevel();
 }
 
 void LinterConfiguration::UseRuleBundle(const RuleBundle& rule_bundle) {
@@ -195,6 +209,7 @@ void LinterConfiguration::UseRuleBundle(const RuleBundle& rule_bundle) {
     // guaranteed lifetime.
     configuration_[rule_pair.first] = rule_pair.second;
   }
+  UpdateRequiredAnalysisLevel();
 }
 
 void LinterConfiguration::UseProjectPolicy(const ProjectPolicy& policy,
@@ -204,12 +219,13 @@ void LinterConfiguration::UseProjectPolicy(const ProjectPolicy& policy,
             << "\" from project policy [" << policy.name << "], applying it.";
     for (const auto rule : policy.disabled_rules) {
       VLOG(1) << "  disabling rule: " << rule;
-      TurnOff(rule);
+      configuration_[rule] = {false, ""};
     }
     for (const auto rule : policy.enabled_rules) {
       VLOG(1) << "  enabling rule: " << rule;
-      TurnOn(rule);
+      configuration_[rule] = {true, ""};
     }
+    UpdateRequiredAnalysisLevel();
   }
 }
 
@@ -278,6 +294,21 @@ LinterConfiguration::CreateTextStructureRules() const {
       configuration_, analysis::CreateTextStructureLintRule);
 }
 
+void LinterConfiguration::UpdateRequiredAnalysisLevel() {
+  using verible::TextAnalysisLevel;
+  if (!CreateSyntaxTreeRules().empty()) {
+    required_analysis_level_ = TextAnalysisLevel::kSyntaxTree;
+    return;
+  }
+  TextAnalysisLevel level = CreateTokenStreamRules().empty()
+                                ? TextAnalysisLevel::kLines
+                                : TextAnalysisLevel::kTokens;
+  for (const auto& rule : CreateTextStructureRules()) {
+    level = std::max(level, rule->RequiredAnalysisLevel());
+  }
+  required_analysis_level_ = level;
+}
+
 bool LinterConfiguration::operator==(const LinterConfiguration& config) const {
   return ActiveRuleIds() == config.ActiveRuleIds();
 }
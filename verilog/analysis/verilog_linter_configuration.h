@@ -15,6 +15,7 @@
 #ifndef VERIBLE_VERILOG_ANALYSIS_VERILOG_LINTER_CONFIGURATION_H_
 #define VERIBLE_VERILOG_ANALYSIS_VERILOG_LINTER_CONFIGURATION_H_
 
+#include <cstddef>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -149,13 +150,9 @@ class LinterConfiguration {
   // This is copy-able.
   LinterConfiguration(const LinterConfiguration&) = default;
 
-  void TurnOn(const analysis::LintRuleId& rule) {
-    configuration_[rule] = {true, ""};
-  }
+  void TurnOn(const analysis::LintRuleId& rule);
 
-  void TurnOff(const analysis::LintRuleId& rule) {
-    configuration_[rule] = {false, ""};
-  }
+  void TurnOff(const analysis::LintRuleId& rule);
 
   bool RuleIsOn(const analysis::LintRuleId& rule) const;
 
@@ -196,17 +193,49 @@ class LinterConfiguration {
   std::vector<std::unique_ptr<verible::TextStructureLintRule>>
   CreateTextStructureRules() const;
 
+  // Returns the cheapest level of analysis that satisfies all of the enabled
+  // rules, so that analysis beyond that can be skipped.
+  // This is computed whenever the set of enabled rules changes, not per call.
+  verible::TextAnalysisLevel RequiredAnalysisLevel() const {
+    return required_analysis_level_;
+  }
+
   // Path to external lint waivers configuration file
   std::string external_waivers;
 
+  // Each rule stops collecting violations after this many that are not
+  // waived (0: no limit).
+  size_t max_violations_per_rule = 0;
+
+  // At most this many violations are reported per file (0: no limit).
+  size_t max_violations_per_file = 0;
+
+  // Number of threads that run the rules on each file concurrently, where
+  // 1 runs them one after another, and 0 uses one per hardware thread.
+  // Results are the same either way.
+  int threads_per_file = 1;
+
+  // If true, and threads_per_file is not 1, syntax tree rules lint ranges of
+  // the top-level items of a file (modules, packages, classes, etc.) on
+  // different threads, instead of traversing the whole tree on each thread.
+  bool partition_syntax_tree = false;
+
   // Returns true if configurations are equivalent.
   bool operator==(const LinterConfiguration&) const;
 
   bool operator!=(const LinterConfiguration& r) const { return !(*this == r); }
 
  private:
+  // Recomputes required_analysis_level_ from the enabled rules, which
+  // requires creating them.
+  void UpdateRequiredAnalysisLevel();
+
   // map of all enabled rules
   std::map<analysis::LintRuleId, RuleSetting> configuration_;
+
+  // Cached result of RequiredAnalysisLevel(), for configuration_.
+  verible::TextAnalysisLevel required_analysis_level_ =
+      verible::TextAnalysisLevel::kLines;
 };
 
 std::ostream& operator<<(std::ostream&, const LinterConfiguration&);
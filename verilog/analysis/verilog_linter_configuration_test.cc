@@ -336,6 +336,43 @@ TEST(VerilogSyntaxTreeLinterConfigurationTest, TurnOnTurnOff) {
   EXPECT_THAT(status, IsEmpty());
 }
 
+// Verifies that the required analysis level follows the enabled rule types.
+TEST(LinterConfigurationTest, RequiredAnalysisLevel) {
+  using verible::TextAnalysisLevel;
+  LinterConfiguration config;
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kLines);
+  config.TurnOn("test-rule-4");  // line rule
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kLines);
+  config.TurnOn("test-rule-3");  // token stream rule
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kTokens);
+  config.TurnOn("test-rule-1");  // syntax tree rule
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kSyntaxTree);
+  config.TurnOff("test-rule-1");
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kTokens);
+  // Text structure rules require a syntax tree unless they say otherwise.
+  config.TurnOn("test-rule-5");
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kSyntaxTree);
+}
+
+// Verifies that the required analysis level follows every way of changing
+// the enabled rules, and is kept by copies.
+TEST(LinterConfigurationTest, RequiredAnalysisLevelFollowsUpdates) {
+  using verible::TextAnalysisLevel;
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kAll);
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kSyntaxTree);
+  config.UseRuleSet(RuleSet::kNone);
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kLines);
+  config.UseRuleBundle({{{"test-rule-3", {true, ""}}}});
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kTokens);
+  const ProjectPolicy policy{"policyX", {"path"}, {}, {"owner"},
+                             {},        {"test-rule-1"}};
+  config.UseProjectPolicy(policy, "some/path/foo");
+  EXPECT_EQ(config.RequiredAnalysisLevel(), TextAnalysisLevel::kSyntaxTree);
+  const LinterConfiguration copy(config);
+  EXPECT_EQ(copy.RequiredAnalysisLevel(), TextAnalysisLevel::kSyntaxTree);
+}
+
 TEST(LinterConfigurationTest, ComparisonOperatorSameElement) {
   LinterConfiguration config1, config2;
   EXPECT_EQ(config1, config2);
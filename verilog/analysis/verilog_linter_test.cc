@@ -132,6 +132,117 @@ TEST_F(LintOneFileTest, LintError) {
   }
 }
 
+// Tests that parsing is skipped when no enabled rule needs a syntax tree.
+TEST(LintOneFileSkipParsingTest, SyntaxErrorNotReported) {
+  LinterConfiguration config;
+  config.TurnOn("line-length");
+  config.TurnOn("posix-eof");
+  const ScopedTestFile temp_file(testing::TempDir(), "class foo;\n");
+  std::ostringstream output;
+  const int exit_code =
+      LintOneFile(&output, temp_file.filename(), config, true, true);
+  EXPECT_EQ(exit_code, 0) << "output:\n" << output.str();
+  EXPECT_TRUE(output.str().empty()) << output.str();
+}
+
+// Tests that violations are capped per rule and per file.
+TEST(LintOneFileViolationLimitTest, PerRuleAndPerFile) {
+  const ScopedTestFile temp_file(testing::TempDir(),
+                                 "wire a;  \nwire b;  \nwire c;  \n");
+  LinterConfiguration config;
+  config.TurnOn("no-trailing-spaces");
+  const auto count_lines = [](const std::string& text) {
+    return std::count(text.begin(), text.end(), '\n');
+  };
+  {
+    std::ostringstream output;
+    LintOneFile(&output, temp_file.filename(), config, false, false);
+    EXPECT_EQ(count_lines(output.str()), 3) << output.str();
+  }
+  config.max_violations_per_rule = 1;
+  {
+    std::ostringstream output;
+    LintOneFile(&output, temp_file.filename(), config, false, false);
+    EXPECT_EQ(count_lines(output.str()), 1) << output.str();
+  }
+  config.max_violations_per_rule = 0;
+  config.max_violations_per_file = 2;
+  {
+    std::ostringstream output;
+    LintOneFile(&output, temp_file.filename(), config, false, false);
+    EXPECT_EQ(count_lines(output.str()), 2) << output.str();
+  }
+}
+
+// Tests that waived violations do not use up the per-rule limit.
+TEST(LintOneFileViolationLimitTest, WaivedViolationsNotCounted) {
+  const ScopedTestFile temp_file(
+      testing::TempDir(),
+      "wire a;  // verilog_lint: waive no-trailing-spaces  \n"
+      "wire b;  // verilog_lint: waive no-trailing-spaces  \n"
+      "wire c;  \n");
+  LinterConfiguration config;
+  config.TurnOn("no-trailing-spaces");
+  config.max_violations_per_rule = 1;
+  std::ostringstream output;
+  const int exit_code =
+      LintOneFile(&output, temp_file.filename(), config, false, true);
+  EXPECT_EQ(exit_code, 1) << output.str();
+  EXPECT_TRUE(absl::StrContains(output.str(), ":3:")) << output.str();
+}
+
+TEST(LintOneFileThreadsPerFileTest, SameAsSequential) {
+  const ScopedTestFile temp_file(
+      testing::TempDir(),
+      "module   m;  \n"
+      "  always_ff @(posedge clk) a = b;\n"
+      "  wire   [0:3]  w;  // verilog_lint: waive "
+      "packed-dimensions-range-ordering\n"
+      "endmodule\n"
+      "class  c;\n"
+      "endclass : d");
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kAll);
+  std::ostringstream sequential;
+  LintOneFile(&sequential, temp_file.filename(), config, false, false);
+  EXPECT_FALSE(sequential.str().empty());
+  for (int threads : {2, 8, 0}) {
+    config.threads_per_file = threads;
+    std::ostringstream parallel;
+    LintOneFile(&parallel, temp_file.filename(), config, false, false);
+    EXPECT_EQ(parallel.str(), sequential.str()) << "threads: " << threads;
+  }
+}
+
+TEST(LintOneFilePartitionSyntaxTreeTest, SameAsSequential) {
+  const ScopedTestFile temp_file(testing::TempDir(),
+                                 "package  p;\n"
+                                 "  parameter int  Foo = 1;\n"
+                                 "endpackage\n"
+                                 "module   m;  \n"
+                                 "  always_ff @(posedge clk) a = b;;;\n"
+                                 "  wire   [0:3]  w;\n"
+                                 "endmodule\n"
+                                 "typedef int t;\n"
+                                 "class  c;\n"
+                                 "endclass : d\n"
+                                 "module   n;\n"
+                                 "  always_ff @(posedge clk) c = d;\n"
+                                 "endmodule\n");
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kAll);
+  std::ostringstream sequential;
+  LintOneFile(&sequential, temp_file.filename(), config, false, false);
+  EXPECT_FALSE(sequential.str().empty());
+  config.partition_syntax_tree = true;
+  for (int threads : {1, 2, 8}) {
+    config.threads_per_file = threads;
+    std::ostringstream parallel;
+    LintOneFile(&parallel, temp_file.filename(), config, false, false);
+    EXPECT_EQ(parallel.str(), sequential.str()) << "threads: " << threads;
+  }
+}
+
 class VerilogLinterTest : public DefaultLinterConfigTestFixture,
                           public testing::Test {
  public:
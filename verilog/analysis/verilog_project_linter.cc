@@ -0,0 +1,179 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/analysis/verilog_project_linter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "common/analysis/lint_diagnostic_sink.h"
+#include "common/analysis/lint_rule_status.h"
+#include "common/analysis/lint_waiver.h"
+#include "common/util/file_util.h"
+#include "common/util/logging.h"
+#include "common/util/parallel_for.h"
+#include "verilog/analysis/lint_rule_registry.h"
+#include "verilog/analysis/project_declaration_index.h"
+#include "verilog/analysis/project_lint_rule.h"
+#include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/analysis/verilog_linter.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+
+namespace verilog {
+
+using verible::LintDiagnostic;
+using verible::LintDiagnosticSink;
+
+namespace {
+// A finding of a project rule.
+struct ProjectFinding {
+  const DesignElementSymbol* symbol;
+  absl::string_view rule_name;
+  std::string url;
+  std::string reason;
+};
+}  // namespace
+
+size_t LintProjectDeclarationIndex(
+    const ProjectDeclarationIndex& index,
+    const std::vector<std::string>& filenames,
+    const std::vector<LinterConfiguration>& configs,
+    const std::vector<verible::LintWaiver>& waivers, LintDiagnosticSink* sink) {
+  CHECK_EQ(filenames.size(), configs.size());
+  CHECK_EQ(filenames.size(), waivers.size());
+  // Position of each file in the arguments.
+  std::map<absl::string_view, size_t> file_positions;
+  for (size_t i = 0; i < filenames.size(); ++i) {
+    file_positions.emplace(filenames[i], i);
+  }
+
+  // Rules run in a fixed order, so that findings at the same position are
+  // reported in the same order every time.
+  std::vector<analysis::LintRuleId> rule_names =
+      analysis::RegisteredProjectRulesNames();
+  std::sort(rule_names.begin(), rule_names.end());
+  std::vector<ProjectFinding> findings;
+  for (const auto rule_name : rule_names) {
+    if (std::none_of(configs.begin(), configs.end(),
+                     [=](const LinterConfiguration& config) {
+                       return config.RuleIsOn(rule_name);
+                     })) {
+      continue;
+    }
+    const auto rule = analysis::CreateProjectLintRule(rule_name);
+    rule->Lint(index);
+    const std::string url(rule->Report().url);
+    for (const auto& violation : rule->Violations()) {
+      const auto found = file_positions.find(violation.symbol->filename);
+      if (found != file_positions.end()) {
+        const size_t file = found->second;
+        if (!configs[file].RuleIsOn(rule_name) ||
+            waivers[file].RuleIsWaivedOnLine(
+                rule_name, violation.symbol->position.line)) {
+          continue;
+        }
+      }
+      findings.push_back({violation.symbol, rule_name, url, violation.reason});
+    }
+  }
+
+  std::stable_sort(findings.begin(), findings.end(),
+                   [](const ProjectFinding& left, const ProjectFinding& right) {
+                     return SymbolLocationLess(*left.symbol, *right.symbol);
+                   });
+  for (const auto& finding : findings) {
+    LintDiagnostic diagnostic;
+    diagnostic.path = finding.symbol->filename;
+    diagnostic.position = finding.symbol->position;
+    diagnostic.rule_name = finding.rule_name;
+    diagnostic.url = finding.url;
+    diagnostic.reason = finding.reason;
+    sink->Report(diagnostic);
+  }
+  return findings.size();
+}
+
+namespace {
+// Output of linting one project file, held until it is that file's turn to
+// be reported.
+struct ProjectFileResult {
+  std::ostringstream syntax_errors;
+  verible::BufferedLintDiagnosticSink diagnostics;
+  verible::LintWaiver project_waivers;
+  int exit_status = 0;
+};
+
+void LintProjectFile(absl::string_view filename,
+                     const LinterConfiguration& config, bool parse_fatal,
+                     bool lint_fatal, ProjectDeclarationIndex* index,
+                     ProjectFileResult* result) {
+  std::string content;
+  if (!verible::file::GetContents(filename, &content).ok()) {
+    result->exit_status = 2;
+    return;
+  }
+
+  // Always parse, even if no enabled rule needs a syntax tree, because the
+  // index is built from syntax trees.
+  const auto analyzer =
+      VerilogAnalyzer::AnalyzeAutomaticMode(content, filename);
+  result->exit_status = LintAnalyzedFile(
+      &result->syntax_errors, &result->diagnostics, filename,
+      *ABSL_DIE_IF_NULL(analyzer), config, parse_fatal, lint_fatal,
+      &result->project_waivers);
+  index->AddFile(filename, analyzer->Data());
+}
+}  // namespace
+
+int LintProject(std::ostream* stream, LintDiagnosticSink* sink,
+                const std::vector<std::string>& filenames,
+                const std::vector<LinterConfiguration>& configs,
+                bool parse_fatal, bool lint_fatal, int num_threads) {
+  CHECK_EQ(filenames.size(), configs.size());
+  ProjectDeclarationIndex index;
+  std::vector<ProjectFileResult> results(filenames.size());
+  verible::ParallelFor(filenames.size(), num_threads, [&](size_t i) {
+    LintProjectFile(filenames[i], configs[i], parse_fatal, lint_fatal, &index,
+                    &results[i]);
+  });
+
+  int exit_status = 0;
+  std::vector<verible::LintWaiver> waivers;
+  waivers.reserve(results.size());
+  for (auto& result : results) {
+    *stream << result.syntax_errors.str();
+    result.diagnostics.ReplayTo(sink);
+    exit_status = std::max(exit_status, result.exit_status);
+    waivers.push_back(std::move(result.project_waivers));
+  }
+
+  // All files have been indexed at this point.
+  index.Sort();
+  const size_t num_findings =
+      LintProjectDeclarationIndex(index, filenames, configs, waivers, sink);
+  if (num_findings > 0 && lint_fatal) {
+    exit_status = std::max(exit_status, 1);
+  }
+  return exit_status;
+}
+
+}  // namespace verilog
@@ -0,0 +1,66 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Project-wide linting: all files of a project are parsed and linted
+// concurrently, while the modules, interfaces, and packages that each file
+// declares and references are collected into a shared index.
+// Once every file is done, the project rules (see ProjectLintRule) run
+// against the index alone, so no file is ever parsed twice.
+
+#ifndef VERIBLE_VERILOG_ANALYSIS_VERILOG_PROJECT_LINTER_H_
+#define VERIBLE_VERILOG_ANALYSIS_VERILOG_PROJECT_LINTER_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "common/analysis/lint_diagnostic_sink.h"
+#include "common/analysis/lint_waiver.h"
+#include "verilog/analysis/project_declaration_index.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+
+namespace verilog {
+
+// Runs the project rules against a complete, sorted 'index', and reports
+// findings to 'sink', ordered by file and position.
+// 'configs' and 'waivers' hold the configuration and the project rule waivers
+// of each of 'filenames', at the same position.  A rule runs if any of the
+// configurations enables it, and each of its findings is reported only if the
+// configuration of the finding's file enables the rule, and the file's
+// waivers do not waive it on that line.
+// Returns the number of findings reported.
+size_t LintProjectDeclarationIndex(
+    const ProjectDeclarationIndex& index,
+    const std::vector<std::string>& filenames,
+    const std::vector<LinterConfiguration>& configs,
+    const std::vector<verible::LintWaiver>& waivers,
+    verible::LintDiagnosticSink* sink);
+
+// Lints all 'filenames' as one project, where 'configs' holds the
+// configuration for each file, at the same position.
+// Files are parsed and linted on 'num_threads' threads (see
+// verible::ResolveNumThreads()).  Their syntax errors and lint violations are
+// still printed to 'stream' and reported to 'sink' file by file, in the given
+// order, followed by the cross-file findings of LintProjectDeclarationIndex().
+// Returns an exit_code like LintOneFile(), the maximum over all files.
+// Cross-file findings count as lint violations for 'lint_fatal'.
+int LintProject(std::ostream* stream, verible::LintDiagnosticSink* sink,
+                const std::vector<std::string>& filenames,
+                const std::vector<LinterConfiguration>& configs,
+                bool parse_fatal, bool lint_fatal, int num_threads);
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_ANALYSIS_VERILOG_PROJECT_LINTER_H_
@@ -0,0 +1,207 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/analysis/verilog_project_linter.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "common/analysis/lint_diagnostic_sink.h"
+#include "common/analysis/lint_waiver.h"
+#include "common/util/file_util.h"
+#include "verilog/analysis/project_declaration_index.h"
+#include "verilog/analysis/project_declaration_index_test_utils.h"
+#include "verilog/analysis/verilog_linter_configuration.h"
+
+namespace verilog {
+namespace {
+
+using ::testing::HasSubstr;
+using verible::file::testing::ScopedTestFile;
+
+// Returns configurations that enable all rules for each of 'filenames'.
+std::vector<LinterConfiguration> AllRulesConfigs(
+    const std::vector<std::string>& filenames) {
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kAll);
+  return std::vector<LinterConfiguration>(filenames.size(), config);
+}
+
+TEST(LintProjectDeclarationIndexTest, NoFindings) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("package p;\nendpackage\n", "p.sv", &index);
+  AddCodeToIndex("module sub;\nendmodule\n", "sub.sv", &index);
+  AddCodeToIndex("module top;\n  import p::*;\n  sub u_sub();\nendmodule\n",
+                 "top.sv", &index);
+  index.Sort();
+  const std::vector<std::string> filenames{"p.sv", "sub.sv", "top.sv"};
+  std::ostringstream stream;
+  verible::TextLintDiagnosticSink sink(&stream);
+  EXPECT_EQ(LintProjectDeclarationIndex(
+                index, filenames, AllRulesConfigs(filenames),
+                std::vector<verible::LintWaiver>(filenames.size()), &sink),
+            0);
+  EXPECT_EQ(stream.str(), "");
+}
+
+TEST(LintProjectDeclarationIndexTest, CrossFileFindings) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("package p;\nendpackage\nmodule m;\nendmodule\n", "a.sv",
+                 &index);
+  AddCodeToIndex("module m;\n  missing u_missing();\nendmodule\n", "b.sv",
+                 &index);
+  index.Sort();
+  const std::vector<std::string> filenames{"a.sv", "b.sv"};
+  std::ostringstream stream;
+  verible::TextLintDiagnosticSink sink(&stream);
+  EXPECT_EQ(LintProjectDeclarationIndex(
+                index, filenames, AllRulesConfigs(filenames),
+                std::vector<verible::LintWaiver>(filenames.size()), &sink),
+            3);
+  const std::string output(stream.str());
+  EXPECT_THAT(output, HasSubstr("a.sv:1:9: Package \"p\" is never referenced"));
+  EXPECT_THAT(output, HasSubstr("b.sv:1:8: module name \"m\" is already "
+                                "declared as a module at a.sv:3:8."));
+  EXPECT_THAT(output, HasSubstr("b.sv:2:3: Instance of \"missing\""));
+  // Ordered by file and position.
+  EXPECT_LT(output.find("a.sv:1:9"), output.find("b.sv:1:8"));
+  EXPECT_LT(output.find("b.sv:1:8"), output.find("b.sv:2:3"));
+}
+
+// Tests that a finding is only reported if its file enables the rule.
+TEST(LintProjectDeclarationIndexTest, RuleDisabledForFile) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("module m;\nendmodule\n", "a.sv", &index);
+  AddCodeToIndex("module m;\nendmodule\n", "b.sv", &index);
+  AddCodeToIndex("module m;\nendmodule\n", "c.sv", &index);
+  index.Sort();
+  const std::vector<std::string> filenames{"a.sv", "b.sv", "c.sv"};
+  auto configs = AllRulesConfigs(filenames);
+  configs[1].TurnOff("duplicate-design-element");
+  std::ostringstream stream;
+  verible::TextLintDiagnosticSink sink(&stream);
+  EXPECT_EQ(LintProjectDeclarationIndex(
+                index, filenames, configs,
+                std::vector<verible::LintWaiver>(filenames.size()), &sink),
+            1);
+  const std::string output(stream.str());
+  EXPECT_THAT(output, HasSubstr("c.sv:1:8:")) << output;
+
+  // With the rule disabled everywhere, it does not run at all.
+  for (auto& config : configs) config.TurnOff("duplicate-design-element");
+  std::ostringstream disabled_stream;
+  verible::TextLintDiagnosticSink disabled_sink(&disabled_stream);
+  EXPECT_EQ(LintProjectDeclarationIndex(
+                index, filenames, configs,
+                std::vector<verible::LintWaiver>(filenames.size()),
+                &disabled_sink),
+            0);
+}
+
+// Tests that a finding is not reported if its file waives the rule there.
+TEST(LintProjectDeclarationIndexTest, WaivedFinding) {
+  ProjectDeclarationIndex index;
+  AddCodeToIndex("package p;\nendpackage\npackage q;\nendpackage\n", "a.sv",
+                 &index);
+  index.Sort();
+  const std::vector<std::string> filenames{"a.sv"};
+  std::vector<verible::LintWaiver> waivers(filenames.size());
+  waivers[0].WaiveOneLine("unused-package", 2);
+  std::ostringstream stream;
+  verible::TextLintDiagnosticSink sink(&stream);
+  EXPECT_EQ(LintProjectDeclarationIndex(index, filenames,
+                                        AllRulesConfigs(filenames), waivers,
+                                        &sink),
+            1);
+  const std::string output(stream.str());
+  EXPECT_THAT(output, HasSubstr("a.sv:1:9: Package \"p\"")) << output;
+}
+
+TEST(LintProjectTest, ReportsFilesInOrder) {
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kNone);
+  config.TurnOn("no-trailing-spaces");
+  config.TurnOn("duplicate-design-element");
+  const ScopedTestFile top(testing::TempDir(),
+                           "module top; \n  sub u_sub();\nendmodule\n");
+  const ScopedTestFile sub(testing::TempDir(), "module sub; \nendmodule\n");
+  const std::string top_filename(top.filename());
+  const std::string sub_filename(sub.filename());
+  const std::vector<std::string> filenames{top_filename, sub_filename,
+                                           top_filename};
+  const std::vector<LinterConfiguration> configs(filenames.size(), config);
+
+  for (int num_threads : {1, 2, 3}) {
+    std::ostringstream stream;
+    verible::TextLintDiagnosticSink sink(&stream);
+    EXPECT_EQ(LintProject(&stream, &sink, filenames, configs, false, true,
+                          num_threads),
+              1);
+    const std::string output(stream.str());
+    // Per-file violations come first, in the order of the files given.
+    const auto first_top = output.find(top_filename + ":1:12:");
+    const auto first_sub = output.find(sub_filename + ":1:12:");
+    const auto second_top = output.find(top_filename + ":1:12:", first_sub);
+    EXPECT_LT(first_top, first_sub) << output;
+    EXPECT_NE(second_top, std::string::npos) << output;
+    // The cross-file findings follow.
+    const auto duplicate = output.find("[duplicate-design-element]");
+    EXPECT_LT(second_top, duplicate) << output;
+    EXPECT_EQ(output.find("[undefined-module-instance]"), std::string::npos)
+        << output;
+  }
+}
+
+// Tests that project rules can be turned off by the configuration, and that
+// waiver comments apply to their findings.
+TEST(LintProjectTest, DisabledAndWaivedProjectRules) {
+  const ScopedTestFile packages(
+      testing::TempDir(),
+      "package p;  // verilog_lint: waive unused-package\n"
+      "endpackage\n"
+      "package q;\n"
+      "endpackage\n");
+  const ScopedTestFile top(testing::TempDir(),
+                           "module top;\n  missing u_missing();\nendmodule\n");
+  const std::vector<std::string> filenames{std::string(packages.filename()),
+                                           std::string(top.filename())};
+  LinterConfiguration config;
+  config.UseRuleSet(RuleSet::kNone);
+  config.TurnOn("unused-package");
+  const std::vector<LinterConfiguration> configs(filenames.size(), config);
+
+  std::ostringstream stream;
+  verible::TextLintDiagnosticSink sink(&stream);
+  EXPECT_EQ(LintProject(&stream, &sink, filenames, configs, false, true, 1), 1);
+  const std::string output(stream.str());
+  EXPECT_EQ(output.find("[undefined-module-instance]"), std::string::npos)
+      << output;
+  EXPECT_EQ(output.find(filenames[0] + ":1:"), std::string::npos) << output;
+  EXPECT_THAT(output, HasSubstr(filenames[0] + ":3:9: Package \"q\""));
+}
+
+TEST(LintProjectTest, MissingFile) {
+  LinterConfiguration config;
+  std::ostringstream stream;
+  verible::TextLintDiagnosticSink sink(&stream);
+  EXPECT_EQ(LintProject(&stream, &sink, {"/does/not/exist.sv"}, {config},
+                        false, false, 0),
+            2);
+}
+
+}  // namespace
+}  // namespace verilog
@@ -16,12 +16,17 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <streambuf>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "common/formatting/format_token.h"
+#include "common/formatting/formatted_excerpt_cache.h"
 #include "common/formatting/line_wrap_searcher.h"
 #include "common/formatting/token_partition_tree.h"
 #include "common/formatting/unwrapped_line.h"
@@ -30,15 +35,15 @@
 #include "common/text/text_structure.h"
 #include "common/text/token_info.h"
 #include "common/text/tree_utils.h"
-#include "common/util/expandable_tree_view.h"
+#include "common/util/expansion_bitset_view.h"
 #include "common/util/iterator_range.h"
 #include "common/util/logging.h"
 #include "common/util/range.h"
 #include "common/util/spacer.h"
-#include "common/util/vector_tree.h"
-#include "verilog/CST/declaration.h"
 #include "verilog/CST/module.h"
+#include "verilog/CST/verilog_nonterminals.h"
 #include "verilog/analysis/verilog_analyzer.h"
+#include "verilog/analysis/verilog_declaration_index.h"
 #include "verilog/analysis/verilog_equivalence.h"
 #include "verilog/formatting/align.h"
 #include "verilog/formatting/comment_controls.h"
@@ -53,14 +58,11 @@ using absl::Status;
 using absl::StatusCode;
 
 using verible::ByteOffsetSet;
-using verible::ExpandableTreeView;
+using verible::ExpansionBitsetView;
+using verible::FormattedExcerptCache;
 using verible::PartitionPolicyEnum;
 using verible::TokenPartitionTree;
-using verible::TreeViewNodeInfo;
 using verible::UnwrappedLine;
-using verible::VectorTree;
-
-typedef VectorTree<TreeViewNodeInfo<UnwrappedLine>> partition_node_type;
 
 // Takes a TextStructureView and FormatStyle, and formats UnwrappedLines.
 class Formatter {
@@ -79,6 +81,9 @@ class Formatter {
   // Outputs all of the FormattedExcerpt lines to stream.
   void Emit(std::ostream& stream) const;
 
+  // Appends all of the FormattedExcerpt lines to 'text'.
+  void Emit(std::string* text) const;
+
  private:
   // Contains structural information about the code to format, such as
   // TokenSequence from lexing, and ConcreteSyntaxTree from parsing
@@ -149,6 +154,18 @@ Status FormatVerilog(absl::string_view text, absl::string_view filename,
                      const FormatStyle& style, std::ostream& formatted_stream,
                      const LineNumberSet& lines,
                      const ExecutionControl& control) {
+  std::string formatted_text;
+  const Status status =
+      FormatVerilog(text, filename, style, &formatted_text, lines, control);
+  formatted_stream << formatted_text;
+  return status;
+}
+
+Status FormatVerilog(absl::string_view text, absl::string_view filename,
+                     const FormatStyle& style, std::string* formatted_text,
+                     const LineNumberSet& lines,
+                     const ExecutionControl& control) {
+  formatted_text->clear();
   const auto analyzer = VerilogAnalyzer::AnalyzeAutomaticMode(text, filename);
   {
     // Lex and parse code.  Exit on failure.
@@ -186,17 +203,14 @@ Status FormatVerilog(absl::string_view text, absl::string_view filename,
     return absl::CancelledError("Halting for diagnostic operation.");
   }
 
-  // Render formatted text to a temporary buffer, so that it can be verified.
-  std::ostringstream output_buffer;
-  fmt.Emit(output_buffer);
-  const std::string& formatted_text(output_buffer.str());
-
-  // Commit verified formatted text to the output stream.
-  formatted_stream << formatted_text;
+  // Render formatted text, so that it can be verified.
+  // Formatting mostly changes whitespace, so expect a similar size.
+  formatted_text->reserve(text.length());
+  fmt.Emit(formatted_text);
 
   // For now, unconditionally verify.
   const Status verify_status =
-      VerifyFormatting(text_structure, formatted_text, filename);
+      VerifyFormatting(text_structure, *formatted_text, filename);
   if (!verify_status.ok()) {
     return verify_status;
   }
@@ -204,35 +218,30 @@ Status FormatVerilog(absl::string_view text, absl::string_view filename,
   return format_status;
 }
 
-// Decided at each node in UnwrappedLine partition tree whether or not
+// Decides at each node in UnwrappedLine partition tree whether or not
 // it should be expanded or unexpanded.
-static void DeterminePartitionExpansion(partition_node_type* node,
-                                        const FormatStyle& style) {
-  auto& node_view = node->Value();
-  const auto& children = node->Children();
+//   any_child_expanded: true if any child of node is expanded.
+static bool ShouldExpandPartition(const TokenPartitionTree& node,
+                                  bool any_child_expanded,
+                                  const FormatStyle& style) {
+  const auto& children = node.Children();
 
   // If this is a leaf partition, there is nothing to expand.
   if (children.empty()) {
     VLOG(3) << "No children to expand.";
-    node_view.Unexpand();
-    return;
+    return false;
   }
 
   // If any children are expanded, then this node must be expanded,
   // regardless of the UnwrappedLine's chosen policy.
   // Thus, this function must be executed with a post-order traversal.
-  const auto iter = std::find_if(children.begin(), children.end(),
-                                 [](const partition_node_type& child) {
-                                   return child.Value().IsExpanded();
-                                 });
-  if (iter != children.end()) {
+  if (any_child_expanded) {
     VLOG(3) << "Child forces parent to expand.";
-    node_view.Expand();
-    return;
+    return true;
   }
 
   // Expand or not, depending on partition policy and other conditions.
-  const auto& uwline = node_view.Value();
+  const auto& uwline = node.Value();
   const auto partition_policy = uwline.PartitionPolicy();
   VLOG(3) << "partition policy: " << partition_policy;
   switch (partition_policy) {
@@ -244,7 +253,7 @@ static void DeterminePartitionExpansion(partition_node_type* node,
     case PartitionPolicyEnum::kTabularAlignment:
     case PartitionPolicyEnum::kAlwaysExpand: {
       if (children.size() > 1) {
-        node_view.Expand();
+        return true;
       }
       break;
     }
@@ -254,35 +263,41 @@ static void DeterminePartitionExpansion(partition_node_type* node,
     case PartitionPolicyEnum::kFitOnLineElseExpand: {
       if (verible::FitsOnLine(uwline, style).fits) {
         VLOG(3) << "Fits, un-expanding.";
-        node_view.Unexpand();
+        return false;
       } else {
         VLOG(3) << "Does not fit, expanding.";
-        node_view.Expand();
+        return true;
       }
     }
   }
+  // Otherwise, keep the initial, fully-expanded view.
+  return true;
 }
 
 // Produce a worklist of independently formattable UnwrappedLines.
-static std::vector<UnwrappedLine> MakeUnwrappedLinesWorklist(
+// The worklist refers to partitions in format_tokens_partitions, which must
+// outlive it.
+static std::vector<const UnwrappedLine*> MakeUnwrappedLinesWorklist(
     const TokenPartitionTree& format_tokens_partitions,
     const FormatStyle& style) {
   // Initialize a tree view that treats partitions as fully-expanded.
-  ExpandableTreeView<UnwrappedLine> format_tokens_partition_view(
+  ExpansionBitsetView<UnwrappedLine> format_tokens_partition_view(
       format_tokens_partitions);
 
   // For unwrapped lines that fit, don't bother expanding their partitions.
   // Post-order traversal: if a child doesn't 'fit' and needs to be expanded,
   // so must all of its parents (and transitively, ancestors).
-  format_tokens_partition_view.ApplyPostOrder(
-      [&style](partition_node_type& node) {
-        DeterminePartitionExpansion(&node, style);
+  format_tokens_partition_view.DecideExpansionsPostOrder(
+      [&style](const TokenPartitionTree& node, bool any_child_expanded) {
+        return ShouldExpandPartition(node, any_child_expanded, style);
       });
 
+  std::vector<const UnwrappedLine*> unwrapped_lines;
+  for (const auto* node : format_tokens_partition_view.VisibleNodes()) {
+    unwrapped_lines.push_back(&node->Value());
+  }
   // Remove trailing blank lines.
-  std::vector<UnwrappedLine> unwrapped_lines(
-      format_tokens_partition_view.begin(), format_tokens_partition_view.end());
-  while (!unwrapped_lines.empty() && unwrapped_lines.back().IsEmpty()) {
+  while (!unwrapped_lines.empty() && unwrapped_lines.back()->IsEmpty()) {
     unwrapped_lines.pop_back();
   }
   return unwrapped_lines;
@@ -388,15 +403,15 @@ static verible::Interval<int> DisableByteOffsetRange(
   return {range.first + 1, range.second};
 }
 
-// Given control flags and syntax tree, selectively disable some ranges
+// Given control flags and declarations, selectively disable some ranges
 // of text from formatting.
 static void DisableSyntaxBasedRanges(ByteOffsetSet* disabled_ranges,
-                                     const verible::Symbol& root,
+                                     const VerilogDeclarationIndex& index,
                                      const FormatStyle& style,
                                      absl::string_view full_text) {
   // Module-related sections:
-  for (const auto& match : FindAllModuleDeclarations(root)) {
-    if (!style.format_module_port_declarations) {
+  if (!style.format_module_port_declarations) {
+    for (const auto& match : index.ModuleDeclarations()) {
       const auto* ports = GetModulePortDeclarationList(*match.match);
       if (ports != nullptr) {
         const auto ports_text = verible::StringSpanOfSymbol(*ports);
@@ -404,17 +419,15 @@ static void DisableSyntaxBasedRanges(ByteOffsetSet* disabled_ranges,
         disabled_ranges->Add(DisableByteOffsetRange(ports_text, full_text));
       }
     }
-    if (!style.format_module_instantiations) {
-      const auto& instantiations = FindAllDataDeclarations(*match.match);
-      for (const auto& inst : instantiations) {
-        const auto& module_instances = FindAllGateInstances(*inst.match);
-        // Only suppress formatting if instances contains a module or
-        // gate-like instance with ports in parentheses.
-        if (module_instances.empty()) continue;
-        const auto inst_text = verible::StringSpanOfSymbol(*inst.match);
-        VLOG(4) << "disabled: " << inst_text;
-        disabled_ranges->Add(DisableByteOffsetRange(inst_text, full_text));
-      }
+  }
+  if (!style.format_module_instantiations) {
+    // Only suppress formatting if instances contains a module or
+    // gate-like instance with ports in parentheses.
+    for (const auto& inst : index.Instantiations()) {
+      if (!inst.context.IsInside(NodeEnum::kModuleDeclaration)) continue;
+      const auto inst_text = verible::StringSpanOfSymbol(*inst.match);
+      VLOG(4) << "disabled: " << inst_text;
+      disabled_ranges->Add(DisableByteOffsetRange(inst_text, full_text));
     }
   }
 }
@@ -435,11 +448,12 @@ Status Formatter::Format(const ExecutionControl& control) {
   // full-partitioning does not depend on format annotations.
   {
     // Annotate inter-token information between all adjacent PreFormatTokens.
-    // This must be done before any decisions about ExpandableTreeView
+    // This must be done before any decisions about ExpansionBitsetView
     // can be made because they depend on minimum-spacing, and must-break.
     AnnotateFormattingInformation(style_, text_structure_,
                                   unwrapper_data.preformatted_tokens.begin(),
-                                  unwrapper_data.preformatted_tokens.end());
+                                  unwrapper_data.preformatted_tokens.end(),
+                                  control.num_threads);
 
     // Determine ranges of disabling the formatter, based on comment controls.
     disabled_ranges_.Union(DisableFormattingRanges(full_text, token_stream));
@@ -447,8 +461,10 @@ Status Formatter::Format(const ExecutionControl& control) {
     // Find disabled formatting ranges for specific syntax tree node types.
     // These are typically temporary workarounds for sections that users
     // habitually prefer to format themselves.
-    if (const auto& root = text_structure_.SyntaxTree()) {
-      DisableSyntaxBasedRanges(&disabled_ranges_, *root, style_, full_text);
+    if (text_structure_.SyntaxTree() != nullptr) {
+      DisableSyntaxBasedRanges(&disabled_ranges_,
+                               VerilogDeclarationIndex::Get(text_structure_),
+                               style_, full_text);
     }
 
     // Disable formatting ranges.
@@ -512,11 +528,32 @@ Status Formatter::Format(const ExecutionControl& control) {
   // to their own 'slots'.
   std::vector<const UnwrappedLine*> partially_formatted_lines;
   formatted_lines_.reserve(unwrapped_lines.size());
-  for (const auto& uwline : unwrapped_lines) {
+  verible::LineWrapSearchOptions search_options;
+  search_options.max_search_states = control.max_search_states;
+  search_options.beam_width = control.beam_width;
+  search_options.max_search_time = control.max_search_time;
+  for (const auto* uwline_ptr : unwrapped_lines) {
+    const UnwrappedLine& uwline = *uwline_ptr;
+    // Reuse the formatting of partitions that are unchanged since they were
+    // last formatted.
+    uint64_t cache_key = 0;
+    if (control.excerpt_cache != nullptr) {
+      cache_key = FormattedExcerptCache::Fingerprint(uwline, style_);
+      verible::FormattedExcerpt cached;
+      if (control.excerpt_cache->Lookup(cache_key, uwline, &cached)) {
+        formatted_lines_.push_back(std::move(cached));
+        continue;
+      }
+    }
     // TODO(fangism): Use different formatting strategies depending on
     // uwline.PartitionPolicy().
+    verible::LineWrapSearchStats search_stats;
     const auto optimal_solutions =
-        verible::SearchLineWraps(uwline, style_, control.max_search_states);
+        verible::SearchLineWraps(uwline, style_, search_options, &search_stats);
+    if (control.show_search_statistics) {
+      control.Stream() << "Line wrap search (" << search_stats
+                       << ") on partition: " << uwline << std::endl;
+    }
     if (control.show_equally_optimal_wrappings &&
         optimal_solutions.size() > 1) {
       verible::DisplayEquallyOptimalWrappings(control.Stream(), uwline,
@@ -524,9 +561,13 @@ Status Formatter::Format(const ExecutionControl& control) {
     }
     // Arbitrarily choose the first solution, if there are multiple.
     formatted_lines_.push_back(optimal_solutions.front());
-    if (!formatted_lines_.back().CompletedFormatting()) {
+    if (control.excerpt_cache != nullptr &&
+        formatted_lines_.back().CompletedFormatting()) {
+      control.excerpt_cache->Insert(cache_key, formatted_lines_.back());
+    }
+    if (search_stats.finished_greedily) {
       // Copy over any lines that did not finish wrap searching.
-      partially_formatted_lines.push_back(&uwline);
+      partially_formatted_lines.push_back(uwline_ptr);
     }
   }
 
@@ -547,6 +588,37 @@ Status Formatter::Format(const ExecutionControl& control) {
   return absl::OkStatus();
 }
 
+namespace {
+// Stream buffer that appends to a string, which saves the copy that
+// std::ostringstream::str() would make.
+class StringAppendBuffer : public std::streambuf {
+ public:
+  explicit StringAppendBuffer(std::string* text) : text_(text) {}
+
+ protected:
+  int_type overflow(int_type c) override {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      text_->push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override {
+    text_->append(s, n);
+    return n;
+  }
+
+ private:
+  std::string* text_;
+};
+}  // namespace
+
+void Formatter::Emit(std::string* text) const {
+  StringAppendBuffer buffer(text);
+  std::ostream stream(&buffer);
+  Emit(stream);
+}
+
 void Formatter::Emit(std::ostream& stream) const {
   const absl::string_view full_text(text_structure_.Contents());
   int position = 0;  // tracks with the position in the original full_text
@@ -16,9 +16,12 @@
 #define VERIBLE_VERILOG_FORMATTING_FORMATTER_H_
 
 #include <iosfwd>
+#include <string>
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "common/formatting/formatted_excerpt_cache.h"
 #include "verilog/formatting/comment_controls.h"
 #include "verilog/formatting/format_style.h"
 
@@ -43,10 +46,33 @@ struct ExecutionControl {
   // formattings on any token partition, but continue to operate.
   bool show_equally_optimal_wrappings = false;
 
+  // If true, print (stderr) the effort spent searching line wraps of each
+  // token partition, but continue to operate.
+  bool show_search_statistics = false;
+
   // Limit the size of search space for wrapping lines.
-  // If this limit is exceeded, error out with a diagnostic message.
+  // If this limit is exceeded, and beam_width is not positive,
+  // error out with a diagnostic message.
   int max_search_states = 10000;
 
+  // If positive, partitions that exceed max_search_states are formatted by a
+  // beam search of this width, which usually finds near-optimal results.
+  int beam_width = 0;
+
+  // Limit the time spent searching line wraps of each partition.
+  // If this limit is exceeded, error out with a diagnostic message.
+  absl::Duration max_search_time = absl::InfiniteDuration();
+
+  // Number of threads for annotating the top-level items of a file
+  // concurrently (see verible::ResolveNumThreads()).
+  // The result does not depend on this.
+  int num_threads = 1;
+
+  // If not null, partitions whose formatting is found in this cache skip
+  // line wrap searching, and newly searched partitions are added to it.
+  // This makes re-formatting mostly unchanged text cheaper.
+  verible::FormattedExcerptCache* excerpt_cache = nullptr;
+
   // Output stream for diagnostic feedback (not formatting output).
   // This is useful for seeing diagnostics without waiting for a Status
   // to be returned.
@@ -69,6 +95,16 @@ absl::Status FormatVerilog(absl::string_view text, absl::string_view filename,
                            const LineNumberSet& lines = {},
                            const ExecutionControl& control = {});
 
+// Same as above, but renders formatted text directly into 'formatted_text'
+// (replacing its contents), without intermediate copies.  This is preferred
+// for large inputs.  When verification fails, 'formatted_text' still holds
+// the problematic output, for diagnostics.
+absl::Status FormatVerilog(absl::string_view text, absl::string_view filename,
+                           const FormatStyle& style,
+                           std::string* formatted_text,
+                           const LineNumberSet& lines = {},
+                           const ExecutionControl& control = {});
+
 }  // namespace formatter
 }  // namespace verilog
 
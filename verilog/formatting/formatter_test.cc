@@ -31,6 +31,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
+#include "common/formatting/formatted_excerpt_cache.h"
 #include "common/text/text_structure.h"
 #include "common/util/logging.h"
 #include "verilog/analysis/verilog_analyzer.h"
@@ -5126,6 +5127,42 @@ TEST(FormatterEndToEndTest, VerilogFormatTest) {
   }
 }
 
+// Tests that annotating top-level items concurrently does not change
+// results.
+TEST(FormatterEndToEndTest, VerilogFormatMultiThreadedTest) {
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+  ExecutionControl control;
+  control.num_threads = 4;
+  for (const auto& test_case : kFormatterTestCases) {
+    std::ostringstream stream;
+    const auto status = FormatVerilog(test_case.input, "<filename>", style,
+                                      stream, kEnableAllLines, control);
+    EXPECT_OK(status) << status.message();
+    EXPECT_EQ(stream.str(), test_case.expected) << "code:\n" << test_case.input;
+  }
+}
+
+// Tests that formatting into a string gives the same results as formatting
+// into a stream.
+TEST(FormatterEndToEndTest, VerilogFormatToStringTest) {
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+  for (const auto& test_case : kFormatterTestCases) {
+    std::string formatted_text("stale contents");
+    const auto status =
+        FormatVerilog(test_case.input, "<filename>", style, &formatted_text);
+    EXPECT_OK(status) << status.message();
+    EXPECT_EQ(formatted_text, test_case.expected)
+        << "code:\n"
+        << test_case.input;
+  }
+}
+
 TEST(FormatterEndToEndTest, DisableModulePortDeclarations) {
   const std::initializer_list<FormatterTestCase> kTestCases = {
       {"", ""},
@@ -5759,6 +5796,90 @@ TEST(FormatterEndToEndTest, UnfinishedLineWrapSearching) {
   EXPECT_TRUE(absl::StartsWith(status.message(), "***"));
 }
 
+// Test that a beam search takes over when the search space limit is hit.
+TEST(FormatterEndToEndTest, BeamSearchAfterSearchLimit) {
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+
+  const absl::string_view code("parameter int x = 1+1;\n");
+
+  std::ostringstream stream, debug_stream;
+  ExecutionControl control;
+  control.max_search_states = 2;  // Cause search to abort early.
+  control.beam_width = 8;
+  control.show_search_statistics = true;
+  control.stream = &debug_stream;
+  const auto status = FormatVerilog(code, "<filename>", style, stream,
+                                    kEnableAllLines, control);
+  EXPECT_OK(status) << status.message();
+  EXPECT_EQ(stream.str(), "parameter int x = 1 + 1;\n");
+  EXPECT_TRUE(absl::StrContains(debug_stream.str(), "used beam search"))
+      << "got: " << debug_stream.str();
+}
+
+// Tests that formatting with a shared cache of partitions gives the same
+// results, whether or not the cache already knows the partitions.
+TEST(FormatterEndToEndTest, ExcerptCacheSameResults) {
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+  verible::FormattedExcerptCache cache;
+  ExecutionControl control;
+  control.excerpt_cache = &cache;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const auto& test_case : kFormatterTestCases) {
+      std::ostringstream stream;
+      const auto status = FormatVerilog(test_case.input, "<filename>", style,
+                                        stream, kEnableAllLines, control);
+      EXPECT_OK(status) << status.message();
+      EXPECT_EQ(stream.str(), test_case.expected)
+          << "pass " << pass << ", code:\n"
+          << test_case.input;
+    }
+  }
+  EXPECT_GT(cache.Size(), 0);
+}
+
+// Test that cached partitions are not searched again.
+TEST(FormatterEndToEndTest, ExcerptCacheSkipsSearch) {
+  FormatStyle style;
+  style.column_limit = 40;
+  style.indentation_spaces = 2;
+  style.wrap_spaces = 4;
+
+  const absl::string_view code("parameter int x = 1+1;\n");
+  verible::FormattedExcerptCache cache;
+  ExecutionControl control;
+  control.excerpt_cache = &cache;
+  {
+    std::ostringstream stream;
+    const auto status = FormatVerilog(code, "<filename>", style, stream,
+                                      kEnableAllLines, control);
+    EXPECT_OK(status) << status.message();
+  }
+  control.max_search_states = 2;  // Cause any search to abort early.
+  {
+    std::ostringstream stream;
+    const auto status = FormatVerilog(code, "<filename>", style, stream,
+                                      kEnableAllLines, control);
+    EXPECT_OK(status) << status.message();
+    EXPECT_EQ(stream.str(), "parameter int x = 1 + 1;\n");
+  }
+  {
+    // The added partition still needs to be searched.
+    const absl::string_view edited_code(
+        "parameter int x = 1+1;\n"
+        "parameter int y = 2+2;\n");
+    std::ostringstream stream;
+    const auto status = FormatVerilog(edited_code, "<filename>", style,
+                                      stream, kEnableAllLines, control);
+    EXPECT_EQ(status.code(), StatusCode::kResourceExhausted);
+  }
+}
+
 // TODO(fangism): directed tests using style variations
 
 }  // namespace
@@ -14,7 +14,14 @@
 
 #include "verilog/formatting/token_annotator.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
 #include <iterator>
+#include <map>
+#include <set>
+#include <tuple>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -47,20 +54,41 @@ using FTT = FormatTokenType;
 // This value must be negative.
 static constexpr int kUnhandledSpacesRequired = -1;
 
-static bool IsUnaryPrefixExpressionOperand(const PreFormatToken& left,
-                                           const SyntaxTreeContext& context) {
-  return (IsUnaryOperator(verilog_tokentype(left.TokenEnum())) &&
-          context.IsInsideFirst({NodeEnum::kUnaryPrefixExpression},
-                                {NodeEnum::kExpression})) ||
-         // Treat '##' like a unary prefix operator.
-         left.TokenEnum() == verilog_tokentype::TK_POUNDPOUND;
+// The rules below are templates over the style, token and context types, so
+// that they can also be evaluated on ProbeStyle, ProbeToken and ProbeContext,
+// to find the token pairs whose annotations depend on nothing else than their
+// token enums and a few context facts (see TokenPairTable).
+// Where the order does not matter, rules check tokens before contexts, so
+// that fewer pairs depend on their context.
+
+// Context facts that most pairs of tokens check, so TokenPairTable is keyed
+// on them.
+enum ContextFacts {
+  kInsideDimensions = 1 << 0,
+  kInsideUdpEntry = 1 << 1,
+  kNumContextFactCombinations = 1 << 2,
+};
+
+// Returns true if the context is inside [dimensions].
+static bool IsInsideDimensions(const SyntaxTreeContext& context) {
+  return context.IsInsideFirst(
+      {NodeEnum::kDimensionRange, NodeEnum::kDimensionScalar}, {});
 }
 
-static bool IsInsideNumericLiteral(const PreFormatToken& left,
-                                   const PreFormatToken& right) {
-  return (left.format_token_enum == FormatTokenType::numeric_literal &&
-          right.format_token_enum == FormatTokenType::numeric_base) ||
-         left.format_token_enum == FormatTokenType::numeric_base;
+// Returns true if the context is inside a UDP table entry.
+static bool IsInsideUdpEntry(const SyntaxTreeContext& context) {
+  return context.IsInsideFirst(
+      {NodeEnum::kUdpCombEntry, NodeEnum::kUdpSequenceEntry}, {});
+}
+
+static bool HasEmptyText(const PreFormatToken& ftoken) {
+  return ftoken.token->text.empty();
+}
+
+// Returns the token type, for its classifications.  Compare tokens with
+// TokenEnum() instead, so that TokenPairTable can tell which enums are named.
+static verilog_tokentype TokenType(const PreFormatToken& ftoken) {
+  return verilog_tokentype(ftoken.TokenEnum());
 }
 
 // Returns true if keyword can be used like a function/method call.
@@ -96,25 +124,226 @@ static bool IsKeywordCallable(verilog_tokentype e) {
   return false;
 }
 
+namespace {
+// Stands in for a SyntaxTreeContext of which at most its ContextFacts are
+// known.  Any other query marks the result as context-dependent.
+class ProbeContext {
+ public:
+  // Nothing is known about this context.
+  explicit ProbeContext(bool* dependent)
+      : known_facts_(false), facts_(0), dependent_(dependent) {}
+
+  // Only 'facts' (a combination of ContextFacts) are known.
+  ProbeContext(int facts, bool* dependent)
+      : known_facts_(true), facts_(facts), dependent_(dependent) {}
+
+  bool HasFact(ContextFacts fact) const {
+    return known_facts_ ? (facts_ & fact) != 0 : Depend();
+  }
+
+  template <typename E>
+  bool IsInside(E) const {
+    return Depend();
+  }
+  template <typename E>
+  bool IsInsideFirst(std::initializer_list<E>, std::initializer_list<E>) const {
+    return Depend();
+  }
+  template <typename E>
+  bool DirectParentIs(E) const {
+    return Depend();
+  }
+  template <typename E>
+  bool DirectParentIsOneOf(std::initializer_list<E>) const {
+    return Depend();
+  }
+  template <typename E>
+  bool DirectParentsAre(std::initializer_list<E>) const {
+    return Depend();
+  }
+
+ private:
+  bool Depend() const {
+    *dependent_ = true;
+    return false;
+  }
+
+  bool known_facts_;
+  int facts_;
+  bool* dependent_;
+};
+
+// Stands in for the token enum of a ProbeToken.  Comparing it with a token
+// enum records that enum as named by the rules; any other use as an int marks
+// the result as token-dependent.
+class ProbeTokenEnum {
+ public:
+  ProbeTokenEnum(int token_enum, std::set<int>* named_enums, bool* dependent)
+      : token_enum_(token_enum),
+        named_enums_(named_enums),
+        dependent_(dependent) {}
+
+  friend bool operator==(const ProbeTokenEnum& left, int right) {
+    left.named_enums_->insert(right);
+    return left.token_enum_ == right;
+  }
+  friend bool operator!=(const ProbeTokenEnum& left, int right) {
+    return !(left == right);
+  }
+
+  operator int() const {  // NOLINT: implicit, like the int it stands for
+    *dependent_ = true;
+    return token_enum_;
+  }
+
+  // For logging only.
+  friend const char* verilog_symbol_name(const ProbeTokenEnum& e) {
+    return verilog::verilog_symbol_name(e.token_enum_);
+  }
+
+ private:
+  int token_enum_;
+  std::set<int>* named_enums_;
+  bool* dependent_;
+};
+
+// Stands in for the verilog_tokentype of a ProbeToken, which only supports
+// the classifications that TokenPairTable keys on.
+class ProbeTokenType {
+ public:
+  explicit ProbeTokenType(int token_enum)
+      : type_(verilog_tokentype(token_enum)) {}
+
+  friend bool IsUnaryOperator(ProbeTokenType e) {
+    return verilog::IsUnaryOperator(e.type_);
+  }
+  friend bool IsEndKeyword(ProbeTokenType e) {
+    return verilog::IsEndKeyword(e.type_);
+  }
+  friend bool IsPreprocessorKeyword(ProbeTokenType e) {
+    return verilog::IsPreprocessorKeyword(e.type_);
+  }
+  friend bool IsTernaryOperator(ProbeTokenType e) {
+    return verilog::IsTernaryOperator(e.type_);
+  }
+  friend bool IsKeywordCallable(ProbeTokenType e) {
+    return formatter::IsKeywordCallable(e.type_);
+  }
+
+ private:
+  verilog_tokentype type_;
+};
+
+// Stands in for a PreFormatToken (with non-empty text) of which only the
+// token enum and its format token type are known.
+// Accessing anything else marks the result as token-dependent.
+class ProbeToken {
+ public:
+  // Converts to int, marking the result as token-dependent.
+  class DependentInt {
+   public:
+    explicit DependentInt(bool* dependent) : dependent_(dependent) {}
+    operator int() const {  // NOLINT: implicit, like the int it stands for
+      *dependent_ = true;
+      return 0;
+    }
+
+   private:
+    bool* dependent_;
+  };
+
+  struct Annotation {
+    DependentInt spaces_required;
+  };
+
+  // Token enums that the rules compare this token against are inserted into
+  // 'named_enums'.
+  ProbeToken(int token_enum, int format_token_enum, std::set<int>* named_enums,
+             bool* dependent)
+      : format_token_enum(format_token_enum),
+        before{DependentInt(dependent)},
+        token_enum_(token_enum),
+        named_enums_(named_enums),
+        dependent_(dependent) {}
+
+  ProbeTokenEnum TokenEnum() const {
+    return ProbeTokenEnum(token_enum_, named_enums_, dependent_);
+  }
+
+  friend ProbeTokenType TokenType(const ProbeToken& ftoken) {
+    return ProbeTokenType(ftoken.token_enum_);
+  }
+
+  absl::string_view Text() const {
+    *dependent_ = true;
+    return absl::string_view();
+  }
+
+  absl::string_view OriginalLeadingSpaces() const { return Text(); }
+
+  int format_token_enum;
+  Annotation before;
+
+ private:
+  int token_enum_;
+  std::set<int>* named_enums_;
+  bool* dependent_;
+};
+
+// Stands in for the FormatStyle.  It has no options, so that rules that read
+// any do not compile for probes, as TokenPairTable is not keyed on them.
+struct ProbeStyle {};
+
+bool IsInsideDimensions(const ProbeContext& context) {
+  return context.HasFact(kInsideDimensions);
+}
+
+bool IsInsideUdpEntry(const ProbeContext& context) {
+  return context.HasFact(kInsideUdpEntry);
+}
+
+bool HasEmptyText(const ProbeToken&) { return false; }
+}  // namespace
+
+template <class Token, class Context>
+static bool IsUnaryPrefixExpressionOperand(const Token& left,
+                                           const Context& context) {
+  return (IsUnaryOperator(TokenType(left)) &&
+          context.IsInsideFirst({NodeEnum::kUnaryPrefixExpression},
+                                {NodeEnum::kExpression})) ||
+         // Treat '##' like a unary prefix operator.
+         left.TokenEnum() == verilog_tokentype::TK_POUNDPOUND;
+}
+
+template <class Token>
+static bool IsInsideNumericLiteral(const Token& left, const Token& right) {
+  return (left.format_token_enum == FormatTokenType::numeric_literal &&
+          right.format_token_enum == FormatTokenType::numeric_base) ||
+         left.format_token_enum == FormatTokenType::numeric_base;
+}
+
 // The following combinations cannot be merged without a space:
 //   number number : would result in one different number
 //   number id/kw : would result in a bad identifier (lexer)
 //   id/kw number : would result in a (different) identifier
 //   id/kw id/kw : would result in a (different) identifier
-static bool PairwiseNonmergeable(const PreFormatToken& ftoken) {
+template <class Token>
+static bool PairwiseNonmergeable(const Token& ftoken) {
   return ftoken.TokenEnum() == TK_DecNumber ||
          ftoken.format_token_enum == FormatTokenType::identifier ||
          ftoken.format_token_enum == FormatTokenType::keyword;
 }
 
-static bool InRangeLikeContext(const SyntaxTreeContext& context) {
+template <class Context>
+static bool InRangeLikeContext(const Context& context) {
   return context.IsInsideFirst(
       {NodeEnum::kSelectVariableDimension, NodeEnum::kDimensionRange,
        NodeEnum::kDimensionSlice},
       {});
 }
 
-static bool IsAnySemicolon(const PreFormatToken& ftoken) {
+template <class Token>
+static bool IsAnySemicolon(const Token& ftoken) {
   // These are just syntactically disambiguated versions of ';'.
   return ftoken.TokenEnum() == ';' ||
          ftoken.TokenEnum() ==
@@ -124,10 +353,11 @@ static bool IsAnySemicolon(const PreFormatToken& ftoken) {
 // Returns minimum number of spaces required between left and right token.
 // Returning kUnhandledSpacesRequired means the case was not explicitly
 // handled, and it is up to the caller to decide what to do when this happens.
-static WithReason<int> SpacesRequiredBetween(
-    const PreFormatToken& left, const PreFormatToken& right,
-    const SyntaxTreeContext& left_context,
-    const SyntaxTreeContext& right_context) {
+template <class Token, class Context>
+static WithReason<int> SpacesRequiredBetween(const Token& left,
+                                             const Token& right,
+                                             const Context& left_context,
+                                             const Context& right_context) {
   VLOG(3) << "Spacing between " << verilog_symbol_name(left.TokenEnum())
           << " and " << verilog_symbol_name(right.TokenEnum());
   // Higher precedence rules should be handled earlier in this function.
@@ -150,8 +380,7 @@ static WithReason<int> SpacesRequiredBetween(
   }
 
   // For now, leave everything inside [dimensions] alone.
-  if (right_context.IsInsideFirst(
-          {NodeEnum::kDimensionRange, NodeEnum::kDimensionScalar}, {})) {
+  if (IsInsideDimensions(right_context)) {
     // ... except for the spacing before '[' and around ':',
     // which are covered elsewhere.
     if (right.TokenEnum() != '[' && left.TokenEnum() != ':' &&
@@ -165,7 +394,7 @@ static WithReason<int> SpacesRequiredBetween(
   // Unary operators (context-sensitive)
   if (IsUnaryPrefixExpressionOperand(left, right_context) &&
       (left.format_token_enum != FormatTokenType::binary_operator ||
-       !IsUnaryOperator(static_cast<verilog_tokentype>(right.TokenEnum())))) {
+       !IsUnaryOperator(TokenType(right)))) {
     // TODO: There are _some_ unary operators on the right that could
     // be formatted with 0-space, for example:
     // 'a = & ~b'; could be 'a = &~b;'
@@ -190,12 +419,14 @@ static WithReason<int> SpacesRequiredBetween(
     return {1, "Require space after semicolon"};
   }
 
-  if (right_context.IsInsideFirst({NodeEnum::kStreamingConcatenation}, {})) {
-    if (left.TokenEnum() == TK_LS || left.TokenEnum() == TK_RS) {
+  if (left.TokenEnum() == TK_LS || left.TokenEnum() == TK_RS) {
+    if (right_context.IsInsideFirst({NodeEnum::kStreamingConcatenation}, {})) {
       return {0, "No space around streaming operators"};
-    } else if (left.format_token_enum == FormatTokenType::numeric_literal ||
-               left.format_token_enum == FormatTokenType::identifier ||
-               left.format_token_enum == FormatTokenType::keyword) {
+    }
+  } else if (left.format_token_enum == FormatTokenType::numeric_literal ||
+             left.format_token_enum == FormatTokenType::identifier ||
+             left.format_token_enum == FormatTokenType::keyword) {
+    if (right_context.IsInsideFirst({NodeEnum::kStreamingConcatenation}, {})) {
       return {0, "No space around streaming operator slice size"};
     }
   }
@@ -210,9 +441,8 @@ static WithReason<int> SpacesRequiredBetween(
   }
 
   // Do not force space between '^' and '{' operators
-  if (right_context.IsInsideFirst({NodeEnum::kUnaryPrefixExpression}, {})) {
-    if (IsUnaryOperator(static_cast<verilog_tokentype>(left.TokenEnum())) &&
-        right.TokenEnum() == '{') {
+  if (IsUnaryOperator(TokenType(left)) && right.TokenEnum() == '{') {
+    if (right_context.IsInsideFirst({NodeEnum::kUnaryPrefixExpression}, {})) {
       return {0, "No space between unary and concatenation operators"};
     }
   }
@@ -228,7 +458,7 @@ static WithReason<int> SpacesRequiredBetween(
   // If the token on either side is an empty string, do not inject any
   // additional spaces.  This can occur with some lexical tokens like
   // verilog_tokentype::PP_define_body.
-  if (left.token->text.empty() || right.token->text.empty()) {
+  if (HasEmptyText(left) || HasEmptyText(right)) {
     return {0, "No additional space around empty-string tokens."};
   }
 
@@ -238,8 +468,7 @@ static WithReason<int> SpacesRequiredBetween(
     return {0, "No space inside based numeric literals"};
   }
 
-  if (right_context.IsInsideFirst(
-          {NodeEnum::kUdpCombEntry, NodeEnum::kUdpSequenceEntry}, {})) {
+  if (IsInsideUdpEntry(right_context)) {
     // Spacing before ';' is handled above
     return {1, "One space around UDP entries"};
   }
@@ -271,7 +500,7 @@ static WithReason<int> SpacesRequiredBetween(
 
     // General handling of ID '(' spacing:
     if (left.format_token_enum == FormatTokenType::identifier ||
-        IsKeywordCallable(verilog_tokentype(left.TokenEnum()))) {
+        IsKeywordCallable(TokenType(left))) {
       if (right_context.IsInside(NodeEnum::kActualNamedPort) ||
           right_context.IsInside(NodeEnum::kPort)) {
         return {0, "Named port: no space between ID and '('"};
@@ -354,7 +583,7 @@ static WithReason<int> SpacesRequiredBetween(
 
     // Everything that resembles an end-label should have 1 space
     //   example nodes: kLabel, kEndNew, kFunctionEndLabel
-    if (IsEndKeyword(verilog_tokentype(left.TokenEnum()))) {
+    if (IsEndKeyword(TokenType(left))) {
       return {1, "Want 1 space between end-keyword and ':'"};
     }
 
@@ -458,11 +687,8 @@ static WithReason<int> SpacesRequiredBetween(
   // e.g. always_ff @(posedge clk) begin ...
   // e.g. case (expr): ...
   if (left.TokenEnum() == ')') {
-    switch (right.TokenEnum()) {
-      case ':':
-        return {0, "No space between ')' and ':'."};
-      default:
-        break;
+    if (right.TokenEnum() == ':') {
+      return {0, "No space between ')' and ':'."};
     }
     return {1, "Space between ')' and most other tokens"};
   }
@@ -477,8 +703,7 @@ static WithReason<int> SpacesRequiredBetween(
     return {1, "Space between ']' and most other tokens"};
   }
 
-  if (IsPreprocessorKeyword(
-          static_cast<verilog_tokentype>(right.TokenEnum()))) {
+  if (IsPreprocessorKeyword(TokenType(right))) {
     // most of these should start on their own line anyway
     return {1, "Preprocessor keywords should be separated from token on left."};
   }
@@ -499,10 +724,11 @@ struct SpacePolicy {
   bool force_preserve_spaces;
 };
 
-static SpacePolicy SpacesRequiredBetween(
-    const FormatStyle& style, const PreFormatToken& left,
-    const PreFormatToken& right, const SyntaxTreeContext& left_context,
-    const SyntaxTreeContext& right_context) {
+template <class Style, class Token, class Context>
+static SpacePolicy SpacesRequiredBetween(const Style& style, const Token& left,
+                                         const Token& right,
+                                         const Context& left_context,
+                                         const Context& right_context) {
   // Default for unhandled cases, 1 space to be conservative.
   constexpr int kUnhandledSpacesDefault = 1;
   const auto spaces =
@@ -521,8 +747,9 @@ static SpacePolicy SpacesRequiredBetween(
 }
 
 // Context-independent break penalty factor.
-static WithReason<int> BreakPenaltyBetweenTokens(
-    const verible::PreFormatToken& left, const verible::PreFormatToken& right) {
+template <class Token>
+static WithReason<int> BreakPenaltyBetweenTokens(const Token& left,
+                                                 const Token& right) {
   // Higher precedence rules should be handled earlier in this function.
   if (left.format_token_enum == FormatTokenType::identifier &&
       right.format_token_enum == FormatTokenType::open_group) {
@@ -562,11 +789,12 @@ static WithReason<int> BreakPenaltyBetweenTokens(
   return {0, "no further adjustment (default)"};
 }
 
-static int CommonAncestors(const SyntaxTreeContext& left,
-                           const SyntaxTreeContext& right) {
-  // TODO(fangism): re-check of common ancestry is slow (linear-time),
-  // and could be avoided by memoizing the point of common ancestry between
-  // leaves *during* the traversal.
+// Returns the number of ancestors that 'left' and 'right' have in common.
+// This is linear in the depth of the contexts, so it is only used when the
+// caller doesn't already know the answer; AnnotateFormattingInformation
+// tracks it during the syntax tree traversal.
+static size_t CommonAncestors(const SyntaxTreeContext& left,
+                              const SyntaxTreeContext& right) {
   const auto* shorter = &left;
   const auto* longer = &right;
   // For C++11 compatibility, we use the 3-iterator form of std::mismatch().
@@ -583,60 +811,58 @@ static int CommonAncestors(const SyntaxTreeContext& left,
 }
 
 // Token-independent break penalty factor.
-static int ContextBasedPenalty(const SyntaxTreeContext& left_context,
-                               const SyntaxTreeContext& right_context) {
+//   num_common: number of ancestors shared by the left and right tokens'
+//     syntax tree contexts, i.e. the depth of their lowest common ancestor.
+static int ContextBasedPenalty(size_t num_common) {
   // This factor takes into account syntax tree depth, favoring keeping
   // elements deeper in the tree closer together.
   // The current simple model gives equal weight to every element in the
   // context stack.
   // TODO(fangism): custom weights by syntax tree node type.
   constexpr int kDepthScaleFactor = 2;
-  const int num_common = CommonAncestors(left_context, right_context);
   const int penalty = num_common * kDepthScaleFactor;
   return penalty;
 }
 
+// Token conditions are checked before context conditions, so that only
+// pairs of operators depend on their context.
+template <class Token, class Context>
 static WithReason<int> TokensWithContextBreakPenalty(
-    const verible::PreFormatToken& left, const verible::PreFormatToken& right,
-    const SyntaxTreeContext& left_context,
-    const SyntaxTreeContext& right_context) {
-  const verilog_tokentype left_type =
-      static_cast<verilog_tokentype>(left.TokenEnum());
-  const verilog_tokentype right_type =
-      static_cast<verilog_tokentype>(right.TokenEnum());
-  if (right_context.DirectParentIs(NodeEnum::kTernaryExpression) &&
-      IsTernaryOperator(right_type)) {
+    const Token& left, const Token& right, const Context& left_context,
+    const Context& right_context) {
+  const auto left_type = TokenType(left);
+  const auto right_type = TokenType(right);
+  if (IsTernaryOperator(right_type) &&
+      right_context.DirectParentIs(NodeEnum::kTernaryExpression)) {
     return {3, "Prefer to split after ternary operators (+3 on left)."};
   }
-  if (left_context.DirectParentIs(NodeEnum::kTernaryExpression) &&
-      IsTernaryOperator(left_type)) {
+  if (IsTernaryOperator(left_type) &&
+      left_context.DirectParentIs(NodeEnum::kTernaryExpression)) {
     return {-1, "Prefer to split after ternary operators (-1 on right)."};
   }
-  if (right_context.DirectParentIs(NodeEnum::kBinaryExpression) &&
-      right.format_token_enum == FormatTokenType::binary_operator) {
+  if (right.format_token_enum == FormatTokenType::binary_operator &&
+      right_context.DirectParentIs(NodeEnum::kBinaryExpression)) {
     // This value should be kept small so that binding affinity still honors
     // operator precedence which is currently reflected in syntax tree depth.
     return {8, "Prefer to split after binary operators (+8 on left)."};
   }
-  if (left_context.DirectParentIs(NodeEnum::kBinaryExpression) &&
-      left.format_token_enum == FormatTokenType::binary_operator) {
+  if (left.format_token_enum == FormatTokenType::binary_operator &&
+      left_context.DirectParentIs(NodeEnum::kBinaryExpression)) {
     return {0, "Prefer to split after binary operators (+0 on right)."};
   }
   return {0, "No adjustment."};
 }
 
-// Returns the split penalty for line-breaking before the right token.
-static WithReason<int> BreakPenaltyBetween(
-    const verible::PreFormatToken& left, const verible::PreFormatToken& right,
-    const SyntaxTreeContext& left_context,
-    const SyntaxTreeContext& right_context) {
+// Returns the part of the split penalty for line-breaking before the right
+// token that does not depend on syntax tree depth.
+template <class Token, class Context>
+static int TokensBreakPenalty(const Token& left, const Token& right,
+                              const Context& left_context,
+                              const Context& right_context) {
   VLOG(3) << "Inter-token penalty between "
           << verilog_symbol_name(left.TokenEnum()) << " and "
           << verilog_symbol_name(right.TokenEnum());
 
-  const int depth_penalty = ContextBasedPenalty(left_context, right_context);
-  VLOG(3) << "context break penalty: " << depth_penalty;
-
   // This factor only looks at left and right tokens:
   const auto inter_token_penalty = BreakPenaltyBetweenTokens(left, right);
   VLOG(3) << "inter-token break penalty: " << inter_token_penalty.value << ", "
@@ -646,26 +872,31 @@ static WithReason<int> BreakPenaltyBetween(
       TokensWithContextBreakPenalty(left, right, left_context, right_context);
   VLOG(3) << "token+context break penalty: " << token_with_context_penalty.value
           << ", " << token_with_context_penalty.reason;
+  return inter_token_penalty.value + token_with_context_penalty.value;
+}
+
+// Returns the split penalty for line-breaking before the right token.
+//   tokens_penalty: from TokensBreakPenalty()
+static int BreakPenaltyBetween(int tokens_penalty, size_t common_depth) {
+  const int depth_penalty = ContextBasedPenalty(common_depth);
+  VLOG(3) << "context break penalty: " << depth_penalty;
 
   constexpr int kMinPenalty = 1;   // absolute minimum
   constexpr int kPenaltyBias = 5;  // baseline penalty value
   const int total_penalty =
-      std::max(kPenaltyBias + depth_penalty + inter_token_penalty.value +
-                   token_with_context_penalty.value,
-               kMinPenalty);
+      std::max(kPenaltyBias + depth_penalty + tokens_penalty, kMinPenalty);
 
   VLOG(3) << "total break penalty: " << total_penalty;
-  return {total_penalty, inter_token_penalty.reason};
+  return total_penalty;
 }
 
 // Returns decision whether to break, not break, or evaluate both choices.
+template <class Style, class Token, class Context>
 static WithReason<SpacingOptions> BreakDecisionBetween(
-    const FormatStyle& style, const PreFormatToken& left,
-    const PreFormatToken& right, const SyntaxTreeContext& left_context,
-    const SyntaxTreeContext& right_context) {
+    const Style& style, const Token& left, const Token& right,
+    const Context& left_context, const Context& right_context) {
   // For now, leave everything inside [dimensions] alone.
-  if (right_context.IsInsideFirst(
-          {NodeEnum::kDimensionRange, NodeEnum::kDimensionScalar}, {})) {
+  if (IsInsideDimensions(right_context)) {
     // ... except for the spacing immediately around '[' and ']',
     // which is covered by other rules.
     if (left.TokenEnum() != '[' && left.TokenEnum() != ']' &&
@@ -700,7 +931,7 @@ static WithReason<SpacingOptions> BreakDecisionBetween(
     // Caution: when testing this case, must provide valid text between
     // tokens to avoid reading uninitialized memory.
     auto preceding_whitespace = verible::make_string_view_range(
-        left.token->text.end(), right.token->text.begin());
+        left.Text().end(), right.Text().begin());
 
     auto pos = preceding_whitespace.find_first_of('\n', 0);
     if (pos == absl::string_view::npos) {
@@ -734,7 +965,7 @@ static WithReason<SpacingOptions> BreakDecisionBetween(
 
   // TODO(fangism): No break between `define and PP_Identifier.
 
-  if (IsEndKeyword(verilog_tokentype(right.TokenEnum()))) {
+  if (IsEndKeyword(TokenType(right))) {
     return {SpacingOptions::MustWrap, "end* keywords should start own lines"};
   }
 
@@ -775,8 +1006,7 @@ static WithReason<SpacingOptions> BreakDecisionBetween(
             "`end and `else should be on their own line except for comments."};
   }
 
-  if (IsPreprocessorKeyword(
-          static_cast<verilog_tokentype>(right.TokenEnum()))) {
+  if (IsPreprocessorKeyword(TokenType(right))) {
     // The tree unwrapper should make sure these start their own partition.
     return {SpacingOptions::MustWrap,
             "Preprocessor directives should start their own line."};
@@ -806,6 +1036,218 @@ static void AnnotateOriginalSpacing(
   // This does not cover the spacing between the last token and EOF.
 }
 
+// Annotation between a pair of tokens, except for the part of the break
+// penalty that depends on syntax tree depth.
+struct PairAnnotation {
+  int spaces_required = 0;
+  bool force_preserve_spaces = false;
+  // From TokensBreakPenalty(), unless force_preserve_spaces.
+  int tokens_penalty = 0;
+  SpacingOptions break_decision = SpacingOptions::Preserve;
+};
+
+// Evaluates all rules between the left and right token.
+template <class Style, class Token, class Context>
+static PairAnnotation AnnotatePair(const Style& style, const Token& left,
+                                   const Token& right,
+                                   const Context& left_context,
+                                   const Context& right_context) {
+  PairAnnotation result;
+  const auto p =
+      SpacesRequiredBetween(style, left, right, left_context, right_context);
+  result.spaces_required = p.spaces_required;
+  result.force_preserve_spaces = p.force_preserve_spaces;
+  if (p.force_preserve_spaces) {
+    // forego all inter-token calculations
+    result.break_decision = SpacingOptions::Preserve;
+  } else {
+    // Find the break penalty and if the right token is allowed to
+    // break before it.
+    result.tokens_penalty =
+        TokensBreakPenalty(left, right, left_context, right_context);
+    const auto breaker =
+        BreakDecisionBetween(style, left, right, left_context, right_context);
+    result.break_decision = breaker.value;
+    VLOG(3) << "line break constraint: " << breaker.value << ": "
+            << breaker.reason;
+  }
+  return result;
+}
+
+// Token enums below this are classified by TokenPairTable, which covers all
+// Verilog tokens.  Pairs with other enums always evaluate the rules.
+static constexpr int kNumClassifiedTokenEnums = 1024;
+
+// TokenPairTable holds the annotations between classes of tokens, for pairs
+// whose annotation depends on nothing else than their token enums and the
+// ContextFacts of the right token.  This resolves the majority of pairs in
+// O(1), without evaluating the rules.
+//
+// Tokens are in the same class if the rules cannot tell them apart: they have
+// the same format token type and classifications, and no rule names any of
+// them.  The table is generated by evaluating the rules on ProbeTokens of each
+// pair of classes, so that it cannot drift from them; pairs for which the
+// rules query anything else are left to evaluating the rules.
+class TokenPairTable {
+ public:
+  // Returns the table, which is built on first use.
+  static const TokenPairTable& Get() {
+    static const auto* table = new TokenPairTable();
+    return *table;
+  }
+
+  // Returns the annotation between 'left' and 'right', or nullptr if it
+  // depends on more than this table covers.
+  const PairAnnotation* Find(const PreFormatToken& left,
+                             const PreFormatToken& right,
+                             const SyntaxTreeContext& right_context) const {
+    const int left_class = TokenClass(left);
+    if (left_class < 0) return nullptr;
+    const int right_class = TokenClass(right);
+    if (right_class < 0) return nullptr;
+    const int facts = (IsInsideDimensions(right_context) ? kInsideDimensions
+                                                         : 0) |
+                      (IsInsideUdpEntry(right_context) ? kInsideUdpEntry : 0);
+    const Entry& entry = entries_[EntryIndex(left_class, right_class, facts)];
+    return entry.resolved ? &entry.annotation : nullptr;
+  }
+
+ private:
+  struct Entry {
+    // True if 'annotation' holds for every pair of tokens in these classes.
+    bool resolved = false;
+    PairAnnotation annotation;
+  };
+
+  TokenPairTable();
+
+  // Groups tokens into classes, each of the 'distinguished' token enums in its
+  // own, and evaluates the rules on each pair of classes.  Inserts the token
+  // enums that the rules name into 'named_enums'.
+  void Build(const std::set<int>& distinguished, std::set<int>* named_enums);
+
+  // Returns the class of 'ftoken', or -1 if it is not covered.
+  int TokenClass(const PreFormatToken& ftoken) const {
+    const int token_enum = ftoken.TokenEnum();
+    if (token_enum < 0 || token_enum >= kNumClassifiedTokenEnums ||
+        ftoken.format_token_enum != format_token_types_[token_enum] ||
+        HasEmptyText(ftoken)) {
+      return -1;
+    }
+    return token_classes_[token_enum];
+  }
+
+  size_t EntryIndex(int left_class, int right_class, int facts) const {
+    return (left_class * num_classes_ + right_class) *
+               kNumContextFactCombinations +
+           facts;
+  }
+
+  // Indexed by token enum.
+  std::vector<int> format_token_types_;
+  std::vector<uint16_t> token_classes_;
+
+  size_t num_classes_ = 0;
+
+  // Indexed by EntryIndex().
+  std::vector<Entry> entries_;
+};
+
+TokenPairTable::TokenPairTable()
+    : format_token_types_(kNumClassifiedTokenEnums),
+      token_classes_(kNumClassifiedTokenEnums) {
+  for (int token_enum = 0; token_enum < kNumClassifiedTokenEnums;
+       ++token_enum) {
+    format_token_types_[token_enum] =
+        GetFormatTokenType(verilog_tokentype(token_enum));
+  }
+  // A rule may name a token enum only after telling apart another one, so
+  // distinguish the named enums until no more are found.  Then every rule
+  // condition that was reached holds alike for all tokens of a class.
+  std::set<int> distinguished;
+  while (true) {
+    std::set<int> named_enums;
+    Build(distinguished, &named_enums);
+    if (std::includes(distinguished.begin(), distinguished.end(),
+                      named_enums.begin(), named_enums.end())) {
+      break;
+    }
+    distinguished.insert(named_enums.begin(), named_enums.end());
+  }
+}
+
+void TokenPairTable::Build(const std::set<int>& distinguished,
+                           std::set<int>* named_enums) {
+  // Group tokens by everything that the rules can tell about them.
+  typedef std::tuple<int, int, bool, bool, bool, bool, bool> Signature;
+  std::map<Signature, int> classes;
+  std::vector<int> representatives;
+  for (int token_enum = 0; token_enum < kNumClassifiedTokenEnums;
+       ++token_enum) {
+    const auto e = verilog_tokentype(token_enum);
+    const Signature signature(
+        distinguished.count(token_enum) ? token_enum : -1,
+        format_token_types_[token_enum], IsUnaryOperator(e),
+        IsKeywordCallable(e), IsEndKeyword(e), IsPreprocessorKeyword(e),
+        IsTernaryOperator(e));
+    const auto inserted = classes.emplace(signature, representatives.size());
+    if (inserted.second) representatives.push_back(token_enum);
+    token_classes_[token_enum] = inserted.first->second;
+  }
+  num_classes_ = representatives.size();
+
+  const ProbeStyle style;
+  entries_.assign(num_classes_ * num_classes_ * kNumContextFactCombinations,
+                  Entry());
+  for (size_t left_class = 0; left_class < num_classes_; ++left_class) {
+    const int left_enum = representatives[left_class];
+    for (size_t right_class = 0; right_class < num_classes_; ++right_class) {
+      const int right_enum = representatives[right_class];
+      for (int facts = 0; facts < kNumContextFactCombinations; ++facts) {
+        bool dependent = false;
+        const ProbeToken left(left_enum, format_token_types_[left_enum],
+                              named_enums, &dependent);
+        const ProbeToken right(right_enum, format_token_types_[right_enum],
+                               named_enums, &dependent);
+        const ProbeContext left_context(&dependent);
+        const ProbeContext right_context(facts, &dependent);
+        Entry& entry = entries_[EntryIndex(left_class, right_class, facts)];
+        entry.annotation =
+            AnnotatePair(style, left, right, left_context, right_context);
+        entry.resolved = !dependent;
+      }
+    }
+  }
+}
+
+// Annotates the spacing and line-breaking between prev_token and curr_token.
+//   common_depth: number of ancestors shared by prev_context and curr_context.
+//   use_pair_table: if false, always evaluate the rules.
+static void AnnotateFormatToken(const FormatStyle& style,
+                                const PreFormatToken& prev_token,
+                                PreFormatToken* curr_token,
+                                const SyntaxTreeContext& prev_context,
+                                const SyntaxTreeContext& curr_context,
+                                size_t common_depth,
+                                bool use_pair_table = true) {
+  const PairAnnotation* annotation =
+      use_pair_table ? TokenPairTable::Get().Find(prev_token, *curr_token,
+                                                   curr_context)
+                     : nullptr;
+  PairAnnotation evaluated;
+  if (annotation == nullptr) {
+    evaluated = AnnotatePair(style, prev_token, *curr_token, prev_context,
+                             curr_context);
+    annotation = &evaluated;
+  }
+  curr_token->before.spaces_required = annotation->spaces_required;
+  curr_token->before.break_decision = annotation->break_decision;
+  if (!annotation->force_preserve_spaces) {
+    curr_token->before.break_penalty =
+        BreakPenaltyBetween(annotation->tokens_penalty, common_depth);
+  }
+}
+
 // Extern linkage for sake of direct testing, though not exposed in public
 // headers.
 // TODO(fangism): could move this to a -internal.h header.
@@ -814,35 +1256,32 @@ void AnnotateFormatToken(const FormatStyle& style,
                          PreFormatToken* curr_token,
                          const SyntaxTreeContext& prev_context,
                          const SyntaxTreeContext& curr_context) {
-  const auto p = SpacesRequiredBetween(style, prev_token, *curr_token,
-                                       prev_context, curr_context);
-  curr_token->before.spaces_required = p.spaces_required;
-  if (p.force_preserve_spaces) {
-    // forego all inter-token calculations
-    curr_token->before.break_decision = SpacingOptions::Preserve;
-  } else {
-    // Update the break penalty and if the curr_token is allowed to
-    // break before it.
-    const auto break_penalty = BreakPenaltyBetween(prev_token, *curr_token,
-                                                   prev_context, curr_context);
-    curr_token->before.break_penalty = break_penalty.value;
-    const auto breaker = BreakDecisionBetween(style, prev_token, *curr_token,
-                                              prev_context, curr_context);
-    curr_token->before.break_decision = breaker.value;
-    VLOG(3) << "line break constraint: " << breaker.value << ": "
-            << breaker.reason;
-  }
+  AnnotateFormatToken(style, prev_token, curr_token, prev_context,
+                      curr_context,
+                      CommonAncestors(prev_context, curr_context));
+}
+
+// Same as above, but always evaluates the rules, for comparison with
+// TokenPairTable.
+void AnnotateFormatTokenWithoutPairTable(
+    const FormatStyle& style, const PreFormatToken& prev_token,
+    PreFormatToken* curr_token, const SyntaxTreeContext& prev_context,
+    const SyntaxTreeContext& curr_context) {
+  AnnotateFormatToken(style, prev_token, curr_token, prev_context,
+                      curr_context, CommonAncestors(prev_context, curr_context),
+                      false);
 }
 
 void AnnotateFormattingInformation(
     const FormatStyle& style, const verible::TextStructureView& text_structure,
     std::vector<verible::PreFormatToken>::iterator tokens_begin,
-    std::vector<verible::PreFormatToken>::iterator tokens_end) {
+    std::vector<verible::PreFormatToken>::iterator tokens_end,
+    int num_threads) {
   // This interface just forwards the relevant information from text_structure.
   AnnotateFormattingInformation(style, text_structure.Contents().begin(),
                                 text_structure.SyntaxTree().get(),
                                 text_structure.EOFToken(), tokens_begin,
-                                tokens_end);
+                                tokens_end, num_threads);
 }
 
 void AnnotateFormattingInformation(
@@ -850,7 +1289,8 @@ void AnnotateFormattingInformation(
     const verible::Symbol* syntax_tree_root,
     const verible::TokenInfo& eof_token,
     std::vector<verible::PreFormatToken>::iterator tokens_begin,
-    std::vector<verible::PreFormatToken>::iterator tokens_end) {
+    std::vector<verible::PreFormatToken>::iterator tokens_end,
+    int num_threads) {
   if (tokens_begin == tokens_end) {  // empty range
     return;
   }
@@ -867,10 +1307,11 @@ void AnnotateFormattingInformation(
       // lambda: bind the FormatStyle, forwarding all other arguments
       [&style](const PreFormatToken& prev_token, PreFormatToken* curr_token,
                const SyntaxTreeContext& prev_context,
-               const SyntaxTreeContext& current_context) {
+               const SyntaxTreeContext& current_context, size_t common_depth) {
         AnnotateFormatToken(style, prev_token, curr_token, prev_context,
-                            current_context);
-      });
+                            current_context, common_depth);
+      },
+      num_threads);
 }
 
 }  // namespace formatter
@@ -30,12 +30,15 @@ namespace formatter {
 // line-break penalties and decisions.
 //   style: Verilog-specific configuration
 //   tokens_begin, tokens_end: range of format tokens to be initialized.
+//   num_threads: top-level items are annotated concurrently on up to this
+//     many threads (see verible::ResolveNumThreads()).
 // TODO(b/130091585): replace modifiable unwrapped line with a read-only
 // struct and return separate annotations.
 void AnnotateFormattingInformation(
     const FormatStyle& style, const verible::TextStructureView& text_structure,
     std::vector<verible::PreFormatToken>::iterator tokens_begin,
-    std::vector<verible::PreFormatToken>::iterator tokens_end);
+    std::vector<verible::PreFormatToken>::iterator tokens_end,
+    int num_threads = 1);
 
 // This interface is only provided for testing, without requiring a
 // TextStructureView.
@@ -47,7 +50,8 @@ void AnnotateFormattingInformation(
     const verible::Symbol* syntax_tree_root,
     const verible::TokenInfo& eof_token,
     std::vector<verible::PreFormatToken>::iterator tokens_begin,
-    std::vector<verible::PreFormatToken>::iterator tokens_end);
+    std::vector<verible::PreFormatToken>::iterator tokens_end,
+    int num_threads = 1);
 
 }  // namespace formatter
 }  // namespace verilog
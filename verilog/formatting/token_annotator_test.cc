@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <initializer_list>
 #include <iterator>
+#include <numeric>
 #include <ostream>
 #include <vector>
 
@@ -50,6 +51,10 @@ extern void AnnotateFormatToken(const FormatStyle& style,
                                 PreFormatToken* curr_token,
                                 const verible::SyntaxTreeContext& prev_context,
                                 const verible::SyntaxTreeContext& curr_context);
+extern void AnnotateFormatTokenWithoutPairTable(
+    const FormatStyle& style, const PreFormatToken& prev_token,
+    PreFormatToken* curr_token, const verible::SyntaxTreeContext& prev_context,
+    const verible::SyntaxTreeContext& curr_context);
 
 namespace {
 
@@ -4460,6 +4465,69 @@ TEST(TokenAnnotatorTest, AnnotateBreakAroundComments) {
   }
 }
 
+// Expects that looking up annotations in the token pair table gives the same
+// results as evaluating the rules, for every pair of the given token enums.
+void ExpectPairTableMatchesRules(const std::vector<int>& token_enums) {
+  const absl::string_view text("l r");
+  struct ContextPair {
+    InitializedSyntaxTreeContext left_context;
+    InitializedSyntaxTreeContext right_context;
+  };
+  const ContextPair kContextPairs[] = {
+      {{}, {}},
+      {{NodeEnum::kDimensionRange}, {NodeEnum::kDimensionRange}},
+      {{NodeEnum::kBinaryExpression}, {NodeEnum::kTernaryExpression}},
+      {{NodeEnum::kUdpCombEntry}, {NodeEnum::kUdpCombEntry}},
+      {{}, {NodeEnum::kUdpSequenceEntry, NodeEnum::kDimensionScalar}},
+  };
+  for (const int left_enum : token_enums) {
+    const verible::TokenInfo left_token(left_enum, text.substr(0, 1));
+    for (const int right_enum : token_enums) {
+      const verible::TokenInfo right_token(right_enum, text.substr(2, 1));
+      for (const auto& contexts : kContextPairs) {
+        PreFormatToken left(&left_token);
+        left.format_token_enum =
+            GetFormatTokenType(verilog_tokentype(left_enum));
+        PreFormatToken right(&right_token);
+        right.format_token_enum =
+            GetFormatTokenType(verilog_tokentype(right_enum));
+        PreFormatToken expected(right);
+        AnnotateFormatTokenWithoutPairTable(DefaultStyle, left, &expected,
+                                            contexts.left_context,
+                                            contexts.right_context);
+        AnnotateFormatToken(DefaultStyle, left, &right, contexts.left_context,
+                            contexts.right_context);
+        ASSERT_EQ(right.before, expected.before)
+            << "left: " << left_enum << ", right: " << right_enum
+            << ", right context: " << contexts.right_context;
+      }
+    }
+  }
+}
+
+// Covers all Verilog token enums.
+constexpr int kNumTokenEnums = 1024;
+
+// Tests the token pair table on a sample of the token enums: all single
+// character tokens, and every few of the others.
+TEST(TokenAnnotatorTest, PairTableMatchesRules) {
+  std::vector<int> token_enums;
+  for (int token_enum = 0; token_enum < kNumTokenEnums; ++token_enum) {
+    if (token_enum < 128 || token_enum % 7 == 0) {
+      token_enums.push_back(token_enum);
+    }
+  }
+  ExpectPairTableMatchesRules(token_enums);
+}
+
+// Tests the token pair table on every pair of token enums, including those
+// that share a class with a token that the rules name.
+TEST(TokenAnnotatorTest, PairTableMatchesRulesForAllTokens) {
+  std::vector<int> token_enums(kNumTokenEnums);
+  std::iota(token_enums.begin(), token_enums.end(), 0);
+  ExpectPairTableMatchesRules(token_enums);
+}
+
 }  // namespace
 }  // namespace formatter
 }  // namespace verilog
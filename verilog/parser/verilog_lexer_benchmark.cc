@@ -0,0 +1,110 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the throughput of VerilogLexer.
+//
+// Usage:
+//   bazel run -c opt //verilog/parser:verilog_lexer_benchmark
+// Compare against the lexer generated with full tables:
+//   bazel run -c opt --config=fast_lexer //verilog/parser:verilog_lexer_benchmark
+
+#include <cstddef>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "common/text/token_info.h"
+#include "verilog/parser/verilog_lexer.h"
+
+namespace verilog {
+namespace {
+
+using verible::TokenInfo;
+
+// Representative RTL, with a mix of comments, declarations, expressions,
+// numeric literals, preprocessor directives, and procedural code.
+constexpr char kRtlBlock[] = R"(
+// Synchronous FIFO with parameterized width and depth.
+`define FIFO_ASSERT(cond, msg) assert (cond) else $error(msg)
+module fifo #(
+  parameter int WIDTH = 32,
+  parameter int DEPTH = 16,
+  localparam int AW = $clog2(DEPTH)
+) (
+  input  logic             clk,
+  input  logic             rst_n,
+  input  logic             push,
+  input  logic [WIDTH-1:0] wdata,
+  input  logic             pop,
+  output logic [WIDTH-1:0] rdata,
+  output logic             full,
+  output logic             empty
+);
+  /* storage */
+  logic [WIDTH-1:0] mem [DEPTH];
+  logic [AW:0] wptr, rptr;
+
+  assign full  = (wptr[AW] != rptr[AW]) && (wptr[AW-1:0] == rptr[AW-1:0]);
+  assign empty = (wptr == rptr);
+  assign rdata = mem[rptr[AW-1:0]];
+
+  always_ff @(posedge clk or negedge rst_n) begin : ptr_update
+    if (!rst_n) begin
+      wptr <= '0;
+      rptr <= '0;
+    end else begin
+      if (push && !full) begin
+        mem[wptr[AW-1:0]] <= wdata;
+        wptr <= wptr + 1'b1;
+      end
+      if (pop && !empty) rptr <= rptr + 1'b1;
+    end
+  end : ptr_update
+
+`ifndef SYNTHESIS
+  always @(posedge clk) begin
+    `FIFO_ASSERT(!(push && full), "push while full");
+    `FIFO_ASSERT(!(pop && empty), "pop while empty");
+  end
+`endif
+endmodule : fifo
+)";
+
+// Returns kRtlBlock repeated 'count' times.
+std::string MakeRtl(int count) {
+  std::string code;
+  code.reserve(count * sizeof(kRtlBlock));
+  for (int i = 0; i < count; ++i) code += kRtlBlock;
+  return code;
+}
+
+void BM_LexRtl(benchmark::State& state) {
+  const std::string code = MakeRtl(state.range(0));
+  size_t num_tokens = 0;
+  for (auto _ : state) {
+    VerilogLexer lexer(code);
+    num_tokens = 0;
+    for (;;) {
+      const TokenInfo& token = lexer.DoNextToken();
+      if (token.isEOF()) break;
+      ++num_tokens;
+    }
+    benchmark::DoNotOptimize(num_tokens);
+  }
+  state.SetItemsProcessed(state.iterations() * num_tokens);
+  state.SetBytesProcessed(state.iterations() * code.size());
+}
+BENCHMARK(BM_LexRtl)->Arg(1)->Arg(64)->Arg(1024);
+
+}  // namespace
+}  // namespace verilog
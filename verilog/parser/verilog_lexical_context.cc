@@ -16,8 +16,8 @@
 
 #include "verilog/parser/verilog_lexical_context.h"
 
+#include <cstddef>
 #include <iostream>
-#include <set>
 #include <stack>
 #include <vector>
 
@@ -28,45 +28,205 @@ namespace verilog {
 
 using verible::TokenInfo;
 
-// Returns true for begin/end-like tokens that can be followed with an optional
-// label.
-static bool KeywordAcceptsOptionalLabel(int token_enum) {
-  static const auto* keywords = new std::set<int>(
-      {// begin-like keywords
-       TK_begin, TK_fork, TK_generate,
-       // end-like keywords
-       TK_end, TK_endgenerate, TK_endcase, TK_endconfig, TK_endfunction,
-       TK_endmodule, TK_endprimitive, TK_endspecify, TK_endtable, TK_endtask,
-       TK_endclass, TK_endclocking, TK_endgroup, TK_endinterface, TK_endpackage,
-       TK_endprogram, TK_endproperty, TK_endsequence, TK_endchecker,
-       TK_endconnectrules, TK_enddiscipline, TK_endnature, TK_endparamset,
-       TK_join, TK_join_any, TK_join_none});
-  return keywords->find(token_enum) != keywords->end();
+namespace {
+
+// The sub-state-machines below are table-driven: every token enum maps to a
+// token class, and each state machine looks up its next state (or stack
+// operation) in a table indexed by [state][token class].
+// The tables are generated at compile-time from a short list of transitions,
+// so that the per-token work is a classification and a table lookup.
+
+// Token classes that are distinguished by the sub-state-machines.
+// All other tokens are kOtherToken.
+enum TokenClass {
+  kOtherToken,
+  kLabelKeyword,  // begin/end-like keywords that accept an optional label
+  kColon,
+  kSemicolon,
+  kOpenParen,
+  kCloseParen,
+  kOpenBrace,
+  kCloseBrace,
+  kRightArrow,  // '->' before or after interpretation in a constraint
+  kIfKeyword,
+  kElseKeyword,
+  kForeachKeyword,
+  kConstraintItemKeyword,  // keywords that start ';'-terminated constraints
+  kWithKeyword,
+  kRandomizeKeyword,
+  kConstraintKeyword,
+  kIdentifier,
+  kNumTokenClasses,
+};
+
+constexpr TokenClass ClassifyToken(int token_enum) {
+  switch (token_enum) {
+    // begin-like keywords
+    case TK_begin:
+    case TK_fork:
+    case TK_generate:
+    // end-like keywords
+    case TK_end:
+    case TK_endgenerate:
+    case TK_endcase:
+    case TK_endconfig:
+    case TK_endfunction:
+    case TK_endmodule:
+    case TK_endprimitive:
+    case TK_endspecify:
+    case TK_endtable:
+    case TK_endtask:
+    case TK_endclass:
+    case TK_endclocking:
+    case TK_endgroup:
+    case TK_endinterface:
+    case TK_endpackage:
+    case TK_endprogram:
+    case TK_endproperty:
+    case TK_endsequence:
+    case TK_endchecker:
+    case TK_endconnectrules:
+    case TK_enddiscipline:
+    case TK_endnature:
+    case TK_endparamset:
+    case TK_join:
+    case TK_join_any:
+    case TK_join_none:
+      return kLabelKeyword;
+    case ':':
+      return kColon;
+    case ';':
+      return kSemicolon;
+    case '(':
+      return kOpenParen;
+    case ')':
+      return kCloseParen;
+    case '{':
+      return kOpenBrace;
+    case '}':
+      return kCloseBrace;
+    case _TK_RARROW:             // before interpretation
+    case TK_CONSTRAINT_IMPLIES:  // after interpretation
+      return kRightArrow;
+    case TK_if:
+      return kIfKeyword;
+    case TK_else:
+      return kElseKeyword;
+    case TK_foreach:
+      return kForeachKeyword;
+    case TK_soft:
+    case TK_unique:
+    case TK_disable:
+    case TK_solve:
+      return kConstraintItemKeyword;
+    case TK_with:
+      return kWithKeyword;
+    case TK_randomize:
+      return kRandomizeKeyword;
+    case TK_constraint:
+      return kConstraintKeyword;
+    case SymbolIdentifier:
+      return kIdentifier;
+    default:
+      return kOtherToken;
+  }
 }
 
-void _KeywordLabelStateMachine::UpdateState(int token_enum) {
-  // In any state, reset on encountering keyword.
-  if (KeywordAcceptsOptionalLabel(token_enum)) {
-    state_ = kGotKeyword;
-    return;
+// In state 'from', a token of class 'on' leads to 'to'.
+template <typename T>
+struct Transition {
+  int from;
+  TokenClass on;
+  T to;
+};
+
+// Table of T (next state or action), indexed by [state][token class].
+template <typename T, int kNumStates>
+struct TransitionTable {
+  T next[kNumStates][kNumTokenClasses];
+
+  const T& operator()(int state, int token_enum) const {
+    return next[state][ClassifyToken(token_enum)];
   }
-  // Scan for optional : label.
-  switch (state_) {
-    case kNone:
-      break;
-    case kGotKeyword:
-      if (token_enum == ':') {
-        state_ = kGotColonExpectingLabel;
-      } else {
-        state_ = kNone;
-      }
-      break;
-    case kGotColonExpectingLabel:
-      // Expect a SymbolIdentifier as a label, but don't really care if it
-      // actually is or not.
-      state_ = kNone;
-      break;
+};
+
+// Generates a transition table at compile-time.
+// 'defaults[s]' applies to all token classes that have no transition out of
+// state s.
+template <typename T, int kNumStates, size_t kNumTransitions>
+constexpr TransitionTable<T, kNumStates> MakeTransitionTable(
+    const T (&defaults)[kNumStates],
+    const Transition<T> (&transitions)[kNumTransitions]) {
+  TransitionTable<T, kNumStates> table{};
+  for (int state = 0; state < kNumStates; ++state) {
+    for (int token_class = 0; token_class < kNumTokenClasses; ++token_class) {
+      table.next[state][token_class] = defaults[state];
+    }
+  }
+  for (const auto& transition : transitions) {
+    table.next[transition.from][transition.on] = transition.to;
   }
+  return table;
+}
+
+// Stack operation for a pushdown automaton: pop the top state (optional),
+// then push up to two states (in order), then optionally re-handle the same
+// token in the new top state.
+template <typename State>
+struct StackAction {
+  bool pop;
+  int num_pushed;
+  State pushed[2];
+  bool reprocess;
+};
+
+template <typename State>
+constexpr StackAction<State> Stay() {
+  return {false, 0, {}, false};
+}
+template <typename State>
+constexpr StackAction<State> Push(State first) {
+  return {false, 1, {first, first}, false};
+}
+template <typename State>
+constexpr StackAction<State> Push(State first, State second) {
+  return {false, 2, {first, second}, false};
+}
+template <typename State>
+constexpr StackAction<State> Pop() {
+  return {true, 0, {}, false};
+}
+template <typename State>
+constexpr StackAction<State> ReplaceTop(State first) {
+  return {true, 1, {first, first}, false};
+}
+template <typename State>
+constexpr StackAction<State> ReplaceTop(State first, State second) {
+  return {true, 2, {first, second}, false};
+}
+// On invalid syntax, defer handling of token to the previous state on the
+// stack.  If the stack becomes empty, the state machine exits entirely.
+template <typename State>
+constexpr StackAction<State> PopAndReprocess() {
+  return {true, 0, {}, true};
+}
+
+}  // namespace
+
+void _KeywordLabelStateMachine::UpdateState(int token_enum) {
+  static constexpr State kDefaults[] = {kNone, kNone, kNone};
+  static constexpr Transition<State> kTransitions[] = {
+      // In any state, reset on encountering keyword.
+      {kNone, kLabelKeyword, kGotKeyword},
+      {kGotKeyword, kLabelKeyword, kGotKeyword},
+      {kGotColonExpectingLabel, kLabelKeyword, kGotKeyword},
+      // Scan for optional : label.
+      {kGotKeyword, kColon, kGotColonExpectingLabel},
+      // Expect a SymbolIdentifier as a label, but don't really care if it
+      // actually is or not (default transition).
+  };
+  static constexpr auto kTable = MakeTransitionTable(kDefaults, kTransitions);
+  state_ = kTable(state_, token_enum);
 }
 
 std::ostream& _ConstraintBlockStateMachine::Dump(std::ostream& os) const {
@@ -77,13 +237,6 @@ std::ostream& _ConstraintBlockStateMachine::Dump(std::ostream& os) const {
   return os;
 }
 
-void _ConstraintBlockStateMachine::DeferInvalidToken(int token_enum) {
-  // On invalid syntax, defer handling of token to previous state on the
-  // stack.  If stack is empty, exit the state machine entirely.
-  states_.pop();
-  if (IsActive()) UpdateState(token_enum);
-}
-
 void _ConstraintBlockStateMachine::UpdateState(int token_enum) {
   if (!IsActive()) {
     if (token_enum == '{') {
@@ -94,162 +247,85 @@ void _ConstraintBlockStateMachine::UpdateState(int token_enum) {
   }
   // In verilog.y grammar:
   // see constraint_block, constraint_block_item, constraint_expression rules.
-  State& top(states_.top());
-  switch (top) {
-    case kBeginningOfBlockItemOrExpression: {
+  using Action = StackAction<State>;
+  static constexpr Action kDefaults[] = {
+      // kBeginningOfBlockItemOrExpression:
       // Depending on the next token, push into next state, so that
       // after each list item 'pops', it returns to this state.
-      switch (token_enum) {
-        case TK_soft:     // fall-through
-        case TK_unique:   // fall-through
-        case TK_disable:  // fall-through
-        case TK_solve:
-          states_.push(kIgnoreUntilSemicolon);
-          break;
-        case TK_if:
-          states_.push(kGotIf);
-          break;
-        case TK_else:
-          states_.push(kExpectingConstraintSet);  // the else-clause
-          break;
-        case TK_foreach:
-          states_.push(kGotForeach);
-          break;
-        case '(':
-          states_.push(kExpectingExpressionOrImplication);
-          states_.push(kInParenExpression);
-          break;
-        case '{':
-          states_.push(kExpectingExpressionOrImplication);
-          states_.push(kInBraceExpression);
-          break;
-        case '}':
-          states_.pop();
-          break;  // de-activates if this is the last level
-        default:
-          states_.push(kExpectingExpressionOrImplication);
-      }
-      break;
-    }
-    case kInParenExpression: {
-      switch (token_enum) {
-        case '(':
-          states_.push(kInParenExpression);
-          break;
-        case ')':
-          states_.pop();
-          break;
-        case '{':
-          states_.push(kInBraceExpression);
-          break;
-        default:  // ignore everything else
-          break;
-      }
-      break;
-    }
-    case kInBraceExpression: {
-      switch (token_enum) {
-        case '{':
-          states_.push(kInBraceExpression);
-          break;
-        case '}':
-          states_.pop();
-          break;
-        case '(':
-          states_.push(kInParenExpression);
-          break;
-        default:  // ignore everything else
-          break;
-      }
-      break;
-    }
-    case kExpectingExpressionOrImplication: {
-      switch (token_enum) {
-        case '{':
-          states_.push(kInBraceExpression);
-          break;
-        case '(':
-          states_.push(kInParenExpression);
-          break;
-        case '}':
-          // Invalid in this state, but possibly valid in parent state.
-          DeferInvalidToken(token_enum);
-          break;
-        case _TK_RARROW:             // fall-through (before interpretation)
-        case TK_CONSTRAINT_IMPLIES:  // (after interpretation)
-          top = kExpectingConstraintSet;  // constraint implication RHS
-          break;
-        case ';':
-          states_.pop();
-          break;
-        default:  // ignore everything else
-          break;
-      }
-      break;
-    }
-    case kIgnoreUntilSemicolon: {
-      switch (token_enum) {
-        case '(':
-          states_.push(kInParenExpression);
-          break;
-        case '{':
-          states_.push(kInBraceExpression);
-          break;
-        case ')':  // fall-through
-        case '}':
-          // Invalid syntax (unbalanced).
-          DeferInvalidToken(token_enum);
-          break;
-        case ';':
-          // Reset to expect constraint_block_item or constraint_expression.
-          states_.pop();
-          break;
-        default:  // no change
-          break;
-      }
-      break;
-    }
-    case kGotIf: {
-      switch (token_enum) {
-        case '(':
-          // After () predicate, expect a constraint_set clause.
-          top = kExpectingConstraintSet;  // the if-clause
-          states_.push(kInParenExpression);
-          break;
-        default:
-          DeferInvalidToken(token_enum);  // Invalid syntax.
-      }
-      break;
-    }
-    case kGotForeach: {
-      switch (token_enum) {
-        case '(':
-          // After () variable list, expect a constraint_set clause.
-          top = kExpectingConstraintSet;  // the foreach body
-          states_.push(kInParenExpression);
-          break;
-        default:
-          DeferInvalidToken(token_enum);  // Invalid syntax.
-      }
-      break;
-    }
-    // A constraint_set is either a {} block or a single constraint_expression.
-    case kExpectingConstraintSet: {
-      switch (token_enum) {
-        case '{':
-          // By assigning top instead of pushing, once the block is balanced,
-          // it will pop back to the previous state before the construct that
-          // ends with a constraint_set.
-          top = kBeginningOfBlockItemOrExpression;
-          break;
-        default:
-          // goto main handler state, which will re-write the top-of-stack.
-          states_.pop();
-          UpdateState(token_enum);
-      }
-      break;
-    }
-  }  // switch (top)
+      Push(kExpectingExpressionOrImplication),
+      Stay<State>(),  // kIgnoreUntilSemicolon
+      Stay<State>(),  // kExpectingExpressionOrImplication
+      PopAndReprocess<State>(),  // kGotIf: invalid syntax
+      PopAndReprocess<State>(),  // kGotForeach: invalid syntax
+      // kExpectingConstraintSet:
+      // goto main handler state, which will re-write the top-of-stack.
+      PopAndReprocess<State>(),
+      Stay<State>(),  // kInParenExpression: ignore everything else
+      Stay<State>(),  // kInBraceExpression: ignore everything else
+  };
+  static constexpr Transition<Action> kTransitions[] = {
+      {kBeginningOfBlockItemOrExpression, kConstraintItemKeyword,
+       Push(kIgnoreUntilSemicolon)},
+      {kBeginningOfBlockItemOrExpression, kIfKeyword, Push(kGotIf)},
+      {kBeginningOfBlockItemOrExpression, kElseKeyword,
+       Push(kExpectingConstraintSet)},  // the else-clause
+      {kBeginningOfBlockItemOrExpression, kForeachKeyword, Push(kGotForeach)},
+      {kBeginningOfBlockItemOrExpression, kOpenParen,
+       Push(kExpectingExpressionOrImplication, kInParenExpression)},
+      {kBeginningOfBlockItemOrExpression, kOpenBrace,
+       Push(kExpectingExpressionOrImplication, kInBraceExpression)},
+      // de-activates if this is the last level
+      {kBeginningOfBlockItemOrExpression, kCloseBrace, Pop<State>()},
+
+      {kInParenExpression, kOpenParen, Push(kInParenExpression)},
+      {kInParenExpression, kCloseParen, Pop<State>()},
+      {kInParenExpression, kOpenBrace, Push(kInBraceExpression)},
+
+      {kInBraceExpression, kOpenBrace, Push(kInBraceExpression)},
+      {kInBraceExpression, kCloseBrace, Pop<State>()},
+      {kInBraceExpression, kOpenParen, Push(kInParenExpression)},
+
+      {kExpectingExpressionOrImplication, kOpenBrace, Push(kInBraceExpression)},
+      {kExpectingExpressionOrImplication, kOpenParen, Push(kInParenExpression)},
+      // Invalid in this state, but possibly valid in parent state.
+      {kExpectingExpressionOrImplication, kCloseBrace,
+       PopAndReprocess<State>()},
+      // constraint implication RHS
+      {kExpectingExpressionOrImplication, kRightArrow,
+       ReplaceTop(kExpectingConstraintSet)},
+      {kExpectingExpressionOrImplication, kSemicolon, Pop<State>()},
+
+      {kIgnoreUntilSemicolon, kOpenParen, Push(kInParenExpression)},
+      {kIgnoreUntilSemicolon, kOpenBrace, Push(kInBraceExpression)},
+      // Invalid syntax (unbalanced).
+      {kIgnoreUntilSemicolon, kCloseParen, PopAndReprocess<State>()},
+      {kIgnoreUntilSemicolon, kCloseBrace, PopAndReprocess<State>()},
+      // Reset to expect constraint_block_item or constraint_expression.
+      {kIgnoreUntilSemicolon, kSemicolon, Pop<State>()},
+
+      // After () predicate, expect a constraint_set clause (the if-clause).
+      {kGotIf, kOpenParen,
+       ReplaceTop(kExpectingConstraintSet, kInParenExpression)},
+      // After () variable list, expect a constraint_set clause (the body).
+      {kGotForeach, kOpenParen,
+       ReplaceTop(kExpectingConstraintSet, kInParenExpression)},
+
+      // A constraint_set is either a {} block or a single
+      // constraint_expression.
+      // By replacing top instead of pushing, once the block is balanced,
+      // it will pop back to the previous state before the construct that
+      // ends with a constraint_set.
+      {kExpectingConstraintSet, kOpenBrace,
+       ReplaceTop(kBeginningOfBlockItemOrExpression)},
+  };
+  static constexpr auto kTable = MakeTransitionTable(kDefaults, kTransitions);
+
+  const Action& action = kTable(states_.top(), token_enum);
+  if (action.pop) states_.pop();
+  for (int i = 0; i < action.num_pushed; ++i) {
+    states_.push(action.pushed[i]);
+  }
+  if (action.reprocess && IsActive()) UpdateState(token_enum);
 }
 
 int _ConstraintBlockStateMachine::InterpretToken(int token_enum) const {
@@ -264,86 +340,43 @@ int _ConstraintBlockStateMachine::InterpretToken(int token_enum) const {
 }
 
 void _RandomizeCallStateMachine::UpdateState(int token_enum) {
+  if (state_ == kInsideConstraintBlock) {
+    constraint_block_tracker_.UpdateState(token_enum);
+    if (!constraint_block_tracker_.IsActive())
+      state_ = kNone;  // end of randomize_call
+    // otherwise no state change
+    return;
+  }
   // EBNF for randomize_call:
   // 'randomize' { attribute_instance }
   //   [ '(' [ variable_identifier_list | 'null' ] ')' ]
   //   [ 'with' [ '(' [ identifier_list ] ')' ] constraint_block ]
-  switch (state_) {
-    case kNone:
-      if (token_enum == TK_randomize) {  // activate
-        state_ = kGotRandomizeKeyword;
-      }
-      break;
-    case kGotRandomizeKeyword:
-      switch (token_enum) {
-        case '(':
-          state_ = kOpenedVariableList;
-          break;
-        case TK_with:
-          state_ = kGotWithKeyword;
-          break;
-        default:  // anything else ends the randomize_call
-          state_ = kNone;
-      }
-      break;
-    case kOpenedVariableList:
-      switch (token_enum) {
-        case ')':
-          state_ = kClosedVariableList;
-          break;
-        default:
-          break;  // no state change
-      }
-      break;
-    case kClosedVariableList:
-      switch (token_enum) {
-        case TK_with:
-          state_ = kGotWithKeyword;
-          break;
-        default:  // anything else ends the randomize_call
-          state_ = kNone;
-      }
-      break;
-    case kGotWithKeyword:
-      switch (token_enum) {
-        case '(':
-          state_ = kInsideWithIdentifierList;
-          break;
-        case '{':
-          state_ = kInsideConstraintBlock;
-          constraint_block_tracker_.UpdateState(token_enum);
-          break;
-        default:
-          break;  // no state change
-      }
-      break;
-    case kInsideWithIdentifierList:
-      switch (token_enum) {
-        case ')':
-          state_ = kExpectConstraintBlock;
-          break;
-        default:
-          break;  // no state change
-      }
-      break;
-    case kExpectConstraintBlock:
-      switch (token_enum) {
-        case '{':
-          state_ = kInsideConstraintBlock;
-          constraint_block_tracker_.UpdateState(token_enum);
-          break;
-        default:  // anything else ends the randomize_call
-          state_ = kNone;
-          break;
-      }
-      break;
-    case kInsideConstraintBlock: {
-      constraint_block_tracker_.UpdateState(token_enum);
-      if (!constraint_block_tracker_.IsActive())
-        state_ = kNone;  // end of randomize_call
-      // otherwise no state change
-      break;
-    }
+  static constexpr State kDefaults[] = {
+      kNone,                      // kNone
+      kNone,                      // kGotRandomizeKeyword: ends randomize_call
+      kOpenedVariableList,        // kOpenedVariableList: no state change
+      kNone,                      // kClosedVariableList: ends randomize_call
+      kGotWithKeyword,            // kGotWithKeyword: no state change
+      kInsideWithIdentifierList,  // kInsideWithIdentifierList: no change
+      kNone,                   // kExpectConstraintBlock: ends randomize_call
+      kInsideConstraintBlock,  // kInsideConstraintBlock: (handled above)
+  };
+  static constexpr Transition<State> kTransitions[] = {
+      {kNone, kRandomizeKeyword, kGotRandomizeKeyword},  // activate
+      {kGotRandomizeKeyword, kOpenParen, kOpenedVariableList},
+      {kGotRandomizeKeyword, kWithKeyword, kGotWithKeyword},
+      {kOpenedVariableList, kCloseParen, kClosedVariableList},
+      {kClosedVariableList, kWithKeyword, kGotWithKeyword},
+      {kGotWithKeyword, kOpenParen, kInsideWithIdentifierList},
+      {kGotWithKeyword, kOpenBrace, kInsideConstraintBlock},
+      {kInsideWithIdentifierList, kCloseParen, kExpectConstraintBlock},
+      {kExpectConstraintBlock, kOpenBrace, kInsideConstraintBlock},
+  };
+  static constexpr auto kTable = MakeTransitionTable(kDefaults, kTransitions);
+  state_ = kTable(state_, token_enum);
+  if (state_ == kInsideConstraintBlock) {
+    // Activates the nested state machine on '{'.
+    constraint_block_tracker_.UpdateState(token_enum);
   }
 }
 
@@ -358,41 +391,29 @@ int _RandomizeCallStateMachine::InterpretToken(int token_enum) const {
 }
 
 void _ConstraintDeclarationStateMachine::UpdateState(int token_enum) {
-  switch (state_) {
-    case kNone:
-      switch (token_enum) {
-        case TK_constraint:
-          state_ = kGotConstraintKeyword;
-          break;
-        default:
-          break;  // no change
-      }
-      break;
-    case kGotConstraintKeyword:
-      switch (token_enum) {
-        case SymbolIdentifier:
-          state_ = kGotConstraintIdentifier;
-          break;
-        default:
-          state_ = kNone;  // reset
-      }
-      break;
-    case kGotConstraintIdentifier:
-      switch (token_enum) {
-        case '{':
-          state_ = kInsideConstraintBlock;
-          constraint_block_tracker_.UpdateState(token_enum);
-          break;
-        default:
-          state_ = kNone;  // reset
-      }
-      break;
-    case kInsideConstraintBlock:
-      constraint_block_tracker_.UpdateState(token_enum);
-      if (!constraint_block_tracker_.IsActive()) {
-        state_ = kNone;
-      }
-      break;
+  if (state_ == kInsideConstraintBlock) {
+    constraint_block_tracker_.UpdateState(token_enum);
+    if (!constraint_block_tracker_.IsActive()) {
+      state_ = kNone;
+    }
+    return;
+  }
+  static constexpr State kDefaults[] = {
+      kNone,                   // kNone: no change
+      kNone,                   // kGotConstraintKeyword: reset
+      kNone,                   // kGotConstraintIdentifier: reset
+      kInsideConstraintBlock,  // kInsideConstraintBlock: (handled above)
+  };
+  static constexpr Transition<State> kTransitions[] = {
+      {kNone, kConstraintKeyword, kGotConstraintKeyword},
+      {kGotConstraintKeyword, kIdentifier, kGotConstraintIdentifier},
+      {kGotConstraintIdentifier, kOpenBrace, kInsideConstraintBlock},
+  };
+  static constexpr auto kTable = MakeTransitionTable(kDefaults, kTransitions);
+  state_ = kTable(state_, token_enum);
+  if (state_ == kInsideConstraintBlock) {
+    // Activates the nested state machine on '{'.
+    constraint_block_tracker_.UpdateState(token_enum);
   }
 }
 
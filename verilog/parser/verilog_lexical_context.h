@@ -47,6 +47,8 @@ class _KeywordLabelStateMachine {
 
 // Helper state machine for tracking constraint_block and constraint_set in the
 // grammar.
+// This is a pushdown automaton, driven by a compile-time table of
+// stack operations indexed by [top-of-stack state][token class].
 class _ConstraintBlockStateMachine {
  public:
   _ConstraintBlockStateMachine() = default;
@@ -63,8 +65,6 @@ class _ConstraintBlockStateMachine {
   std::ostream& Dump(std::ostream&) const;
 
  private:
-  void DeferInvalidToken(int token_enum);
-
   // See grammar for constraint_block_item and constraint_expression.
   enum State {
     kBeginningOfBlockItemOrExpression,  // list item (home state)
@@ -99,7 +99,9 @@ class _ConstraintBlockStateMachine {
   // Constraint sets are nestable, so we need a stack.
   // Each level of this stack represents a level of constraint block or
   // constraint set, both of which are wrapped in { }.
-  std::stack<State> states_;
+  // Backed by a vector, which avoids deque block allocations on every
+  // activation.
+  std::stack<State, std::vector<State>> states_;
 };
 
 inline std::ostream& operator<<(std::ostream& os,
@@ -237,13 +239,18 @@ class LexicalContext {
   // enumerations.
   void TransformVerilogSymbols(
       const verible::TokenStreamReferenceView& tokens_view) {
-    // TODO(fangism): Using a stream interface would further decouple the input
-    // iteration from output iteration.
     for (auto iter : tokens_view) {
-      _AdvanceToken(&*iter);
+      AdvanceToken(&*iter);
     }
   }
 
+  // Streaming interface: re-writes a single token's enum in-place, given all
+  // of the tokens that were previously advanced.
+  // Tokens must be advanced in order, and must remain valid (not be moved)
+  // until the end of the stream, because an earlier token may still be
+  // re-written upon seeing a later token.
+  void AdvanceToken(verible::TokenInfo* token) { _AdvanceToken(token); }
+
  protected:  // Allow direct testing of some methods.
   // Reads a single token, and may alter it depending on internal state.
   void _AdvanceToken(verible::TokenInfo*);
@@ -0,0 +1,115 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the throughput of LexicalContext::TransformVerilogSymbols.
+//
+// Usage:
+//   bazel run -c opt //verilog/parser:verilog_lexical_context_benchmark
+
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "common/text/token_info.h"
+#include "common/text/token_stream_view.h"
+#include "verilog/parser/verilog_lexer.h"
+#include "verilog/parser/verilog_lexical_context.h"
+
+namespace verilog {
+namespace {
+
+using verible::TokenInfo;
+using verible::TokenSequence;
+using verible::TokenStreamReferenceView;
+
+// Representative code that exercises every sub-state-machine.
+constexpr char kCodeBlock[] = R"(
+class c extends base;
+  rand int a, b;
+  constraint c_range {
+    soft a < 10;
+    if (a > 0) { b -> a; } else b == 0;
+    foreach (arr[i]) { arr[i] inside {[0:7]}; }
+    a -> { b < 4; }
+  }
+  function void f();
+    if (randomize(a) with { a -> b; }) begin : lbl
+      x = y -> z;
+    end : lbl
+    fork
+      @(posedge clk) a = b;
+    join_none
+  endfunction
+endclass
+module m;
+  property p;
+    @(posedge clk) a |-> b;
+  endproperty
+  sequence s;
+    a ##1 b;
+  endsequence
+  always @(posedge clk) begin
+    case (sel)
+      0: q <= d;
+      default: q <= 0;
+    endcase
+  end
+endmodule
+)";
+
+// Returns kCodeBlock repeated 'count' times.
+std::string MakeCode(int count) {
+  std::string code;
+  code.reserve(count * sizeof(kCodeBlock));
+  for (int i = 0; i < count; ++i) code += kCodeBlock;
+  return code;
+}
+
+// Lexes 'code', keeping only the tokens that LexicalContext sees.
+TokenSequence LexCode(const std::string& code) {
+  TokenSequence tokens;
+  VerilogLexer lexer(code);
+  for (;;) {
+    const TokenInfo& token = lexer.DoNextToken();
+    if (token.isEOF()) break;
+    if (VerilogLexer::KeepSyntaxTreeTokens(token)) tokens.push_back(token);
+  }
+  return tokens;
+}
+
+void BM_TransformVerilogSymbols(benchmark::State& state) {
+  const std::string code = MakeCode(state.range(0));
+  const TokenSequence original_tokens = LexCode(code);
+  TokenSequence tokens;
+  TokenStreamReferenceView view;
+  for (auto _ : state) {
+    // Start from untransformed tokens in every iteration.
+    state.PauseTiming();
+    tokens = original_tokens;
+    view.clear();
+    for (auto iter = tokens.begin(); iter != tokens.end(); ++iter) {
+      view.push_back(iter);
+    }
+    state.ResumeTiming();
+
+    LexicalContext context;
+    context.TransformVerilogSymbols(view);
+    benchmark::DoNotOptimize(tokens.data());
+  }
+  state.SetItemsProcessed(state.iterations() * original_tokens.size());
+  state.SetBytesProcessed(state.iterations() * code.size());
+}
+BENCHMARK(BM_TransformVerilogSymbols)->Arg(1)->Arg(64)->Arg(1024);
+
+}  // namespace
+}  // namespace verilog
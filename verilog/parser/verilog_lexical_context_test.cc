@@ -2157,5 +2157,284 @@ endfunction : rat
   ExpectTokenSequence({TK_endfunction, ':', SymbolIdentifier});
 }
 
+// Token enum sequences, and the enums that LexicalContext transforms them
+// into.  These were recorded from random sequences of fragments that enter
+// the contexts in which '->' and ';' are disambiguated, so they pin down the
+// transformations in many more states than the tests above.
+// Each sequence is the shortest one found for a combination of the
+// transformed token, its result, and the last context-entering fragment
+// before it.
+struct TransformGoldenCase {
+  std::vector<int> token_enums;
+  std::vector<int> expected_enums;
+};
+
+TEST(LexicalContextGoldenTest, TransformedTokenEnums) {
+  const TransformGoldenCase kTestCases[] = {
+      {{_TK_RARROW},
+       {TK_LOGICAL_IMPLIES}},
+      {{TK_randomize, _TK_RARROW},
+       {TK_randomize, _TK_RARROW}},
+      {{SymbolIdentifier, _TK_RARROW, '{'},
+       {SymbolIdentifier, TK_LOGICAL_IMPLIES, '{'}},
+      {{TK_always, TK_begin, _TK_RARROW},
+       {TK_always, TK_begin, TK_LOGICAL_IMPLIES}},
+      {{SymbolIdentifier, _TK_RARROW, SymbolIdentifier, ';'},
+       {SymbolIdentifier, TK_LOGICAL_IMPLIES, SymbolIdentifier, ';'}},
+      {{TK_constraint, SymbolIdentifier, _TK_RARROW, '{'},
+       {TK_constraint, SymbolIdentifier, _TK_RARROW, '{'}},
+      {{TK_disable, TK_fork, ';', _TK_RARROW},
+       {TK_disable, TK_fork, ';', TK_LOGICAL_IMPLIES}},
+      {{TK_module, SymbolIdentifier, ';', _TK_RARROW},
+       {TK_module, SymbolIdentifier, ';', TK_LOGICAL_IMPLIES}},
+      {{TK_constraint, SymbolIdentifier, '{', _TK_RARROW},
+       {TK_constraint, SymbolIdentifier, '{', TK_LOGICAL_IMPLIES}},
+      {{TK_end, ':', SymbolIdentifier, _TK_RARROW},
+       {TK_end, ':', SymbolIdentifier, TK_LOGICAL_IMPLIES}},
+      {{TK_property, SymbolIdentifier, ';', _TK_RARROW},
+       {TK_property, SymbolIdentifier, ';', TK_LOGICAL_IMPLIES}},
+      {{TK_sequence, SymbolIdentifier, ';', _TK_RARROW},
+       {TK_sequence, SymbolIdentifier, ';', TK_LOGICAL_IMPLIES}},
+      {{TK_begin, ':', SymbolIdentifier, _TK_RARROW},
+       {TK_begin, ':', SymbolIdentifier, TK_LOGICAL_IMPLIES}},
+      {{TK_task, SymbolIdentifier, ';', _TK_RARROW},
+       {TK_task, SymbolIdentifier, ';', TK_TRIGGER}},
+      {{TK_constraint, SymbolIdentifier, _TK_RARROW, SymbolIdentifier, ';'},
+       {TK_constraint, SymbolIdentifier, _TK_RARROW, SymbolIdentifier, ';'}},
+      {{TK_sequence, SymbolIdentifier, ';', TK_for, TK_endsequence},
+       {TK_sequence, SymbolIdentifier,
+        SemicolonEndOfAssertionVariableDeclarations, TK_for, TK_endsequence}},
+      {{TK_module, ';', TK_always_ff, _TK_RARROW, TK_for},
+       {TK_module, ';', TK_always_ff, TK_TRIGGER, TK_for}},
+      {{TK_property, SymbolIdentifier, ';', TK_unique, TK_endproperty},
+       {TK_property, SymbolIdentifier,
+        SemicolonEndOfAssertionVariableDeclarations, TK_unique,
+        TK_endproperty}},
+      {{TK_constraint, SymbolIdentifier, '{', TK_initial, _TK_RARROW},
+       {TK_constraint, SymbolIdentifier, '{', TK_initial,
+        TK_CONSTRAINT_IMPLIES}},
+      {{TK_module, SymbolIdentifier, ';', TK_initial, _TK_RARROW},
+       {TK_module, SymbolIdentifier, ';', TK_initial, TK_TRIGGER}},
+      {{TK_function, ';', SymbolIdentifier, _TK_RARROW, '{'},
+       {TK_function, ';', SymbolIdentifier, TK_TRIGGER, '{'}},
+      {{TK_task, SymbolIdentifier, ';', TK_constraint, _TK_RARROW},
+       {TK_task, SymbolIdentifier, ';', TK_constraint, _TK_RARROW}},
+      {{TK_always, TK_begin, '}', TK_randomize, _TK_RARROW},
+       {TK_always, TK_begin, '}', TK_randomize, _TK_RARROW}},
+      {{TK_constraint, SymbolIdentifier, '{', SymbolIdentifier, _TK_RARROW,
+        '{'},
+       {TK_constraint, SymbolIdentifier, '{', SymbolIdentifier,
+        TK_CONSTRAINT_IMPLIES, '{'}},
+      {{TK_solve, SymbolIdentifier, TK_before, SymbolIdentifier, ';',
+        _TK_RARROW},
+       {TK_solve, SymbolIdentifier, TK_before, SymbolIdentifier, ';',
+        TK_LOGICAL_IMPLIES}},
+      {{TK_randomize, '(', ')', TK_with, '{', _TK_RARROW},
+       {TK_randomize, '(', ')', TK_with, '{', TK_LOGICAL_IMPLIES}},
+      {{TK_function, SymbolIdentifier, '(', ')', ';', _TK_RARROW},
+       {TK_function, SymbolIdentifier, '(', ')', ';', TK_TRIGGER}},
+      {{TK_property, ';', TK_constraint, TK_endproperty, TK_endmodule,
+        MacroCallCloseToEndLine},
+       {TK_property, SemicolonEndOfAssertionVariableDeclarations, TK_constraint,
+        TK_endproperty, TK_endmodule, MacroCallCloseToEndLine}},
+      {{TK_if, '(', SymbolIdentifier, ')', '{', _TK_RARROW},
+       {TK_if, '(', SymbolIdentifier, ')', '{', TK_LOGICAL_IMPLIES}},
+      {{TK_task, SymbolIdentifier, ';', SymbolIdentifier, TK_module,
+        _TK_RARROW},
+       {TK_task, SymbolIdentifier, ';', SymbolIdentifier, TK_module,
+        TK_LOGICAL_IMPLIES}},
+      {{SymbolIdentifier, '.', TK_randomize, TK_with, '{', _TK_RARROW},
+       {SymbolIdentifier, '.', TK_randomize, TK_with, '{', TK_LOGICAL_IMPLIES}},
+      {{TK_sequence, SymbolIdentifier, ';', TK_randomize, _TK_RARROW, TK_end},
+       {TK_sequence, SymbolIdentifier, ';', TK_randomize, _TK_RARROW, TK_end}},
+      {{TK_task, SymbolIdentifier, ';', SymbolIdentifier, _TK_RARROW,
+        SymbolIdentifier, ';'},
+       {TK_task, SymbolIdentifier, ';', SymbolIdentifier, TK_TRIGGER,
+        SymbolIdentifier, ';'}},
+      {{TK_randomize, '(', ')', TK_with, '{', TK_final, _TK_RARROW},
+       {TK_randomize, '(', ')', TK_with, '{', TK_final, TK_CONSTRAINT_IMPLIES}},
+      {{TK_constraint, SymbolIdentifier, '{', SymbolIdentifier, _TK_RARROW,
+        SymbolIdentifier, ';'},
+       {TK_constraint, SymbolIdentifier, '{', SymbolIdentifier,
+        TK_CONSTRAINT_IMPLIES, SymbolIdentifier, ';'}},
+      {{TK_sequence, TK_with, TK_disable, TK_fork, ';', TK_randomize,
+        TK_endsequence},
+       {TK_sequence, TK_with, TK_disable, TK_fork,
+        SemicolonEndOfAssertionVariableDeclarations, TK_randomize,
+        TK_endsequence}},
+      {{TK_endsequence, TK_property, SymbolIdentifier, ';', TK_randomize,
+        _TK_RARROW, TK_else},
+       {TK_endsequence, TK_property, SymbolIdentifier, ';', TK_randomize,
+        _TK_RARROW, TK_else}},
+      {{SymbolIdentifier, '.', TK_randomize, TK_with, '{', ']', _TK_RARROW},
+       {SymbolIdentifier, '.', TK_randomize, TK_with, '{', ']',
+        TK_CONSTRAINT_IMPLIES}},
+      {{TK_task, TK_sequence, SymbolIdentifier, ';', TK_with, _TK_RARROW,
+        TK_case},
+       {TK_task, TK_sequence, SymbolIdentifier, ';', TK_with, TK_TRIGGER,
+        TK_case}},
+      {{TK_solve, SymbolIdentifier, TK_before, SymbolIdentifier, ';',
+        TK_constraint, _TK_RARROW},
+       {TK_solve, SymbolIdentifier, TK_before, SymbolIdentifier, ';',
+        TK_constraint, _TK_RARROW}},
+      {{TK_LE, TK_fork, TK_module, SymbolIdentifier, ';', TK_randomize,
+        _TK_RARROW},
+       {TK_LE, TK_fork, TK_module, SymbolIdentifier, ';', TK_randomize,
+        _TK_RARROW}},
+      {{TK_else, TK_fork, TK_end, ':', SymbolIdentifier, TK_randomize,
+        _TK_RARROW},
+       {TK_else, TK_fork, TK_end, ':', SymbolIdentifier, TK_randomize,
+        _TK_RARROW}},
+      {{TK_generate, TK_begin, ':', SymbolIdentifier, TK_constraint, _TK_RARROW,
+        TK_end},
+       {TK_generate, TK_begin, ':', SymbolIdentifier, TK_constraint, _TK_RARROW,
+        TK_end}},
+      {{TK_extern, TK_function, SymbolIdentifier, '(', ')', ';', _TK_RARROW,
+        TK_endmodule},
+       {TK_extern, TK_function, SymbolIdentifier, '(', ')', ';',
+        TK_LOGICAL_IMPLIES, TK_endmodule}},
+      {{'}', TK_task, SymbolIdentifier, ';', TK_property, SymbolIdentifier, ';',
+        _TK_RARROW},
+       {'}', TK_task, SymbolIdentifier, ';', TK_property, SymbolIdentifier, ';',
+        TK_TRIGGER}},
+      {{TK_property, SymbolIdentifier, ';', TK_task, SymbolIdentifier, ';', '[',
+        TK_endproperty},
+       {TK_property, SymbolIdentifier, ';', TK_task, SymbolIdentifier,
+        SemicolonEndOfAssertionVariableDeclarations, '[', TK_endproperty}},
+      {{TK_constraint, SymbolIdentifier, '{', TK_begin, ':', SymbolIdentifier,
+        _TK_RARROW, TK_function},
+       {TK_constraint, SymbolIdentifier, '{', TK_begin, ':', SymbolIdentifier,
+        TK_CONSTRAINT_IMPLIES, TK_function}},
+      {{TK_sequence, ',', TK_task, TK_disable, TK_fork, ';', _TK_RARROW,
+        TK_property},
+       {TK_sequence, ',', TK_task, TK_disable, TK_fork, ';', TK_TRIGGER,
+        TK_property}},
+      {{TK_randomize, TK_property, SymbolIdentifier, _TK_RARROW,
+        SymbolIdentifier, ';', TK_with, TK_endproperty},
+       {TK_randomize, TK_property, SymbolIdentifier, TK_LOGICAL_IMPLIES,
+        SymbolIdentifier, SemicolonEndOfAssertionVariableDeclarations, TK_with,
+        TK_endproperty}},
+      {{SymbolIdentifier, _TK_RARROW, '{', TK_property, ';', SymbolIdentifier,
+        ']', TK_endproperty},
+       {SymbolIdentifier, TK_LOGICAL_IMPLIES, '{', TK_property,
+        SemicolonEndOfAssertionVariableDeclarations, SymbolIdentifier, ']',
+        TK_endproperty}},
+      {{TK_disable, TK_task, SymbolIdentifier, ';', TK_initial, TK_always,
+        TK_begin, _TK_RARROW},
+       {TK_disable, TK_task, SymbolIdentifier, ';', TK_initial, TK_always,
+        TK_begin, TK_TRIGGER}},
+      {{TK_foreach, '(', SymbolIdentifier, '[', SymbolIdentifier, ']', ')',
+        _TK_RARROW},
+       {TK_foreach, '(', SymbolIdentifier, '[', SymbolIdentifier, ']', ')',
+        TK_LOGICAL_IMPLIES}},
+      {{TK_sequence, SymbolIdentifier, ';', TK_module, SymbolIdentifier, ';',
+        MacroCallCloseToEndLine, TK_endsequence},
+       {TK_sequence, SymbolIdentifier, ';', TK_module, SymbolIdentifier,
+        SemicolonEndOfAssertionVariableDeclarations, MacroCallCloseToEndLine,
+        TK_endsequence}},
+      {{TK_generate, TK_join, TK_disable, TK_fork, ';', TK_task, TK_randomize,
+        _TK_RARROW},
+       {TK_generate, TK_join, TK_disable, TK_fork, ';', TK_task, TK_randomize,
+        _TK_RARROW}},
+      {{TK_if, '(', SymbolIdentifier, ')', '{', TK_endfunction, TK_randomize,
+        _TK_RARROW},
+       {TK_if, '(', SymbolIdentifier, ')', '{', TK_endfunction, TK_randomize,
+        _TK_RARROW}},
+      {{TK_with, TK_sequence, TK_solve, SymbolIdentifier, TK_before,
+        SymbolIdentifier, ';', TK_join_none, TK_endsequence},
+       {TK_with, TK_sequence, TK_solve, SymbolIdentifier, TK_before,
+        SymbolIdentifier, SemicolonEndOfAssertionVariableDeclarations,
+        TK_join_none, TK_endsequence}},
+      {{TK_randomize, '(', ')', TK_with, '{', TK_end, ':', SymbolIdentifier,
+        _TK_RARROW},
+       {TK_randomize, '(', ')', TK_with, '{', TK_end, ':', SymbolIdentifier,
+        TK_CONSTRAINT_IMPLIES}},
+      {{TK_task, SymbolIdentifier, ';', SymbolIdentifier, TK_end, ':',
+        SymbolIdentifier, _TK_RARROW, TK_end},
+       {TK_task, SymbolIdentifier, ';', SymbolIdentifier, TK_end, ':',
+        SymbolIdentifier, TK_TRIGGER, TK_end}},
+      {{TK_constraint, SymbolIdentifier, '{', TK_sequence, TK_disable, TK_fork,
+        ';', TK_final, _TK_RARROW},
+       {TK_constraint, SymbolIdentifier, '{', TK_sequence, TK_disable, TK_fork,
+        ';', TK_final, TK_CONSTRAINT_IMPLIES}},
+      {{TK_task, TK_endsequence, TK_solve, SymbolIdentifier, TK_before,
+        SymbolIdentifier, ';', '[', _TK_RARROW},
+       {TK_task, TK_endsequence, TK_solve, SymbolIdentifier, TK_before,
+        SymbolIdentifier, ';', '[', TK_TRIGGER}},
+      {{TK_constraint, SymbolIdentifier, '{', TK_extern, TK_endcase, TK_always,
+        TK_begin, _TK_RARROW, TK_disable},
+       {TK_constraint, SymbolIdentifier, '{', TK_extern, TK_endcase, TK_always,
+        TK_begin, TK_CONSTRAINT_IMPLIES, TK_disable}},
+      {{TK_LE, TK_function, SymbolIdentifier, '(', ')', ';', TK_join_none,
+        TK_constraint, _TK_RARROW},
+       {TK_LE, TK_function, SymbolIdentifier, '(', ')', ';', TK_join_none,
+        TK_constraint, _TK_RARROW}},
+      {{TK_function, SymbolIdentifier, '(', ')', ';', TK_begin, ':',
+        SymbolIdentifier, _TK_RARROW, '='},
+       {TK_function, SymbolIdentifier, '(', ')', ';', TK_begin, ':',
+        SymbolIdentifier, TK_TRIGGER, '='}},
+      {{TK_foreach, '(', SymbolIdentifier, '[', SymbolIdentifier, ']', ')',
+        MacroCallCloseToEndLine, TK_constraint, _TK_RARROW},
+       {TK_foreach, '(', SymbolIdentifier, '[', SymbolIdentifier, ']', ')',
+        MacroCallCloseToEndLine, TK_constraint, _TK_RARROW}},
+      {{TK_constraint, SymbolIdentifier, '{', TK_module, SymbolIdentifier, ';',
+        _TK_RARROW, ',', _TK_RARROW, TK_join_none},
+       {TK_constraint, SymbolIdentifier, '{', TK_module, SymbolIdentifier, ';',
+        TK_LOGICAL_IMPLIES, ',', TK_CONSTRAINT_IMPLIES, TK_join_none}},
+      {{TK_property, TK_constraint, SymbolIdentifier, '{', TK_function,
+        SymbolIdentifier, '(', ')', ';', TK_LE, TK_endproperty},
+       {TK_property, TK_constraint, SymbolIdentifier, '{', TK_function,
+        SymbolIdentifier, '(', ')', SemicolonEndOfAssertionVariableDeclarations,
+        TK_LE, TK_endproperty}},
+      {{TK_endmodule, TK_constraint, SymbolIdentifier, '{', TK_function,
+        SymbolIdentifier, '(', ')', ';', '[', _TK_RARROW, '('},
+       {TK_endmodule, TK_constraint, SymbolIdentifier, '{', TK_function,
+        SymbolIdentifier, '(', ')', ';', '[', TK_CONSTRAINT_IMPLIES, '('}},
+      {{TK_task, SymbolIdentifier, ';', TK_property, TK_if, '(',
+        SymbolIdentifier, ')', '{', TK_join_any, TK_join, _TK_RARROW},
+       {TK_task, SymbolIdentifier, ';', TK_property, TK_if, '(',
+        SymbolIdentifier, ')', '{', TK_join_any, TK_join, TK_TRIGGER}},
+      {{SymbolIdentifier, '.', TK_randomize, TK_with, '{', TK_property,
+        SymbolIdentifier, ';', TK_end, TK_foreach, TK_endmodule, _TK_RARROW},
+       {SymbolIdentifier, '.', TK_randomize, TK_with, '{', TK_property,
+        SymbolIdentifier, ';', TK_end, TK_foreach, TK_endmodule,
+        TK_CONSTRAINT_IMPLIES}},
+      {{']', TK_constraint, SymbolIdentifier, '{', TK_if, '(', SymbolIdentifier,
+        ')', '{', TK_endcase, _TK_RARROW, TK_else},
+       {']', TK_constraint, SymbolIdentifier, '{', TK_if, '(', SymbolIdentifier,
+        ')', '{', TK_endcase, TK_CONSTRAINT_IMPLIES, TK_else}},
+      {{TK_constraint, SymbolIdentifier, '{', ')', ')', TK_foreach, '(',
+        SymbolIdentifier, '[', SymbolIdentifier, ']', ')', _TK_RARROW},
+       {TK_constraint, SymbolIdentifier, '{', ')', ')', TK_foreach, '(',
+        SymbolIdentifier, '[', SymbolIdentifier, ']', ')',
+        TK_CONSTRAINT_IMPLIES}},
+      {{'}', SymbolIdentifier, '.', TK_randomize, TK_with, '{', TK_solve,
+        SymbolIdentifier, TK_before, SymbolIdentifier, ';', TK_generate,
+        TK_solve, _TK_RARROW},
+       {'}', SymbolIdentifier, '.', TK_randomize, TK_with, '{', TK_solve,
+        SymbolIdentifier, TK_before, SymbolIdentifier, ';', TK_generate,
+        TK_solve, TK_CONSTRAINT_IMPLIES}},
+  };
+  for (const auto& test : kTestCases) {
+    TokenSequence tokens;
+    for (const int token_enum : test.token_enums) {
+      tokens.emplace_back(token_enum, "x");
+    }
+    TokenStreamReferenceView token_refs;
+    for (auto iter = tokens.begin(); iter != tokens.end(); ++iter) {
+      token_refs.push_back(iter);
+    }
+    LexicalContext context;
+    context.TransformVerilogSymbols(token_refs);
+    ASSERT_EQ(tokens.size(), test.expected_enums.size());
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      EXPECT_EQ(tokens[i].token_enum, test.expected_enums[i])
+          << "token[" << i << "] ("
+          << verilog_symbol_name(tokens[i].token_enum) << " vs. "
+          << verilog_symbol_name(test.expected_enums[i]) << ')';
+    }
+  }
+}
+
 }  // namespace
 }  // namespace verilog
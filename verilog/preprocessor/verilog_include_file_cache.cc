@@ -0,0 +1,123 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/preprocessor/verilog_include_file_cache.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/call_once.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "common/lexer/token_stream_adapter.h"
+#include "common/text/token_info.h"
+#include "common/text/token_stream_view.h"
+#include "common/util/file_util.h"
+#include "common/util/logging.h"
+#include "common/util/status_macros.h"
+#include "verilog/parser/verilog_lexer.h"
+#include "verilog/parser/verilog_lexical_context.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
+
+namespace verilog {
+
+using verible::TokenInfo;
+using verible::TokenSequence;
+using verible::TokenStreamView;
+
+absl::Status LexForPreprocessing(absl::string_view text, TokenSequence* tokens,
+                                 TokenStreamView* tokens_view) {
+  VerilogLexer lexer(text);
+  RETURN_IF_ERROR(verible::MakeTokenSequence(
+      &lexer, text, tokens, [](const TokenInfo& error_token) {
+        VLOG(1) << "Lexical error with token: " << error_token;
+      }));
+
+  // Filter and contextualize, same as VerilogAnalyzer.
+  verible::TokenStreamReferenceView reference_view;
+  reference_view.reserve(tokens->size());
+  tokens_view->clear();
+  tokens_view->reserve(tokens->size());
+  for (auto iter = tokens->begin(); iter != tokens->end(); ++iter) {
+    if (VerilogLexer::KeepSyntaxTreeTokens(*iter)) {
+      reference_view.push_back(iter);
+      tokens_view->push_back(iter);
+    }
+  }
+  LexicalContext context;
+  context.TransformVerilogSymbols(reference_view);
+  return absl::OkStatus();
+}
+
+VerilogIncludeFileCache& VerilogIncludeFileCache::Global() {
+  // Intentionally leaked, to avoid destruction order issues at exit.
+  static auto* cache = new VerilogIncludeFileCache();
+  return *cache;
+}
+
+const VerilogIncludedFile& VerilogIncludeFileCache::Get(
+    absl::string_view path) {
+  Entry* entry;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto& slot = entries_[std::string(path)];
+    if (slot == nullptr) {
+      slot = absl::make_unique<Entry>();
+      slot->file.path = std::string(path);
+    }
+    entry = slot.get();
+  }
+  // Lex outside of the map lock, so that different files load concurrently.
+  absl::call_once(entry->loaded, &VerilogIncludeFileCache::Load, &entry->file);
+  return entry->file;
+}
+
+size_t VerilogIncludeFileCache::Size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+void VerilogIncludeFileCache::Load(VerilogIncludedFile* file) {
+  VLOG(1) << "Loading include file: " << file->path;
+  file->status = verible::file::GetContents(file->path, &file->contents);
+  if (!file->status.ok()) return;
+
+  file->status =
+      LexForPreprocessing(file->contents, &file->tokens, &file->token_stream);
+  if (!file->status.ok()) {
+    file->status = absl::InvalidArgumentError(
+        absl::StrCat("Lexical error in ", file->path));
+    return;
+  }
+
+  // Collect this file's own macro definitions.  Nested `includes are left
+  // unexpanded, because they are resolved by the including preprocessor.
+  VerilogPreprocess preprocessor;
+  VerilogPreprocessData data = preprocessor.ScanStream(&file->token_stream);
+  if (!data.errors.empty()) {
+    const auto& error = data.errors.front();
+    file->status = absl::InvalidArgumentError(
+        absl::StrCat("Preprocessing error in ", file->path, " at \"",
+                     error.token_info.text, "\": ", error.error_message));
+    return;
+  }
+  file->macro_definitions = std::move(data.macro_definitions);
+}
+
+}  // namespace verilog
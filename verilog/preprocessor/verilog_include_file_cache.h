@@ -0,0 +1,115 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// VerilogIncludeFileCache is a process-wide, thread-safe cache of the lexed
+// and locally preprocessed contents of `included files.
+// A header that is `included by many files is read and lexed only once per
+// process, no matter how many analyses (possibly concurrent) request it.
+// Entries are never evicted, so all string_views and token iterators into
+// cached files remain valid for the lifetime of the process.
+
+#ifndef VERIBLE_VERILOG_PREPROCESSOR_VERILOG_INCLUDE_FILE_CACHE_H_
+#define VERIBLE_VERILOG_PREPROCESSOR_VERILOG_INCLUDE_FILE_CACHE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "absl/base/call_once.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/node_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "common/text/token_stream_view.h"
+#include "verilog/preprocessor/verilog_preprocess.h"
+
+namespace verilog {
+
+// Lexes 'text' into 'tokens', and initializes 'tokens_view' with the subset
+// of tokens relevant to the parser (no whitespace or comments), with lexical
+// context disambiguation already applied.
+// This is the same token preparation that VerilogAnalyzer does before
+// preprocessing.
+absl::Status LexForPreprocessing(absl::string_view text,
+                                 verible::TokenSequence* tokens,
+                                 verible::TokenStreamView* tokens_view);
+
+// Contents of a single file, lexed and preprocessed on its own, without
+// any surrounding context.
+struct VerilogIncludedFile {
+  // Path that was used to open this file.
+  std::string path;
+
+  // Status of reading, lexing, and preprocessing the file.
+  // A NotFound error means that there is no readable file at 'path'.
+  absl::Status status;
+
+  // Full text of the file, which backs all tokens below.
+  std::string contents;
+
+  // All lexed tokens.
+  verible::TokenSequence tokens;
+
+  // Filtered view of 'tokens' that is suitable for splicing into another
+  // token stream.  `include directives are *not* expanded here, because
+  // their resolution depends on the including context.
+  verible::TokenStreamView token_stream;
+
+  // Macros defined locally in this file (excluding nested includes).
+  VerilogPreprocessData::MacroDefinitionRegistry macro_definitions;
+};
+
+class VerilogIncludeFileCache {
+ public:
+  VerilogIncludeFileCache() = default;
+
+  VerilogIncludeFileCache(const VerilogIncludeFileCache&) = delete;
+  VerilogIncludeFileCache& operator=(const VerilogIncludeFileCache&) = delete;
+
+  // Returns the process-wide cache instance.
+  static VerilogIncludeFileCache& Global();
+
+  // Returns the file at 'path', reading and lexing it on first request.
+  // Concurrent first requests for the same path wait for a single load.
+  // The returned reference is never invalidated.
+  // Failures (including missing files) are cached, and reported through
+  // the returned file's status.
+  const VerilogIncludedFile& Get(absl::string_view path)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of (attempted) loaded files.
+  size_t Size() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  struct Entry {
+    absl::once_flag loaded;
+    VerilogIncludedFile file;
+  };
+
+  // Reads, lexes, and preprocesses the file at file->path.
+  static void Load(VerilogIncludedFile* file);
+
+  // Guards the map structure only; each entry is loaded outside of this lock.
+  mutable absl::Mutex mutex_;
+
+  // Keyed by path.  Entries are heap-allocated so that their addresses are
+  // stable across rehashing.
+  absl::node_hash_map<std::string, std::unique_ptr<Entry>> entries_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace verilog
+
+#endif  // VERIBLE_VERILOG_PREPROCESSOR_VERILOG_INCLUDE_FILE_CACHE_H_
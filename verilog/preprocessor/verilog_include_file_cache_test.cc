@@ -0,0 +1,92 @@
+// Copyright 2017-2020 The Verible Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "verilog/preprocessor/verilog_include_file_cache.h"
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "common/util/file_util.h"
+
+namespace verilog {
+namespace {
+
+using verible::file::testing::ScopedTestFile;
+
+TEST(VerilogIncludeFileCacheTest, MissingFile) {
+  VerilogIncludeFileCache cache;
+  const auto& file = cache.Get("/does/not/exist.svh");
+  EXPECT_EQ(file.status.code(), absl::StatusCode::kNotFound);
+  EXPECT_TRUE(file.token_stream.empty());
+  EXPECT_EQ(cache.Size(), 1);
+}
+
+TEST(VerilogIncludeFileCacheTest, LexesOnce) {
+  const ScopedTestFile header(testing::TempDir(),
+                              "`define WIDTH 8\n"
+                              "// comment\n"
+                              "wire [`WIDTH-1:0] w;\n");
+  VerilogIncludeFileCache cache;
+  const auto& file = cache.Get(header.filename());
+  ASSERT_TRUE(file.status.ok()) << file.status.message();
+  EXPECT_EQ(file.path, header.filename());
+  // Whitespace and comments are filtered out, EOF is retained.
+  ASSERT_FALSE(file.token_stream.empty());
+  EXPECT_TRUE(file.token_stream.back()->isEOF());
+  for (const auto& token : file.token_stream) {
+    EXPECT_NE(token->text, "// comment");
+  }
+  EXPECT_EQ(file.macro_definitions.size(), 1);
+  EXPECT_EQ(file.macro_definitions.count("WIDTH"), 1);
+
+  // Requesting the same path again yields the same object.
+  const auto& file2 = cache.Get(header.filename());
+  EXPECT_EQ(&file, &file2);
+  EXPECT_EQ(cache.Size(), 1);
+}
+
+TEST(VerilogIncludeFileCacheTest, PreprocessingError) {
+  const ScopedTestFile header(testing::TempDir(), "`define 123\n");
+  VerilogIncludeFileCache cache;
+  const auto& file = cache.Get(header.filename());
+  EXPECT_FALSE(file.status.ok());
+  EXPECT_NE(file.status.code(), absl::StatusCode::kNotFound);
+}
+
+TEST(VerilogIncludeFileCacheTest, ConcurrentRequests) {
+  const ScopedTestFile header(testing::TempDir(), "`define FOO(a) a+1\n");
+  VerilogIncludeFileCache cache;
+  constexpr int kNumThreads = 8;
+  std::vector<const VerilogIncludedFile*> results(kNumThreads, nullptr);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back(
+        [&, i]() { results[i] = &cache.Get(header.filename()); });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const auto* result : results) {
+    EXPECT_EQ(result, results.front());
+  }
+  EXPECT_TRUE(results.front()->status.ok());
+  EXPECT_EQ(results.front()->macro_definitions.count("FOO"), 1);
+  EXPECT_EQ(cache.Size(), 1);
+}
+
+}  // namespace
+}  // namespace verilog
@@ -14,14 +14,17 @@
 
 #include "verilog/preprocessor/verilog_preprocess.h"
 
+#include <algorithm>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "common/lexer/token_generator.h"
@@ -30,23 +33,32 @@
 #include "common/text/token_info.h"
 #include "common/text/token_stream_view.h"
 #include "common/util/container_util.h"
+#include "common/util/file_util.h"
+#include "common/util/iterator_range.h"
 #include "common/util/logging.h"
+#include "common/util/value_saver.h"
 #include "verilog/parser/verilog_parser.h"  // for verilog_symbol_name()
 #include "verilog/parser/verilog_token_enum.h"
+#include "verilog/preprocessor/verilog_include_file_cache.h"
 
 namespace verilog {
 
 using verible::TokenGenerator;
 using verible::TokenInfo;
+using verible::TokenSequence;
 using verible::TokenStreamView;
-using verible::container::InsertOrUpdate;
+using verible::TokenViewRange;
+using verible::ValueSaver;
+using verible::container::FindOrNull;
 
-// Copies `define token iterators into a temporary buffer.
+// Advances through the `define tokens, which are contiguous in the stream.
 // Assumes that the last token of a definition is the un-lexed definition body.
-// Tokens are copied from the 'generator' into 'define_tokens'.
+// Tokens are pulled from the 'generator', and 'define_end' is advanced to
+// point one-past the last consumed token.
 std::unique_ptr<VerilogPreprocessError>
 VerilogPreprocess::ConsumeMacroDefinition(
-    const StreamIteratorGenerator& generator, TokenStreamView* define_tokens) {
+    const StreamIteratorGenerator& generator,
+    TokenStreamView::const_iterator* define_end) {
   // Next token to expect is macro definition name.
   TokenStreamView::const_iterator token_iter = generator();
   if ((*token_iter)->isEOF()) {
@@ -60,7 +72,7 @@ VerilogPreprocess::ConsumeMacroDefinition(
         absl::StrCat("Expected identifier for macro name, but got \"",
                      macro_name->text, "...\""));
   }
-  define_tokens->push_back(*token_iter);
+  *define_end = token_iter + 1;
 
   // Everything else covers macro parameters and the definition body.
   do {
@@ -68,10 +80,10 @@ VerilogPreprocess::ConsumeMacroDefinition(
     if ((*token_iter)->isEOF()) {
       // Diagnose unexpected EOF downstream instead of erroring here.
       // Other subroutines can give better context about the parsing state.
-      define_tokens->push_back(*token_iter);
+      *define_end = token_iter + 1;
       return nullptr;
     }
-    define_tokens->push_back(*token_iter);
+    *define_end = token_iter + 1;
   } while ((*token_iter)->token_enum != PP_define_body);
   return nullptr;
 }
@@ -140,7 +152,7 @@ std::unique_ptr<VerilogPreprocessError> VerilogPreprocess::ParseMacroParameter(
 // The span of tokens that covers a macro definition is expected to
 // be in define_tokens.
 std::unique_ptr<VerilogPreprocessError> VerilogPreprocess::ParseMacroDefinition(
-    const TokenStreamView& define_tokens, MacroDefinition* macro_definition) {
+    const TokenViewRange& define_tokens, MacroDefinition* macro_definition) {
   auto token_scan = define_tokens.begin() + 2;  // skip `define and the name
   auto token_iter = *token_scan;
   if (token_iter->token_enum == '(') {
@@ -184,23 +196,73 @@ absl::Status VerilogPreprocess::HandleTokenIterator(
   // (parser).
   switch ((*iter)->token_enum) {
     case PP_define:
+      if (definitions_preloaded_) break;
       return HandleDefine(iter, generator);
+    case PP_include:
+      if (config_.expand_includes) return HandleInclude(iter, generator);
+      break;
+    case MacroIdentifier:
+    case MacroIdItem:
+    case MacroNumericWidth:
+      if (config_.expand_macros) return HandleMacroIdentifier(iter);
+      break;
+    case MacroCallId:
+      if (config_.expand_macros) return HandleMacroCall(iter, generator);
+      break;
     default:
-      // All other tokens are passed through unmodified.
-      preprocess_data_.preprocessed_token_stream.push_back(*iter);
-      return absl::OkStatus();
+      break;
   }
+  // All other tokens are passed through unmodified.
+  EmitTokens(verible::make_range(iter, iter + 1));
+  return absl::OkStatus();
+}
+
+void VerilogPreprocess::EmitTokens(const TokenViewRange& tokens) {
+  if (Expands()) {
+    for (const auto& token : tokens) {
+      // A nested stream's EOF can be pulled by a directive or macro call that
+      // is forwarded unexpanded, but it does not end the scanned stream.
+      if (!expansion_stack_.empty() && token->isEOF()) continue;
+      expanded_stream_.push_back(token);
+    }
+    return;
+  }
+  // Source and destination may overlap, but the destination never starts
+  // after the source, so a forward copy is safe.
+  for (const auto& token : tokens) {
+    *preprocessed_end_ = token;
+    ++preprocessed_end_;
+  }
+}
+
+void VerilogPreprocess::AddError(const TokenInfo& token,
+                                 const std::string& message) {
+  if (expansion_origin_ == nullptr) {
+    preprocess_data_.errors.emplace_back(token, message);
+    return;
+  }
+  preprocess_data_.errors.emplace_back(
+      *expansion_origin_,
+      absl::StrCat(message, " (at \"", token.text, "\", in expansion of ",
+                   expansion_origin_->text, ")"));
+}
+
+bool VerilogPreprocess::IsBeingExpanded(absl::string_view name) const {
+  return std::find(expansion_stack_.begin(), expansion_stack_.end(), name) !=
+         expansion_stack_.end();
 }
 
 // Stores a macro definition for later use.
-void VerilogPreprocess::RegisterMacroDefinition(
-    const MacroDefinition& definition) {
+void VerilogPreprocess::RegisterMacroDefinition(MacroDefinition&& definition) {
   // For now, unconditionally register the macro definition, keeping the last
   // definition if macro is re-defined.
-  const bool inserted = InsertOrUpdate(&preprocess_data_.macro_definitions,
-                                       definition.Name(), definition);
+  const absl::string_view name = definition.Name();
+  const bool inserted =
+      preprocess_data_.macro_definitions
+          .insert_or_assign(name, std::move(definition))
+          .second;
   if (!inserted) {
-    LOG(INFO) << "Re-defining macro " << definition.Name();
+    LOG(INFO) << "Re-defining macro " << name;
   }
   // TODO(fangism): diagnose re-definitions
 }
@@ -210,47 +272,290 @@ void VerilogPreprocess::RegisterMacroDefinition(
 absl::Status VerilogPreprocess::HandleDefine(
     const TokenStreamView::const_iterator iter,  // points to `define token
     const StreamIteratorGenerator& generator) {
-  TokenStreamView define_tokens;
-  define_tokens.push_back(*iter);
-  const auto consume_error_ptr =
-      ConsumeMacroDefinition(generator, &define_tokens);
+  TokenStreamView::const_iterator define_end = iter + 1;
+  const auto consume_error_ptr = ConsumeMacroDefinition(generator, &define_end);
   if (consume_error_ptr) {
-    preprocess_data_.errors.push_back(*consume_error_ptr);
+    AddError(consume_error_ptr->token_info, consume_error_ptr->error_message);
     return absl::InvalidArgumentError("Error parsing macro definition.");
   }
-  CHECK_GE(define_tokens.size(), 3)
+  const TokenViewRange define_tokens(iter, define_end);
+  CHECK_GE(std::distance(define_tokens.begin(), define_tokens.end()), 3)
       << "Macro definition should span at least 3 tokens, but only got "
-      << define_tokens.size();
-  const verible::TokenSequence::const_iterator macro_name = define_tokens[1];
-  verible::MacroDefinition macro_definition(*define_tokens[0], *macro_name);
+      << std::distance(define_tokens.begin(), define_tokens.end());
+  const verible::TokenSequence::const_iterator macro_name = *(iter + 1);
+  verible::MacroDefinition macro_definition(**iter, *macro_name);
   const auto parse_error_ptr =
       ParseMacroDefinition(define_tokens, &macro_definition);
   if (parse_error_ptr) {
-    preprocess_data_.errors.push_back(*parse_error_ptr);
+    AddError(parse_error_ptr->token_info, parse_error_ptr->error_message);
     return absl::InvalidArgumentError("Error parsing macro definition.");
   }
   // For now, forward all definition tokens.
-  RegisterMacroDefinition(macro_definition);
-  for (const auto& token : define_tokens) {
-    preprocess_data_.preprocessed_token_stream.push_back(token);
-  }
+  RegisterMacroDefinition(std::move(macro_definition));
+  EmitTokens(define_tokens);
   return absl::OkStatus();
 }
 
-VerilogPreprocessData VerilogPreprocess::ScanStream(
+// Returns 'filename' relative to the directory of 'including_file'.
+// Absolute names, and names in files of unknown location, are returned as is.
+static std::string PathRelativeToFile(absl::string_view including_file,
+                                      absl::string_view filename) {
+  const absl::string_view directory = verible::file::Dirname(including_file);
+  if (directory.empty() || absl::StartsWith(filename, "/")) {
+    return std::string(filename);
+  }
+  return verible::file::JoinPath(directory, filename);
+}
+
+// Responds to `include directives.  The named file is looked up in the
+// directory of the including file, then in the include search paths, and its
+// (cached) contents are preprocessed in place of the directive.
+absl::Status VerilogPreprocess::HandleInclude(
+    const TokenStreamView::const_iterator iter,  // points to `include token
+    const StreamIteratorGenerator& generator) {
+  const TokenStreamView::const_iterator file_iter = generator();
+  const TokenInfo& file_token = **file_iter;
+  if (file_token.token_enum != TK_StringLiteral) {
+    // Only literal file names are resolved.  Forward everything else,
+    // and let the parser diagnose any errors.
+    EmitTokens(verible::make_range(iter, file_iter + 1));
+    return absl::OkStatus();
+  }
+  // Strip the quotes.
+  const absl::string_view filename =
+      file_token.text.substr(1, file_token.text.length() - 2);
+
+  // Search the directory of the including file first, then the include paths
+  // in order.
+  VerilogIncludeFileCache& cache = VerilogIncludeFileCache::Global();
+  const VerilogIncludedFile* included =
+      &cache.Get(PathRelativeToFile(current_file_, filename));
+  for (const auto& include_path : config_.include_paths) {
+    if (included->status.code() != absl::StatusCode::kNotFound) break;
+    included = &cache.Get(verible::file::JoinPath(include_path, filename));
+  }
+  if (included->status.code() == absl::StatusCode::kNotFound) {
+    AddError(file_token,
+             absl::StrCat("Unable to find `include file: ", filename));
+    return absl::InvalidArgumentError("Error resolving `include.");
+  }
+  if (!included->status.ok()) {
+    AddError(file_token, std::string(included->status.message()));
+    return absl::InvalidArgumentError("Error in `included file.");
+  }
+  if (IsBeingExpanded(included->path)) {
+    AddError(file_token,
+             absl::StrCat("Recursive `include of file: ", included->path));
+    return absl::InvalidArgumentError("Recursive `include.");
+  }
+  preprocess_data_.included_files.push_back(included->path);
+
+  // Definitions from the included file become visible to the rest of the
+  // including file.  These were already parsed when the file was cached, so
+  // its `define directives need not be interpreted again.
+  // Note: all of the file's definitions are registered before its contents
+  // are scanned.
+  for (const auto& definition : included->macro_definitions) {
+    preprocess_data_.macro_definitions.insert_or_assign(definition.first,
+                                                        definition.second);
+  }
+  const ValueSaver<const TokenInfo*> origin_saver(
+      &expansion_origin_,
+      expansion_origin_ != nullptr ? expansion_origin_ : &**iter);
+  const ValueSaver<bool> preloaded_saver(&definitions_preloaded_, true);
+  const ValueSaver<absl::string_view> file_saver(&current_file_,
+                                                 included->path);
+  expansion_stack_.push_back(included->path);
+  const auto status = ScanNestedStream(included->token_stream);
+  expansion_stack_.pop_back();
+  return status;
+}
+
+// Responds to references of macros that take no arguments.
+absl::Status VerilogPreprocess::HandleMacroIdentifier(
+    const TokenStreamView::const_iterator iter) {
+  const TokenInfo& macro_token = **iter;
+  const absl::string_view name = macro_token.text.substr(1);  // strip '`'
+  const MacroDefinition* definition =
+      FindOrNull(preprocess_data_.macro_definitions, name);
+  if (definition == nullptr || definition->IsCallable()) {
+    // Unknown macros are left unexpanded.
+    EmitTokens(verible::make_range(iter, iter + 1));
+    return absl::OkStatus();
+  }
+  // Copy the definition, because expansion may (re-)define macros.
+  const MacroDefinition definition_copy(*definition);
+  return ExpandMacro(macro_token, definition_copy, {});
+}
+
+// Responds to macro calls with arguments.  The unlexed arguments are
+// collected up to the closing parenthesis.
+absl::Status VerilogPreprocess::HandleMacroCall(
+    const TokenStreamView::const_iterator iter,  // points to MacroCallId
+    const StreamIteratorGenerator& generator) {
+  const TokenInfo& macro_token = **iter;
+  std::vector<TokenInfo> args;
+  TokenInfo current_arg(MacroArg, absl::string_view());
+  TokenStreamView::const_iterator token_iter = generator();  // '('
+  if ((*token_iter)->token_enum != '(') {
+    EmitTokens(verible::make_range(iter, token_iter + 1));
+    return absl::OkStatus();
+  }
+  bool closed = false;
+  while (!closed) {
+    token_iter = generator();
+    const TokenInfo& token = **token_iter;
+    if (token.isEOF()) {
+      // Let the parser diagnose the unterminated macro call.
+      EmitTokens(verible::make_range(iter, token_iter + 1));
+      return absl::OkStatus();
+    }
+    switch (token.token_enum) {
+      case MacroArg:
+        current_arg = token;
+        break;
+      case ',':
+        args.push_back(current_arg);
+        current_arg = TokenInfo(MacroArg, absl::string_view());
+        break;
+      case ')':
+      case MacroCallCloseToEndLine:
+        args.push_back(current_arg);
+        closed = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  const absl::string_view name = macro_token.text.substr(1);  // strip '`'
+  const MacroDefinition* definition =
+      FindOrNull(preprocess_data_.macro_definitions, name);
+  if (definition == nullptr) {
+    // Unknown macros are left unexpanded.
+    EmitTokens(verible::make_range(iter, token_iter + 1));
+    return absl::OkStatus();
+  }
+  if (definition->Parameters().empty() && args.size() == 1 &&
+      args.front().text.empty()) {
+    args.clear();  // A call with empty () passes no arguments.
+  }
+  // Copy the definition, because expansion may (re-)define macros.
+  const MacroDefinition definition_copy(*definition);
+  return ExpandMacro(macro_token, definition_copy, args);
+}
+
+absl::Status VerilogPreprocess::ExpandMacro(
+    const TokenInfo& macro_token, const MacroDefinition& definition,
+    const std::vector<TokenInfo>& args) {
+  if (IsBeingExpanded(definition.Name())) {
+    AddError(macro_token,
+             absl::StrCat("Recursive expansion of macro ", definition.Name()));
+    return absl::InvalidArgumentError("Recursive macro expansion.");
+  }
+  MacroDefinition::substitution_map_type substitutions;
+  if (definition.IsCallable()) {
+    const auto status =
+        definition.PopulateSubstitutionMap(args, &substitutions);
+    if (!status.ok()) {
+      AddError(macro_token, std::string(status.message()));
+      return status;
+    }
+  }
+
+  // Lex the definition body, and the actual arguments that it references.
+  // All lexed text is backed by source text that outlives the analysis, so
+  // only the resulting tokens need to be saved.
+  TokenSequence body_tokens;
+  TokenStreamView body_view;
+  if (!LexForPreprocessing(definition.DefinitionText().text, &body_tokens,
+                           &body_view)
+           .ok()) {
+    AddError(macro_token, absl::StrCat("Lexical error in body of macro ",
+                                       definition.Name()));
+    return absl::InvalidArgumentError("Error expanding macro.");
+  }
+  auto expansion = absl::make_unique<TokenSequence>();
+  expansion->reserve(body_view.size());
+  for (const auto& body_token : body_view) {
+    if (body_token->isEOF()) break;
+    const TokenInfo& replacement = MacroDefinition::SubstituteText(
+        substitutions, *body_token, SymbolIdentifier);
+    if (&replacement == &*body_token) {
+      expansion->push_back(*body_token);
+      continue;
+    }
+    TokenSequence arg_tokens;
+    TokenStreamView arg_view;
+    if (!LexForPreprocessing(replacement.text, &arg_tokens, &arg_view).ok()) {
+      AddError(replacement, absl::StrCat("Lexical error in argument of macro ",
+                                         definition.Name()));
+      return absl::InvalidArgumentError("Error expanding macro.");
+    }
+    for (const auto& arg_token : arg_view) {
+      if (arg_token->isEOF()) break;
+      expansion->push_back(*arg_token);
+    }
+  }
+  // Nested stream scanning relies on a terminating EOF.
+  expansion->push_back(TokenInfo::EOFToken());
+  TokenStreamView expansion_view;
+  verible::InitTokenStreamView(*expansion, &expansion_view);
+  preprocess_data_.expanded_tokens.push_back(std::move(expansion));
+
+  // Expand any macro calls or directives in the expanded text.
+  const ValueSaver<const TokenInfo*> origin_saver(
+      &expansion_origin_,
+      expansion_origin_ != nullptr ? expansion_origin_ : &macro_token);
+  const ValueSaver<bool> preloaded_saver(&definitions_preloaded_, false);
+  expansion_stack_.push_back(definition.Name());
+  const auto status = ScanNestedStream(expansion_view);
+  expansion_stack_.pop_back();
+  return status;
+}
+
+absl::Status VerilogPreprocess::ScanNestedStream(
     const TokenStreamView& token_stream) {
-  preprocess_data_.preprocessed_token_stream.reserve(token_stream.size());
   auto iter_generator = verible::MakeConstIteratorStreamer(token_stream);
   const auto end = token_stream.end();
-  auto iter = iter_generator();
-  // Token-pulling loop.
-  while (iter != end) {
+  for (auto iter = iter_generator(); iter != end; iter = iter_generator()) {
+    if ((*iter)->isEOF()) break;
     const auto status = HandleTokenIterator(iter, iter_generator);
+    if (!status.ok()) return status;
+  }
+  return absl::OkStatus();
+}
+
+VerilogPreprocessData VerilogPreprocess::ScanStream(
+    TokenStreamView* token_stream) {
+  return ScanStream(token_stream,
+                    verible::MakeConstIteratorStreamer(*token_stream));
+}
+
+VerilogPreprocessData VerilogPreprocess::ScanStream(
+    TokenStreamView* token_stream, const StreamIteratorGenerator& generator) {
+  preprocessed_end_ = token_stream->begin();
+  if (Expands()) expanded_stream_.reserve(token_stream->size());
+  auto iter = generator();
+  // Token-pulling loop.
+  // The end is re-evaluated because 'generator' may be growing the stream.
+  while (iter != token_stream->end()) {
+    const auto status = HandleTokenIterator(iter, generator);
     if (!status.ok()) {
       // Detailed errors are already in preprocessor_data_.errors.
+      // Retain the remaining unprocessed tokens, including the failing
+      // directive.
+      while (generator() != token_stream->end()) {
+      }
+      EmitTokens(verible::make_range(iter, token_stream->cend()));
       break;  // For now, stop after first error.
     }
-    iter = iter_generator();
+    iter = generator();
+  }
+  if (Expands()) {
+    token_stream->swap(expanded_stream_);
+  } else {
+    token_stream->erase(preprocessed_end_, token_stream->end());
   }
   return std::move(preprocess_data_);
 }
@@ -13,19 +13,21 @@
 // limitations under the License.
 
 // VerilogPreprocess is a *pseudo*-preprocessor for Verilog.
-// Unlike a conventional preprocessor, this pseudo-preprocessor does not open
-// included files, nor does it evaluate preprocessor expressions.
+// Unlike a conventional preprocessor, this pseudo-preprocessor does not
+// evaluate preprocessor expressions, and by default, does not open included
+// files.
 // Instead, it does a best-effort handling of preprocessor directives
 // locally within one file, and no additional context.
 // For example, it may expand a macro call if its definition happens to be
 // available, but it is not required to do so.
 // The pseudo-preprocessor is free to evaluate any/all/no conditional
 // branches.
-// Each analysis tool may configure the pseudo-preprocessor differently.
+// Each analysis tool may configure the pseudo-preprocessor differently,
+// see VerilogPreprocessConfig.
 
-// TODO(fangism): expand macros if locally defined, and feed un-lexed
-//   body text to lexer.  This approach works if the definition text
-//   does not depend on the start-condition state at the macro call site.
+// Macro expansion (when enabled) feeds un-lexed body text to the lexer.
+//   This approach works if the definition text does not depend on the
+//   start-condition state at the macro call site.
 // TODO(fangism): implement conditional evaluation policy (`ifdef, `else, ...)
 // TODO(fangism): token concatenation, e.g. a``b
 //   This will produce tokens that are not in the original source text.
@@ -36,11 +38,11 @@
 #define VERIBLE_VERILOG_PREPROCESSOR_VERILOG_PREPROCESS_H_
 
 #include <functional>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "common/text/macro_definition.h"
@@ -49,7 +51,28 @@
 
 namespace verilog {
 
-// TODO(fangism): configuration policy enums.
+// Configuration of the optional expanding behaviors of VerilogPreprocess.
+// The default configuration expands nothing, which keeps every token of the
+// preprocessed stream within the original source text.
+// When anything is expanded, the resulting token stream may contain tokens
+// whose text lies outside of the original source text (e.g. in `included
+// files), so consumers that relate tokens to byte offsets of the original
+// text should not enable expansion.
+struct VerilogPreprocessConfig {
+  // If true, replace `include directives with the contents of the named file.
+  // Included files are read and lexed through the process-wide
+  // VerilogIncludeFileCache.
+  bool expand_includes = false;
+
+  // Directories in which to search for `included files, in order, after
+  // trying the directory of the including file.  Absolute names are used as
+  // given.
+  std::vector<std::string> include_paths;
+
+  // If true, replace macro calls and references whose definitions are known
+  // with their (lexed) definition bodies.
+  bool expand_macros = false;
+};
 
 // VerilogPreprocessError contains preprocessor error information.
 struct VerilogPreprocessError {
@@ -64,60 +87,159 @@ struct VerilogPreprocessError {
 // Information that results from preprocessing.
 struct VerilogPreprocessData {
   using MacroDefinition = verible::MacroDefinition;
-  using MacroDefinitionRegistry = std::map<absl::string_view, MacroDefinition>;
-
-  // Resulting token stream after preprocessing
-  verible::TokenStreamView preprocessed_token_stream;
+  // Keys are the macro names, which point into the original source text.
+  using MacroDefinitionRegistry =
+      absl::flat_hash_map<absl::string_view, MacroDefinition>;
 
-  // Map of defined macros.
+  // Map of defined macros (unordered).
   MacroDefinitionRegistry macro_definitions;
 
   // Sequence of tokens rejected by preprocessing.
   std::vector<VerilogPreprocessError> errors;
+
+  // Backing storage for tokens produced by macro expansion, which are
+  // referenced by the preprocessed token stream.
+  std::vector<std::unique_ptr<verible::TokenSequence>> expanded_tokens;
+
+  // Paths of all files that were `included (in order of expansion).
+  // These point to strings owned by the VerilogIncludeFileCache.
+  std::vector<absl::string_view> included_files;
 };
 
-// VerilogPreprocess transforms a TokenStreamView.
+// VerilogPreprocess transforms a TokenStreamView in-place.
 // The input stream view is expected to have been stripped of whitespace.
 class VerilogPreprocess {
   using TokenStreamView = verible::TokenStreamView;
+  using TokenViewRange = verible::TokenViewRange;
   using MacroDefinition = verible::MacroDefinition;
   using MacroParameterInfo = verible::MacroParameterInfo;
 
  public:
-  VerilogPreprocess() : preprocess_data_() {}
+  // Yields the next input token, or the end of the stream being scanned when
+  // there are no more tokens.
+  using StreamIteratorGenerator =
+      std::function<TokenStreamView::const_iterator()>;
+
+  VerilogPreprocess() : config_(), preprocess_data_() {}
 
-  // ScanStream reads in a stream of tokens returns the result as a move
-  // of preprocessor_data_.  preprocessor_data_ should not be accessed
+  explicit VerilogPreprocess(const VerilogPreprocessConfig& config)
+      : config_(config), preprocess_data_() {}
+
+  // 'filename' is the path of the file being preprocessed, against whose
+  // directory relative `include names are resolved first.
+  VerilogPreprocess(const VerilogPreprocessConfig& config,
+                    absl::string_view filename)
+      : config_(config), preprocess_data_(), current_file_(filename) {}
+
+  // ScanStream filters a stream of tokens in-place, and returns the result as
+  // a move of preprocessor_data_.  preprocessor_data_ should not be accessed
   // after this returns.
-  VerilogPreprocessData ScanStream(const TokenStreamView& token_stream);
+  // Retained tokens are compacted towards the front of 'token_stream', which
+  // is then truncated, so no copy of the stream is ever made.
+  // If preprocessing fails, the tokens starting from the failing directive
+  // are retained unprocessed.
+  // When the configuration enables expansion, the stream may grow, so the
+  // result is built separately and swapped into 'token_stream'.
+  VerilogPreprocessData ScanStream(TokenStreamView* token_stream);
+
+  // Streaming variant of ScanStream, for chaining after other token stages.
+  // Instead of iterating over a complete 'token_stream', tokens are pulled
+  // from 'generator', which appends each next input token to 'token_stream'
+  // and returns an iterator to it, or token_stream->end() once there are no
+  // more tokens.  'token_stream' must have enough capacity reserved for all
+  // input tokens, so that it is never reallocated while being scanned.
+  // Like ScanStream, the preprocessed tokens are written back to
+  // 'token_stream'.
+  VerilogPreprocessData ScanStream(TokenStreamView* token_stream,
+                                   const StreamIteratorGenerator& generator);
 
-  // TODO(fangism): ExpandMacro, ExpandMacroCall
   // TODO(b/111544845): ExpandEvalStringLiteral
 
  private:
-  using StreamIteratorGenerator =
-      std::function<TokenStreamView::const_iterator()>;
-
   absl::Status HandleTokenIterator(const TokenStreamView::const_iterator,
                                    const StreamIteratorGenerator&);
 
   absl::Status HandleDefine(const TokenStreamView::const_iterator,
                             const StreamIteratorGenerator&);
 
+  absl::Status HandleInclude(const TokenStreamView::const_iterator,
+                             const StreamIteratorGenerator&);
+
+  absl::Status HandleMacroIdentifier(const TokenStreamView::const_iterator);
+
+  absl::Status HandleMacroCall(const TokenStreamView::const_iterator,
+                               const StreamIteratorGenerator&);
+
+  // Lexes the body of 'definition' with 'args' substituted for its formal
+  // parameters, and preprocesses the result into the output stream.
+  absl::Status ExpandMacro(const verible::TokenInfo& macro_token,
+                           const MacroDefinition& definition,
+                           const std::vector<verible::TokenInfo>& args);
+
+  // Preprocesses a stream of tokens that does not belong to the stream being
+  // scanned (included file contents, macro expansions), appending the
+  // results to the output stream.  EOF tokens are not forwarded.
+  absl::Status ScanNestedStream(const TokenStreamView& token_stream);
+
+  // Returns true if expanding 'name' (macro or file) would recurse.
+  bool IsBeingExpanded(absl::string_view name) const;
+
+  // Records an error.  Errors that occur inside expanded text are attributed
+  // to the outermost directive or macro call that started the expansion,
+  // because only its location is meaningful to the caller.
+  void AddError(const verible::TokenInfo& token, const std::string& message);
+
   // The following functions return nullptr when there is no error:
   static std::unique_ptr<VerilogPreprocessError> ConsumeMacroDefinition(
-      const StreamIteratorGenerator&, TokenStreamView*);
+      const StreamIteratorGenerator&, TokenStreamView::const_iterator*);
 
   static std::unique_ptr<VerilogPreprocessError> ParseMacroDefinition(
-      const TokenStreamView&, MacroDefinition*);
+      const TokenViewRange&, MacroDefinition*);
 
   static std::unique_ptr<VerilogPreprocessError> ParseMacroParameter(
       TokenStreamView::const_iterator*, MacroParameterInfo*);
 
-  void RegisterMacroDefinition(const MacroDefinition&);
+  void RegisterMacroDefinition(MacroDefinition&&);
+
+  // Forwards a range of tokens to the next consumer (parser), by writing them
+  // to the retained portion of the stream being scanned, or by appending
+  // them to expanded_stream_ when expanding.
+  // EOF tokens of nested streams are dropped.
+  void EmitTokens(const TokenViewRange&);
+
+  // True if this configuration can insert tokens into the stream.
+  bool Expands() const {
+    return config_.expand_includes || config_.expand_macros;
+  }
+
+  // Configuration of expanding behaviors.
+  const VerilogPreprocessConfig config_;
 
   // Results of preprocessing
   VerilogPreprocessData preprocess_data_;
+
+  // While true, `define directives are forwarded without being registered,
+  // because their definitions were already taken from the include file cache.
+  bool definitions_preloaded_ = false;
+
+  // End of the retained (already preprocessed) portion of the stream being
+  // scanned.  This never advances past the current read position.
+  // Only used when not expanding.
+  TokenStreamView::iterator preprocessed_end_;
+
+  // Output stream, only used when expanding.
+  TokenStreamView expanded_stream_;
+
+  // Path of the file whose tokens are currently being scanned, which is the
+  // innermost `included file, if any.  Empty if unknown.
+  absl::string_view current_file_;
+
+  // Names of the macros and files currently being expanded (innermost last).
+  std::vector<absl::string_view> expansion_stack_;
+
+  // The token in the scanned stream that started the current expansion.
+  // nullptr when not inside an expansion.
+  const verible::TokenInfo* expansion_origin_ = nullptr;
 };
 
 }  // namespace verilog
@@ -15,14 +15,18 @@
 #include "verilog/preprocessor/verilog_preprocess.h"
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "common/text/macro_definition.h"
 #include "common/text/token_info.h"
 #include "common/util/container_util.h"
+#include "common/util/file_util.h"
 #include "verilog/analysis/verilog_analyzer.h"
 
 namespace verilog {
@@ -30,12 +34,18 @@ namespace {
 
 using testing::ElementsAre;
 using testing::Pair;
+using testing::UnorderedElementsAre;
 using verible::container::FindOrNull;
+using verible::file::testing::ScopedTestFile;
 
 class PreprocessorTester {
  public:
-  explicit PreprocessorTester(const char* text)
-      : analyzer_(text, "<<inline-file>>"), status_() {
+  explicit PreprocessorTester(
+      const char* text,
+      const VerilogPreprocessConfig& config = VerilogPreprocessConfig(),
+      absl::string_view filename = "<<inline-file>>")
+      : analyzer_(text, filename), status_() {
+    analyzer_.SetPreprocessConfig(config);
     status_ = analyzer_.Analyze();
   }
 
@@ -206,8 +216,8 @@ TEST(VerilogPreprocessTest, TwoMacroDefinitions) {
   EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
   EXPECT_TRUE(tester.PreprocessorData().errors.empty());
   EXPECT_TRUE(tester.Analyzer().GetRejectedTokens().empty());
-  EXPECT_THAT(definitions, ElementsAre(Pair("BAAAAR", testing::_),
-                                       Pair("FOOOO", testing::_)));
+  EXPECT_THAT(definitions, UnorderedElementsAre(Pair("BAAAAR", testing::_),
+                                                Pair("FOOOO", testing::_)));
   {
     auto macro = FindOrNull(definitions, "BAAAAR");
     ASSERT_NE(macro, nullptr);
@@ -224,5 +234,185 @@ TEST(VerilogPreprocessTest, TwoMacroDefinitions) {
   }
 }
 
+// Verify that preprocessing leaves the analyzer's token stream view intact
+// (definitions are currently forwarded to the parser).
+TEST(VerilogPreprocessTest, RetainsForwardedTokensInPlace) {
+  PreprocessorTester tester(
+      "`define FOOOO(x) (x+1)\n"
+      "module foo;\nendmodule\n");
+  EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
+  const auto& token_view = tester.Analyzer().Data().GetTokenStreamView();
+  std::vector<absl::string_view> token_texts;
+  for (const auto& token : token_view) {
+    if (token->isEOF()) break;
+    token_texts.push_back(token->text);
+  }
+  EXPECT_THAT(token_texts,
+              ElementsAre("`define", "FOOOO", "(", "x", ")", "(x+1)", "module",
+                          "foo", ";", "endmodule"));
+}
+
+// Returns the texts of the preprocessed tokens, excluding EOF.
+std::vector<absl::string_view> PreprocessedTokenTexts(
+    const PreprocessorTester& tester) {
+  std::vector<absl::string_view> token_texts;
+  for (const auto& token : tester.Analyzer().Data().GetTokenStreamView()) {
+    if (token->isEOF()) break;
+    token_texts.push_back(token->text);
+  }
+  return token_texts;
+}
+
+TEST(VerilogPreprocessTest, ExpandsIncludeFromSearchPath) {
+  const ScopedTestFile header(testing::TempDir(),
+                              "`define WIDTH 8\n"
+                              "wire w;\n");
+  const std::string text = absl::StrCat(
+      "module foo;\n", "`include \"",
+      verible::file::Basename(header.filename()), "\"\n", "endmodule\n");
+  VerilogPreprocessConfig config;
+  config.expand_includes = true;
+  config.include_paths.push_back(testing::TempDir());
+  PreprocessorTester tester(text.c_str(), config);
+  EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
+  EXPECT_THAT(PreprocessedTokenTexts(tester),
+              ElementsAre("module", "foo", ";", "`define", "WIDTH", "8", "wire",
+                          "w", ";", "endmodule"));
+  const auto& definitions = tester.PreprocessorData().macro_definitions;
+  EXPECT_THAT(definitions, ElementsAre(Pair("WIDTH", testing::_)));
+  EXPECT_EQ(tester.PreprocessorData().included_files.size(), 1);
+}
+
+// Relative names are looked up in the directory of the including file,
+// regardless of the working directory.
+TEST(VerilogPreprocessTest, ExpandsIncludeRelativeToIncludingFile) {
+  const std::string dir =
+      verible::file::JoinPath(testing::TempDir(), "include_relative_test");
+  const std::string subdir = verible::file::JoinPath(dir, "sub");
+  ASSERT_TRUE(verible::file::CreateDir(dir).ok());
+  ASSERT_TRUE(verible::file::CreateDir(subdir).ok());
+  // outer.svh includes inner.svh from its own directory.
+  ASSERT_TRUE(verible::file::SetContents(
+                  verible::file::JoinPath(subdir, "outer.svh"),
+                  "wire outer;\n`include \"inner.svh\"\n")
+                  .ok());
+  ASSERT_TRUE(verible::file::SetContents(
+                  verible::file::JoinPath(subdir, "inner.svh"), "wire inner;\n")
+                  .ok());
+  // A file of the same name in the search path is not preferred.
+  ASSERT_TRUE(verible::file::SetContents(
+                  verible::file::JoinPath(dir, "inner.svh"), "wire wrong;\n")
+                  .ok());
+  VerilogPreprocessConfig config;
+  config.expand_includes = true;
+  config.include_paths.push_back(dir);
+  PreprocessorTester tester("`include \"sub/outer.svh\"\n", config,
+                            verible::file::JoinPath(dir, "top.sv"));
+  EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
+  EXPECT_THAT(PreprocessedTokenTexts(tester),
+              ElementsAre("wire", "outer", ";", "wire", "inner", ";"));
+}
+
+// An incomplete directive or macro call at the end of an included file is
+// forwarded without the included file's EOF, so the rest of the including
+// file is still preprocessed.
+TEST(VerilogPreprocessTest, IncompleteDirectiveAtEndOfIncludedFile) {
+  const ScopedTestFile ends_in_include(testing::TempDir(),
+                                       "wire a;\n`include");
+  const ScopedTestFile ends_in_macro_call(testing::TempDir(),
+                                          "wire c;\n`FOO(");
+  const std::string text = absl::StrCat(
+      "`include \"", verible::file::Basename(ends_in_include.filename()),
+      "\"\nwire b;\n`include \"",
+      verible::file::Basename(ends_in_macro_call.filename()),
+      "\"\nwire d;\n");
+  VerilogPreprocessConfig config;
+  config.expand_includes = true;
+  config.expand_macros = true;
+  config.include_paths.push_back(testing::TempDir());
+  // The incomplete directives are left for the parser to diagnose.
+  PreprocessorTester tester(text.c_str(), config);
+  EXPECT_THAT(PreprocessedTokenTexts(tester),
+              ElementsAre("wire", "a", ";", "`include", "wire", "b", ";",
+                          "wire", "c", ";", "`FOO", "(", "wire", "d", ";"));
+}
+
+TEST(VerilogPreprocessTest, MissingIncludeIsAnError) {
+  VerilogPreprocessConfig config;
+  config.expand_includes = true;
+  PreprocessorTester tester("`include \"no/such/file.svh\"\n", config);
+  EXPECT_FALSE(tester.Status().ok());
+  ASSERT_EQ(tester.PreprocessorData().errors.size(), 1);
+  EXPECT_EQ(tester.PreprocessorData().errors.front().token_info.text,
+            "\"no/such/file.svh\"");
+}
+
+TEST(VerilogPreprocessTest, IncludeNotExpandedByDefault) {
+  PreprocessorTester tester("`include \"no/such/file.svh\"\n");
+  EXPECT_TRUE(tester.Status().ok());
+  EXPECT_THAT(PreprocessedTokenTexts(tester),
+              ElementsAre("`include", "\"no/such/file.svh\""));
+}
+
+TEST(VerilogPreprocessTest, ExpandsMacroIdentifier) {
+  VerilogPreprocessConfig config;
+  config.expand_macros = true;
+  PreprocessorTester tester(
+      "`define WIDTH 8\n"
+      "module foo;\n"
+      "wire [`WIDTH-1:0] w;\n"
+      "endmodule\n",
+      config);
+  EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
+  EXPECT_THAT(PreprocessedTokenTexts(tester),
+              ElementsAre("`define", "WIDTH", "8", "module", "foo", ";", "wire",
+                          "[", "8", "-", "1", ":", "0", "]", "w", ";",
+                          "endmodule"));
+}
+
+TEST(VerilogPreprocessTest, ExpandsMacroCallWithArguments) {
+  VerilogPreprocessConfig config;
+  config.expand_macros = true;
+  PreprocessorTester tester(
+      "`define ADD(a, b=1) a + b\n"
+      "module foo;\n"
+      "assign x = `ADD(y, z);\n"
+      "assign p = `ADD(q, );\n"
+      "endmodule\n",
+      config);
+  EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
+  EXPECT_THAT(PreprocessedTokenTexts(tester),
+              ElementsAre("`define", "ADD", "(", "a", ",", "b", "=", "1", ")",
+                          "a + b",                                 //
+                          "module", "foo", ";",                    //
+                          "assign", "x", "=", "y", "+", "z", ";",  //
+                          "assign", "p", "=", "q", "+", "1", ";",  //
+                          "endmodule"));
+}
+
+TEST(VerilogPreprocessTest, UnknownMacrosAreNotExpanded) {
+  VerilogPreprocessConfig config;
+  config.expand_macros = true;
+  PreprocessorTester tester("module foo;\nassign x = `FOO(y);\nendmodule\n",
+                            config);
+  EXPECT_TRUE(tester.Status().ok()) << "Unexpected analyzer failure.";
+  EXPECT_THAT(PreprocessedTokenTexts(tester),
+              ElementsAre("module", "foo", ";", "assign", "x", "=", "`FOO", "(",
+                          "y", ")", ";", "endmodule"));
+}
+
+TEST(VerilogPreprocessTest, RecursiveMacroIsAnError) {
+  VerilogPreprocessConfig config;
+  config.expand_macros = true;
+  PreprocessorTester tester(
+      "`define FOO `FOO\n"
+      "module foo;\nwire `FOO;\nendmodule\n",
+      config);
+  EXPECT_FALSE(tester.Status().ok());
+  ASSERT_EQ(tester.PreprocessorData().errors.size(), 1);
+  // Error is attributed to the outermost macro reference.
+  EXPECT_EQ(tester.PreprocessorData().errors.front().token_info.text, "`FOO");
+}
+
 }  // namespace
 }  // namespace verilog
@@ -31,11 +31,14 @@
 
 #include "absl/flags/flag.h"
 #include "absl/flags/usage.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "common/formatting/formatted_excerpt_cache.h"
 #include "common/util/file_util.h"
 #include "common/util/init_command_line.h"
 #include "common/util/interval_set.h"
@@ -107,9 +110,27 @@ ABSL_FLAG(bool, show_inter_token_info, false,
 ABSL_FLAG(bool, show_equally_optimal_wrappings, false,
           "If true, print when multiple optimal solutions are found (stderr), "
           "but continue to operate normally.");
+ABSL_FLAG(bool, show_search_statistics, false,
+          "If true, print the effort spent searching line wraps of each "
+          "token partition, but continue to operate normally.");
 ABSL_FLAG(int, max_search_states, 100000,
           "Limits the number of search states explored during "
           "line wrap optimization.");
+ABSL_FLAG(int, beam_width, 0,
+          "If > 0, token partitions that exceed --max_search_states are "
+          "formatted by a beam search of this width, instead of failing.");
+ABSL_FLAG(absl::Duration, max_search_time, absl::InfiniteDuration(),
+          "Limits the time spent on line wrap optimization of each token "
+          "partition, e.g. 500ms.");
+ABSL_FLAG(int, threads_per_file, 1,
+          "Number of threads that annotate the top-level items of each file "
+          "concurrently, 0 for one per hardware thread.  This speeds up "
+          "formatting very large files.");
+ABSL_FLAG(std::string, excerpt_cache, "",
+          "If set, file that remembers the formatting of token partitions "
+          "between runs, so that re-formatting mostly unchanged files only "
+          "searches line wraps of changed partitions.  It is created if it "
+          "does not exist, and rewritten after formatting.");
 
 // These flags exist in the short term to disable formatting of some regions.
 ABSL_FLAG(bool, format_module_port_declarations, false,
@@ -127,7 +148,8 @@ std::ostream& FileMsg(absl::string_view filename) {
 }
 
 bool formatOneFile(absl::string_view filename,
-                   const verilog::formatter::LineNumberSet& lines_to_format) {
+                   const verilog::formatter::LineNumberSet& lines_to_format,
+                   verible::FormattedExcerptCache* excerpt_cache) {
   const bool inplace = absl::GetFlag(FLAGS_inplace);
   const bool is_stdin = filename == "-";
   const auto& stdin_name = absl::GetFlag(FLAGS_stdin_name);
@@ -167,8 +189,14 @@ bool formatOneFile(absl::string_view filename,
         absl::GetFlag(FLAGS_show_inter_token_info);
     formatter_control.show_equally_optimal_wrappings =
         absl::GetFlag(FLAGS_show_equally_optimal_wrappings);
+    formatter_control.show_search_statistics =
+        absl::GetFlag(FLAGS_show_search_statistics);
     formatter_control.max_search_states =
         absl::GetFlag(FLAGS_max_search_states);
+    formatter_control.beam_width = absl::GetFlag(FLAGS_beam_width);
+    formatter_control.max_search_time = absl::GetFlag(FLAGS_max_search_time);
+    formatter_control.num_threads = absl::GetFlag(FLAGS_threads_per_file);
+    formatter_control.excerpt_cache = excerpt_cache;
 
     // formatting style flags
     format_style.format_module_port_declarations =
@@ -177,12 +205,13 @@ bool formatOneFile(absl::string_view filename,
         absl::GetFlag(FLAGS_format_module_instantiations);
   }
 
-  std::ostringstream stream;
+  // Render directly into one string, to avoid holding more copies of the
+  // output than necessary for large files.
+  std::string formatted_output;
   const auto format_status =
-      FormatVerilog(content, diagnostic_filename, format_style, stream,
-                    lines_to_format, formatter_control);
+      FormatVerilog(content, diagnostic_filename, format_style,
+                    &formatted_output, lines_to_format, formatter_control);
 
-  const std::string& formatted_output(stream.str());
   if (!format_status.ok()) {
     if (!inplace) {
       // Fall back to printing original content regardless of error condition.
@@ -263,11 +292,39 @@ int main(int argc, char** argv) {
     }
   }
 
+  // Load previously formatted partitions, if requested.
+  const auto& excerpt_cache_file = absl::GetFlag(FLAGS_excerpt_cache);
+  std::unique_ptr<verible::FormattedExcerptCache> excerpt_cache;
+  if (!excerpt_cache_file.empty()) {
+    excerpt_cache = absl::make_unique<verible::FormattedExcerptCache>();
+    std::string cache_content;
+    // A missing or malformed cache is not an error, just start over.
+    if (verible::file::GetContents(excerpt_cache_file, &cache_content).ok()) {
+      const auto cache_status = excerpt_cache->Deserialize(cache_content);
+      if (!cache_status.ok()) {
+        FileMsg(excerpt_cache_file) << cache_status.message() << std::endl;
+      }
+    }
+  }
+
   bool all_success = true;
   // All positional arguments are file names.  Exclude program name.
   for (const absl::string_view filename :
        verible::make_range(file_args.begin() + 1, file_args.end())) {
-    all_success &= formatOneFile(filename, lines_to_format);
+    all_success &=
+        formatOneFile(filename, lines_to_format, excerpt_cache.get());
+  }
+
+  // Only keep the partitions of the files formatted by this run.
+  if (excerpt_cache != nullptr) {
+    excerpt_cache->PruneUnused();
+    std::ostringstream cache_stream;
+    excerpt_cache->Serialize(cache_stream);
+    const auto cache_status =
+        verible::file::SetContents(excerpt_cache_file, cache_stream.str());
+    if (!cache_status.ok()) {
+      FileMsg(excerpt_cache_file) << cache_status << std::endl;
+    }
   }
 
   return all_success ? 0 : 1;
@@ -28,10 +28,12 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "common/analysis/lint_diagnostic_sink.h"
 #include "common/util/init_command_line.h"
 #include "common/util/logging.h"  // for operator<<, LOG, LogMessage, etc
 #include "verilog/analysis/verilog_linter.h"
 #include "verilog/analysis/verilog_linter_configuration.h"
+#include "verilog/analysis/verilog_project_linter.h"
 
 // Reminder: The linter service expects the program to return 0 unless
 // there is a fatal error, regardless of parse/lint status.
@@ -44,6 +46,18 @@ ABSL_FLAG(bool, lint_fatal, false,
 ABSL_FLAG(std::string, help_rules, "",
           "[all|<rule-name>], print the description of one rule/all rules "
           "and exit immediately.");
+ABSL_FLAG(std::string, diagnostics_format, "text",
+          "[text|jsonl|sarif], output format of lint violations.  "
+          "With any format other than text, syntax errors are printed to "
+          "stderr instead of stdout.");
+ABSL_FLAG(bool, project_mode, false,
+          "If true, lint all files as one project: files are linted in "
+          "parallel, and then the project rules check them together for "
+          "duplicate module, interface, and package names, instances of "
+          "undefined modules, and unused packages.");
+ABSL_FLAG(int, project_threads, 0,
+          "Number of threads for --project_mode, 0 for one per hardware "
+          "thread.");
 ABSL_FLAG(
     bool, generate_markdown, false,
     "If true, print the description of every rule formatted for the "
@@ -70,6 +84,33 @@ int main(int argc, char** argv) {
     return 0;
   }
 
+  const std::string diagnostics_format =
+      absl::GetFlag(FLAGS_diagnostics_format);
+  const auto sink = verible::MakeLintDiagnosticSink(
+      diagnostics_format, &std::cout, "verible-verilog-lint");
+  if (sink == nullptr) {
+    std::cerr << "Unknown --diagnostics_format: " << diagnostics_format
+              << std::endl;
+    return 1;
+  }
+  std::ostream* syntax_error_stream =
+      diagnostics_format == "text" ? &std::cout : &std::cerr;
+
+  if (absl::GetFlag(FLAGS_project_mode)) {
+    const std::vector<std::string> filenames(args.begin() + 1, args.end());
+    std::vector<LinterConfiguration> configs;
+    configs.reserve(filenames.size());
+    for (const auto& filename : filenames) {
+      configs.push_back(verilog::LinterConfigurationFromFlags(filename));
+    }
+    const int exit_status = verilog::LintProject(
+        syntax_error_stream, sink.get(), filenames, configs,
+        absl::GetFlag(FLAGS_parse_fatal), absl::GetFlag(FLAGS_lint_fatal),
+        absl::GetFlag(FLAGS_project_threads));
+    sink->Finish();
+    return exit_status;
+  }
+
   int exit_status = 0;
   // All positional arguments are file names.  Exclude program name.
   for (const auto filename :
@@ -79,10 +120,11 @@ int main(int argc, char** argv) {
         verilog::LinterConfigurationFromFlags(filename));
 
     const int lint_status = verilog::LintOneFile(
-        &std::cout, filename, config, absl::GetFlag(FLAGS_parse_fatal),
-        absl::GetFlag(FLAGS_lint_fatal));
+        syntax_error_stream, sink.get(), filename, config,
+        absl::GetFlag(FLAGS_parse_fatal), absl::GetFlag(FLAGS_lint_fatal));
     exit_status = std::max(lint_status, exit_status);
   }  // for each file
+  sink->Finish();
 
   // Linter service must return 0 if it ran successfully, regardless of
   // findings.